@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <Bench.h>
+#include <Aligned.h>
+#include <Arena.h>
+#include <AlignedAllocator.h>
+#include <cstddef>
+#include <vector>
+
+using namespace Math;
+
+namespace {
+
+/*
+ * Per-frame instance buffer: world matrices are rebuilt from parents and locals
+ * into freshly allocated storage every iteration.
+ */
+template<typename Buffer, typename Allocate>
+void frame(benchmark::State& state, Allocate allocate) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Mat4> locals(Bench::randomArray<Mat4>(size, Bench::randomRigid));
+    Mat4 parent(Bench::randomRigid());
+
+    for (auto _: state) {
+        Buffer* world = allocate(size);
+
+        for (std::size_t i = 0; i < size; i++) {
+            world[i] = parent * locals[i];
+        }
+
+        benchmark::DoNotOptimize(world);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * sizeof(Mat4) * 2);
+}
+
+void frameHeap(benchmark::State& state) {
+    std::vector<Mat4> buffer;
+    frame<Mat4>(state, [&buffer](std::size_t size) {
+        buffer = std::vector<Mat4>(size);
+        return buffer.data();
+    });
+}
+
+void frameAligned(benchmark::State& state) {
+    std::vector<Mat4A, AlignedAllocator<Mat4A>> buffer;
+    frame<Mat4A>(state, [&buffer](std::size_t size) {
+        buffer = std::vector<Mat4A, AlignedAllocator<Mat4A>>(size);
+        return buffer.data();
+    });
+}
+
+void frameArena(benchmark::State& state) {
+    Arena arena(static_cast<std::size_t>(state.range(0)) * sizeof(Mat4A));
+    frame<Mat4A>(state, [&arena](std::size_t size) {
+        arena.reset();
+        return arena.allocate<Mat4A>(size);
+    });
+}
+
+}  // namespace
+
+BENCHMARK(frameHeap)->Name("Arena/frame/heap")->MATH_BENCH_SIZES;
+BENCHMARK(frameAligned)->Name("Arena/frame/alignedAllocator")->MATH_BENCH_SIZES;
+BENCHMARK(frameArena)->Name("Arena/frame")->MATH_BENCH_SIZES;
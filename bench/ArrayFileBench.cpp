@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <Bench.h>
+#include <ArrayFile.h>
+#include <Mat4.h>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+using namespace Math;
+
+namespace {
+
+const char* POSES_PATH = "math-bench-poses.bin";
+
+void arrayFileLoad(benchmark::State& state, bool mapped) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Mat4> poses(Bench::randomArray<Mat4>(size, Bench::randomRigid));
+    std::vector<Mat4> result(size);
+    Mat4 viewProjection(Bench::randomMat4());
+
+    if (!ArrayFile::write(POSES_PATH, poses.data(), size)) {
+        state.SkipWithError("Cannot write poses file");
+        return;
+    }
+
+    for (auto _: state) {
+        if (mapped) {
+            ArrayFile file;
+            if (!file.open(POSES_PATH)) {
+                state.SkipWithError("Cannot map poses file");
+                break;
+            }
+
+            viewProjection.multiply(file.data<Mat4>(), result.data(), file.size());
+        } else {
+            // Reading the payload into a heap array first, the copy mapping avoids
+            std::vector<Mat4> loaded(size);
+            std::FILE* file = std::fopen(POSES_PATH, "rb");
+            if (file == nullptr) {
+                state.SkipWithError("Cannot open poses file");
+                break;
+            }
+
+            std::size_t read = 0;
+            if (std::fseek(file, ArrayFile::HeaderSize, SEEK_SET) == 0) {
+                read = std::fread(loaded.data(), sizeof(Mat4), size, file);
+            }
+
+            std::fclose(file);
+            if (read != size) {
+                state.SkipWithError("Cannot read poses file");
+                break;
+            }
+
+            viewProjection.multiply(loaded.data(), result.data(), read);
+        }
+
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+
+    std::remove(POSES_PATH);
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(arrayFileLoad, mapped, true)->Name("ArrayFile/load")->MATH_BENCH_SIZES;
+BENCHMARK_CAPTURE(arrayFileLoad, read, false)->Name("ArrayFile/load/fread")->MATH_BENCH_SIZES;
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <Bench.h>
+#include <BVH.h>
+#include <ThreadPool.h>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+using namespace Math;
+
+namespace {
+
+ThreadPool& pool() {
+    static ThreadPool threadPool;
+    return threadPool;
+}
+
+// Small boxes scattered over a cube a hundred times their size
+std::vector<AABB> randomBoxes(std::size_t size) {
+    std::vector<AABB> boxes;
+    boxes.reserve(size);
+
+    for (std::size_t i = 0; i < size; i++) {
+        Vec3 center(Bench::randomVec3() * 100.0f);
+        Vec3 extent(Vec3(1.0f, 1.0f, 1.0f) + Bench::randomVec3() * 0.5f);
+        boxes.emplace_back(center - extent, center + extent);
+    }
+
+    return boxes;
+}
+
+void bvhBuild(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<AABB> boxes(randomBoxes(size));
+    BVH bvh;
+
+    for (auto _: state) {
+        bvh.build(boxes.data(), size);
+        benchmark::DoNotOptimize(bvh.getNodeCount());
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+void bvhBuildParallel(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<AABB> boxes(randomBoxes(size));
+    BVH bvh;
+
+    for (auto _: state) {
+        bvh.build(pool(), boxes.data(), size);
+        benchmark::DoNotOptimize(bvh.getNodeCount());
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Items are rays, each one from inside the scene towards a random direction
+void bvhRaycast(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<AABB> boxes(randomBoxes(size));
+    std::vector<Vec3> origins(Bench::randomArray<Vec3>(1024, Bench::randomVec3));
+    std::vector<Vec3> directions(Bench::randomArray<Vec3>(1024, Bench::randomVec3));
+
+    BVH bvh;
+    bvh.build(boxes.data(), size);
+
+    for (auto _: state) {
+        for (std::size_t i = 0; i < origins.size(); i++) {
+            float distance = std::numeric_limits<float>::infinity();
+            benchmark::DoNotOptimize(bvh.raycast(origins[i] * 100.0f, directions[i], distance));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * origins.size());
+}
+
+void bvhNearest(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Vec3> points(Bench::randomArray<Vec3>(size, Bench::randomVec3));
+    std::vector<Vec3> queries(Bench::randomArray<Vec3>(1024, Bench::randomVec3));
+
+    BVH bvh;
+    bvh.build(points.data(), size);
+
+    for (auto _: state) {
+        for (const auto& query: queries) {
+            float squareDistance = std::numeric_limits<float>::infinity();
+            benchmark::DoNotOptimize(bvh.nearest(query, squareDistance));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+// Baseline for BVH/nearest
+void bruteForceNearest(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Vec3> points(Bench::randomArray<Vec3>(size, Bench::randomVec3));
+    std::vector<Vec3> queries(Bench::randomArray<Vec3>(16, Bench::randomVec3));
+
+    for (auto _: state) {
+        for (const auto& query: queries) {
+            float squareDistance = std::numeric_limits<float>::infinity();
+            std::size_t nearest = BVH::NONE;
+
+            for (std::size_t i = 0; i < size; i++) {
+                float candidate = (points[i] - query).squareLength();
+                if (candidate < squareDistance) {
+                    squareDistance = candidate;
+                    nearest = i;
+                }
+            }
+
+            benchmark::DoNotOptimize(nearest);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+}  // namespace
+
+#define MATH_BVH_SIZES RangeMultiplier(16)->Range(1 << 8, 1 << 20)
+
+BENCHMARK(bvhBuild)->Name("BVH/build")->MATH_BVH_SIZES;
+BENCHMARK(bvhBuildParallel)->Name("BVH/build/parallel")->MATH_BVH_SIZES;
+BENCHMARK(bvhRaycast)->Name("BVH/raycast")->MATH_BVH_SIZES;
+BENCHMARK(bvhNearest)->Name("BVH/nearest")->MATH_BVH_SIZES;
+BENCHMARK(bruteForceNearest)->Name("BVH/nearest/bruteForce")->MATH_BVH_SIZES;
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <Bench.h>
+
+using namespace Math;
+
+namespace {
+
+void transformPoints(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Vec3> points(Bench::randomArray<Vec3>(size, Bench::randomVec3));
+    std::vector<Vec3> result(size);
+    Mat4 matrix(Bench::randomRigid());
+
+    for (auto _: state) {
+        matrix.transformPoints(points.data(), result.data(), size);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * sizeof(Vec3) * 2);
+}
+
+// Per-point loop the batch API replaces
+void transformPointsLoop(benchmark::State& state) {
+    Mat4 matrix(Bench::randomRigid());
+    Bench::unary<Vec3, Vec3>(state, Bench::randomVec3,
+            [&matrix](const Vec3& point) { return (matrix * Vec4(point, 1.0f)).extractVec3(); });
+}
+
+void transformDirections(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Vec3> directions(Bench::randomArray<Vec3>(size, Bench::randomVec3));
+    std::vector<Vec3> result(size);
+    Mat4 matrix(Bench::randomRigid());
+
+    for (auto _: state) {
+        matrix.transformDirections(directions.data(), result.data(), size);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * sizeof(Vec3) * 2);
+}
+
+void transform(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Vec4> vectors(Bench::randomArray<Vec4>(size, Bench::randomVec4));
+    std::vector<Vec4> result(size);
+    Mat4 matrix(Bench::randomMat4());
+
+    for (auto _: state) {
+        matrix.transform(vectors.data(), result.data(), size);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * sizeof(Vec4) * 2);
+}
+
+// Interleaved position + normal + uv vertex, positions transformed in place
+void transformPointsStrided(benchmark::State& state) {
+    const std::size_t stride = 8;
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<float> vertices(Bench::randomArray<float>(size * stride, Bench::randomFloat));
+    Mat4 matrix(Bench::randomRigid());
+
+    for (auto _: state) {
+        matrix.transformPoints(vertices.data(), stride, vertices.data(), stride, size);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+}  // namespace
+
+BENCHMARK(transformPoints)->Name("Mat4/transformPoints")->MATH_BENCH_SIZES;
+BENCHMARK(transformPointsLoop)->Name("Mat4/transformPoints/loop")->MATH_BENCH_SIZES;
+BENCHMARK(transformDirections)->Name("Mat4/transformDirections")->MATH_BENCH_SIZES;
+BENCHMARK(transform)->Name("Mat4/transform")->MATH_BENCH_SIZES;
+BENCHMARK(transformPointsStrided)->Name("Mat4/transformPoints/strided")->MATH_BENCH_SIZES;
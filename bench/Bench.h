@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <Vec3.h>
+#include <Vec4.h>
+#include <Mat3.h>
+#include <Mat4.h>
+#include <Quaternion.h>
+#include <DualQuaternion.h>
+#include <Mat.h>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+/*
+ * Array sizes span L1 resident (256 elements) through DRAM bound (4M elements) data.
+ */
+#define MATH_BENCH_SIZES RangeMultiplier(16)->Range(1 << 8, 1 << 22)
+
+namespace Bench {
+
+inline std::mt19937& generator() {
+    static std::mt19937 engine(20130101);
+    return engine;
+}
+
+inline float randomFloat() {
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    return distribution(generator());
+}
+
+inline Math::Vec3 randomVec3() {
+    return Math::Vec3(randomFloat(), randomFloat(), randomFloat());
+}
+
+inline Math::Vec4 randomVec4() {
+    return Math::Vec4(randomFloat(), randomFloat(), randomFloat(), randomFloat());
+}
+
+inline Math::Quaternion randomQuaternion() {
+    Math::Quaternion quaternion(randomFloat(), randomFloat(), randomFloat(), randomFloat());
+    return quaternion.normalize();
+}
+
+// Diagonally dominant matrices are well conditioned and safe to decompose without pivoting
+inline Math::Mat3 randomMat3() {
+    Math::Mat3 matrix;
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            matrix.set(i, j, randomFloat() + ((i == j) ? 4.0f : 0.0f));
+        }
+    }
+
+    return matrix;
+}
+
+inline Math::Mat4 randomMat4() {
+    Math::Mat4 matrix;
+
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            matrix.set(i, j, randomFloat() + ((i == j) ? 4.0f : 0.0f));
+        }
+    }
+
+    return matrix;
+}
+
+inline Math::Mat4 randomRigid() {
+    Math::Mat4 matrix(randomQuaternion().extractMat4());
+    matrix.set(0, 3, randomFloat());
+    matrix.set(1, 3, randomFloat());
+    matrix.set(2, 3, randomFloat());
+    return matrix;
+}
+
+inline Math::Mat4d randomMat4d() {
+    return Math::Mat4d(Math::Mat<4, float>(randomMat4().data()));
+}
+
+inline Math::DualQuaternion randomDualQuaternion() {
+    return Math::DualQuaternion(randomQuaternion(), randomVec3());
+}
+
+template<typename T, typename Generator>
+std::vector<T> randomArray(std::size_t size, Generator generate) {
+    std::vector<T> array;
+    array.reserve(size);
+
+    for (std::size_t i = 0; i < size; i++) {
+        array.push_back(generate());
+    }
+
+    return array;
+}
+
+/*
+ * Throughput of an operation applied to every element of an array, the result is
+ * written to a separate output array.
+ */
+template<typename T, typename Result, typename Generator, typename Operation>
+void unary(benchmark::State& state, Generator generate, Operation operation) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<T> input(randomArray<T>(size, generate));
+    std::vector<Result> output(size);
+
+    for (auto _: state) {
+        for (std::size_t i = 0; i < size; i++) {
+            output[i] = operation(input[i]);
+        }
+
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * (sizeof(T) + sizeof(Result)));
+}
+
+template<typename T, typename Result, typename Generator, typename Operation>
+void binary(benchmark::State& state, Generator generate, Operation operation) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<T> left(randomArray<T>(size, generate));
+    std::vector<T> right(randomArray<T>(size, generate));
+    std::vector<Result> output(size);
+
+    for (auto _: state) {
+        for (std::size_t i = 0; i < size; i++) {
+            output[i] = operation(left[i], right[i]);
+        }
+
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * (sizeof(T) * 2 + sizeof(Result)));
+}
+
+/*
+ * Latency of an operation whose every call depends on the previous result.
+ */
+template<typename T, typename Operation>
+void chain(benchmark::State& state, T value, Operation operation) {
+    for (auto _: state) {
+        value = operation(value);
+        benchmark::DoNotOptimize(value);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace Bench
+
+#endif  // BENCH_H
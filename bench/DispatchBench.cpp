@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <Bench.h>
+#include <Dispatch.h>
+#include <Vec3SoA.h>
+#include <cstdlib>
+#include <cstring>
+
+using namespace Math;
+
+namespace {
+
+/*
+ * MATH_BENCH_ISA (scalar, sse2, avx2 or neon) forces the instruction set of the whole
+ * run. The selected one is recorded in the report context either way.
+ */
+const bool isaContext = []() {
+    const char* name = std::getenv("MATH_BENCH_ISA");
+    for (int isa = Dispatch::SCALAR; name != nullptr && isa <= Dispatch::NEON; isa++) {
+        if (std::strcmp(name, Dispatch::getName(static_cast<Dispatch::Isa>(isa))) == 0) {
+            Dispatch::select(static_cast<Dispatch::Isa>(isa));
+        }
+    }
+
+    benchmark::AddCustomContext("math_isa", Dispatch::getName(Dispatch::getSelected()));
+    return true;
+}();
+
+// Runs the benchmark body with the given kernels, unsupported instruction sets are skipped
+template<typename Body>
+void withIsa(benchmark::State& state, Dispatch::Isa isa, Body body) {
+    Dispatch::Isa selected = Dispatch::getSelected();
+    if (!Dispatch::select(isa)) {
+        state.SkipWithError("instruction set not available");
+        return;
+    }
+
+    body();
+    Dispatch::select(selected);
+}
+
+void transformPoints(benchmark::State& state, Dispatch::Isa isa) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Vec3> points(Bench::randomArray<Vec3>(size, Bench::randomVec3));
+    std::vector<Vec3> result(size);
+    Mat4 matrix(Bench::randomRigid());
+
+    withIsa(state, isa, [&]() {
+        for (auto _: state) {
+            matrix.transformPoints(points.data(), result.data(), size);
+            benchmark::ClobberMemory();
+        }
+    });
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * sizeof(Vec3) * 2);
+}
+
+void multiplyBatch(benchmark::State& state, Dispatch::Isa isa) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Mat4> matrices(Bench::randomArray<Mat4>(size, Bench::randomMat4));
+    std::vector<Mat4> result(size);
+    Mat4 matrix(Bench::randomMat4());
+
+    withIsa(state, isa, [&]() {
+        for (auto _: state) {
+            matrix.multiply(matrices.data(), result.data(), size);
+            benchmark::ClobberMemory();
+        }
+    });
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * sizeof(Mat4) * 2);
+}
+
+void invertBatch(benchmark::State& state, Dispatch::Isa isa) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Mat4> matrices(Bench::randomArray<Mat4>(size, Bench::randomMat4));
+    std::vector<Mat4> result(size);
+
+    withIsa(state, isa, [&]() {
+        for (auto _: state) {
+            Mat4::invert(matrices.data(), result.data(), size);
+            benchmark::ClobberMemory();
+        }
+    });
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * sizeof(Mat4) * 2);
+}
+
+void normalizeSoA(benchmark::State& state, Dispatch::Isa isa) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Vec3> vectors(Bench::randomArray<Vec3>(size, Bench::randomVec3));
+    Vec3SoA soa(vectors.data(), size);
+
+    withIsa(state, isa, [&]() {
+        for (auto _: state) {
+            soa.normalize();
+            benchmark::ClobberMemory();
+        }
+    });
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * sizeof(Vec3) * 2);
+}
+
+}  // namespace
+
+#define MATH_BENCH_ISA(function, name) \
+    BENCHMARK_CAPTURE(function, scalar, Dispatch::SCALAR)->Name(name "/scalar")->MATH_BENCH_SIZES; \
+    BENCHMARK_CAPTURE(function, sse2, Dispatch::SSE2)->Name(name "/sse2")->MATH_BENCH_SIZES; \
+    BENCHMARK_CAPTURE(function, avx2, Dispatch::AVX2)->Name(name "/avx2")->MATH_BENCH_SIZES; \
+    BENCHMARK_CAPTURE(function, neon, Dispatch::NEON)->Name(name "/neon")->MATH_BENCH_SIZES
+
+MATH_BENCH_ISA(transformPoints, "Dispatch/Mat4/transformPoints");
+MATH_BENCH_ISA(multiplyBatch, "Dispatch/Mat4/multiply/batch");
+MATH_BENCH_ISA(invertBatch, "Dispatch/Mat4/invert/batch");
+MATH_BENCH_ISA(normalizeSoA, "Dispatch/Vec3SoA/normalize");
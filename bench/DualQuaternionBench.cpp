@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <Bench.h>
+
+using namespace Math;
+
+namespace {
+
+void dualQuaternionProduct(benchmark::State& state) {
+    Bench::binary<DualQuaternion, DualQuaternion>(state, Bench::randomDualQuaternion,
+            [](const DualQuaternion& left, const DualQuaternion& right) { return left * right; });
+}
+
+void dualQuaternionProductLatency(benchmark::State& state) {
+    DualQuaternion step(Bench::randomDualQuaternion());
+    Bench::chain(state, DualQuaternion(), [&step](const DualQuaternion& dualQuaternion) {
+        return dualQuaternion * step;
+    });
+}
+
+// Rigid chain composed with matrices, the baseline DualQuaternion replaces
+void dualQuaternionProductMat4(benchmark::State& state) {
+    Bench::binary<Mat4, Mat4>(state, Bench::randomRigid,
+            [](const Mat4& left, const Mat4& right) { return left * right; });
+}
+
+void dualQuaternionTransformPoint(benchmark::State& state) {
+    DualQuaternion dualQuaternion(Bench::randomDualQuaternion());
+    Bench::unary<Vec3, Vec3>(state, Bench::randomVec3,
+            [&dualQuaternion](const Vec3& point) { return dualQuaternion.transformPoint(point); });
+}
+
+void dualQuaternionFromMat4(benchmark::State& state) {
+    Bench::unary<Mat4, DualQuaternion>(state, Bench::randomRigid,
+            [](const Mat4& matrix) { return DualQuaternion(matrix); });
+}
+
+void dualQuaternionSkin(benchmark::State& state, std::size_t influences) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::size_t joints = 64;
+
+    std::vector<DualQuaternion> pose(Bench::randomArray<DualQuaternion>(joints, Bench::randomDualQuaternion));
+    std::vector<Vec3> points(Bench::randomArray<Vec3>(size, Bench::randomVec3));
+    std::vector<unsigned int> indices(size * influences);
+    std::vector<float> weights(size * influences, 1.0f / influences);
+    std::vector<Vec3> result(size);
+
+    for (std::size_t i = 0; i < indices.size(); i++) {
+        indices[i] = static_cast<unsigned int>(Bench::generator()() % joints);
+    }
+
+    for (auto _: state) {
+        DualQuaternion::skin(pose.data(), indices.data(), weights.data(), influences,
+                points.data(), result.data(), size);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+}  // namespace
+
+BENCHMARK(dualQuaternionProduct)->Name("DualQuaternion/operator*")->MATH_BENCH_SIZES;
+BENCHMARK(dualQuaternionProductLatency)->Name("DualQuaternion/operator*/latency");
+BENCHMARK(dualQuaternionProductMat4)->Name("DualQuaternion/operator*/Mat4")->MATH_BENCH_SIZES;
+BENCHMARK(dualQuaternionTransformPoint)->Name("DualQuaternion/transformPoint")->MATH_BENCH_SIZES;
+BENCHMARK(dualQuaternionFromMat4)->Name("DualQuaternion/DualQuaternion/Mat4")->MATH_BENCH_SIZES;
+BENCHMARK_CAPTURE(dualQuaternionSkin, one, 1)->Name("DualQuaternion/skin/1")->MATH_BENCH_SIZES;
+BENCHMARK_CAPTURE(dualQuaternionSkin, four, 4)->Name("DualQuaternion/skin/4")->MATH_BENCH_SIZES;
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <Bench.h>
+#include <Frustum.h>
+#include <AABB.h>
+#include <Sphere.h>
+
+using namespace Math;
+
+namespace {
+
+// 90 degree perspective looking down -Z from (0, 0, 1), about a third of random objects is visible
+Frustum cameraFrustum() {
+    float nearPlane = 0.1f;
+    float farPlane = 10.0f;
+    Mat4 projection;
+    projection.set(2, 2, -(farPlane + nearPlane) / (farPlane - nearPlane));
+    projection.set(2, 3, -2.0f * farPlane * nearPlane / (farPlane - nearPlane));
+    projection.set(3, 2, -1.0f);
+    projection.set(3, 3, 0.0f);
+
+    Mat4 view;
+    view.set(2, 3, -1.0f);
+    return Frustum(projection * view);
+}
+
+AABB randomAABB() {
+    Vec3 center(Bench::randomVec3());
+    Vec3 extent(Bench::randomVec3() * 0.05f);
+    extent = Vec3(fabsf(extent.get(Vec3::X)), fabsf(extent.get(Vec3::Y)), fabsf(extent.get(Vec3::Z)));
+    return AABB(center - extent, center + extent);
+}
+
+Sphere randomSphere() {
+    return Sphere(Bench::randomVec3(), fabsf(Bench::randomFloat()) * 0.05f);
+}
+
+template<typename T, typename Generator>
+void frustumCull(benchmark::State& state, Generator generate) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<T> objects(Bench::randomArray<T>(size, generate));
+    std::vector<std::size_t> visible(size);
+    Frustum frustum(cameraFrustum());
+
+    for (auto _: state) {
+        benchmark::DoNotOptimize(frustum.cull(objects.data(), size, visible.data()));
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Hand-rolled per object loop the batch routines replace
+template<typename T, typename Generator>
+void frustumIntersects(benchmark::State& state, Generator generate) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<T> objects(Bench::randomArray<T>(size, generate));
+    std::vector<std::size_t> visible(size);
+    Frustum frustum(cameraFrustum());
+
+    for (auto _: state) {
+        std::size_t visibleCount = 0;
+
+        for (std::size_t i = 0; i < size; i++) {
+            if (frustum.intersects(objects[i])) {
+                visible[visibleCount++] = i;
+            }
+        }
+
+        benchmark::DoNotOptimize(visibleCount);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+void frustumCullAABB(benchmark::State& state) {
+    frustumCull<AABB>(state, randomAABB);
+}
+
+void frustumCullSphere(benchmark::State& state) {
+    frustumCull<Sphere>(state, randomSphere);
+}
+
+void frustumIntersectsAABB(benchmark::State& state) {
+    frustumIntersects<AABB>(state, randomAABB);
+}
+
+void frustumIntersectsSphere(benchmark::State& state) {
+    frustumIntersects<Sphere>(state, randomSphere);
+}
+
+void frustumFromMat4(benchmark::State& state) {
+    Mat4 matrix(Bench::randomMat4());
+
+    for (auto _: state) {
+        Frustum frustum(matrix);
+        benchmark::DoNotOptimize(frustum);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(frustumCullAABB)->Name("Frustum/cull/AABB")->MATH_BENCH_SIZES;
+BENCHMARK(frustumCullSphere)->Name("Frustum/cull/Sphere")->MATH_BENCH_SIZES;
+BENCHMARK(frustumIntersectsAABB)->Name("Frustum/intersects/AABB")->MATH_BENCH_SIZES;
+BENCHMARK(frustumIntersectsSphere)->Name("Frustum/intersects/Sphere")->MATH_BENCH_SIZES;
+BENCHMARK(frustumFromMat4)->Name("Frustum/Frustum/Mat4");
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <Bench.h>
+#include <Instrumentation.h>
+
+using namespace Math;
+
+/*
+ * Per call cost of a probe, built with -DMATH_INSTRUMENTATION=ON only. Probes compile
+ * to nothing otherwise.
+ */
+#if defined(MATH_INSTRUMENTATION)
+
+namespace {
+
+void probeScope(benchmark::State& state) {
+    for (auto _: state) {
+        MATH_PROBE(MAT4_INVERT, 1);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void probeHooks(benchmark::State& state) {
+    std::size_t spans = 0;
+    Instrumentation::setHooks([](Instrumentation::Probe, void*) { },
+            [](Instrumentation::Probe, std::size_t, void* context) { ++*static_cast<std::size_t*>(context); },
+            &spans);
+
+    for (auto _: state) {
+        MATH_PROBE(MAT4_INVERT, 1);
+        benchmark::ClobberMemory();
+    }
+
+    Instrumentation::setHooks(nullptr, nullptr, nullptr);
+    benchmark::DoNotOptimize(spans);
+    state.SetItemsProcessed(state.iterations());
+}
+
+void probeCount(benchmark::State& state) {
+    for (auto _: state) {
+        MATH_COUNT(MAT4_INVERT);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void mat4InvertBatch(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Mat4> matrices(Bench::randomArray<Mat4>(size, Bench::randomMat4));
+    std::vector<Mat4> result(size);
+
+    for (auto _: state) {
+        Mat4::invert(matrices.data(), result.data(), size);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * sizeof(Mat4) * 2);
+
+    Instrumentation::Counters counters = Instrumentation::get(Instrumentation::MAT4_INVERT_BATCH);
+    state.counters["cycles_per_element"] = static_cast<double>(counters.cycles) / static_cast<double>(counters.elements);
+    Instrumentation::reset();
+}
+
+}  // namespace
+
+BENCHMARK(probeScope)->Name("Instrumentation/scope");
+BENCHMARK(probeHooks)->Name("Instrumentation/scope/hooks");
+BENCHMARK(probeCount)->Name("Instrumentation/count");
+BENCHMARK(mat4InvertBatch)->Name("Instrumentation/Mat4/invert/batch")->MATH_BENCH_SIZES;
+
+#endif
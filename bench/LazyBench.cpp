@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <Bench.h>
+#include <Lazy.h>
+#include <type_traits>
+
+using namespace Math;
+
+namespace {
+
+/*
+ * Every operand varies per element, otherwise the compiler hoists the invariant
+ * part of an eager chain out of the loop in header-only builds.
+ */
+template<typename T, typename Operation>
+void ternary(benchmark::State& state, Operation operation) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Mat4> first(Bench::randomArray<Mat4>(size, Bench::randomMat4));
+    std::vector<Mat4> second(Bench::randomArray<Mat4>(size, Bench::randomMat4));
+    std::vector<T> third(size);
+    std::vector<T> output(size);
+
+    for (std::size_t i = 0; i < size; i++) {
+        if constexpr (std::is_same<T, Vec4>::value) {
+            third[i] = Bench::randomVec4();
+        } else {
+            third[i] = Bench::randomMat4();
+        }
+    }
+
+    for (auto _: state) {
+        for (std::size_t i = 0; i < size; i++) {
+            output[i] = operation(first[i], second[i], third[i]);
+        }
+
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * (sizeof(Mat4) * 2 + sizeof(T) * 2));
+}
+
+void chainProduct(benchmark::State& state) {
+    ternary<Mat4>(state, [](const Mat4& projection, const Mat4& view, const Mat4& model) {
+        return projection * view * model;
+    });
+}
+
+void chainProductLazy(benchmark::State& state) {
+    ternary<Mat4>(state, [](const Mat4& projection, const Mat4& view, const Mat4& model) {
+        return Mat4(lazy(projection) * view * model);
+    });
+}
+
+void chainVec4(benchmark::State& state) {
+    ternary<Vec4>(state, [](const Mat4& projection, const Mat4& view, const Vec4& vector) {
+        return projection * view * vector;
+    });
+}
+
+void chainVec4Lazy(benchmark::State& state) {
+    ternary<Vec4>(state, [](const Mat4& projection, const Mat4& view, const Vec4& vector) {
+        return Vec4(lazy(projection) * view * vector);
+    });
+}
+
+void scaledSum(benchmark::State& state) {
+    ternary<Mat4>(state, [](const Mat4& left, const Mat4& right, const Mat4& offset) {
+        return left * right + offset * 0.5f;
+    });
+}
+
+void scaledSumLazy(benchmark::State& state) {
+    ternary<Mat4>(state, [](const Mat4& left, const Mat4& right, const Mat4& offset) {
+        return Mat4(lazy(left) * right + lazy(offset) * 0.5f);
+    });
+}
+
+}  // namespace
+
+BENCHMARK(chainProduct)->Name("Lazy/Mat4*Mat4*Mat4/eager")->MATH_BENCH_SIZES;
+BENCHMARK(chainProductLazy)->Name("Lazy/Mat4*Mat4*Mat4")->MATH_BENCH_SIZES;
+BENCHMARK(chainVec4)->Name("Lazy/Mat4*Mat4*Vec4/eager")->MATH_BENCH_SIZES;
+BENCHMARK(chainVec4Lazy)->Name("Lazy/Mat4*Mat4*Vec4")->MATH_BENCH_SIZES;
+BENCHMARK(scaledSum)->Name("Lazy/Mat4*Mat4+Mat4*float/eager")->MATH_BENCH_SIZES;
+BENCHMARK(scaledSumLazy)->Name("Lazy/Mat4*Mat4+Mat4*float")->MATH_BENCH_SIZES;
@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <Bench.h>
+#include <LU4.h>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+using namespace Math;
+
+namespace {
+
+void mat3Product(benchmark::State& state) {
+    Bench::binary<Mat3, Mat3>(state, Bench::randomMat3,
+            [](const Mat3& left, const Mat3& right) { return left * right; });
+}
+
+void mat3Vec3Product(benchmark::State& state) {
+    Mat3 matrix(Bench::randomMat3());
+    Bench::unary<Vec3, Vec3>(state, Bench::randomVec3,
+            [&matrix](const Vec3& vector) { return matrix * vector; });
+}
+
+void mat3Invert(benchmark::State& state) {
+    Bench::unary<Mat3, Mat3>(state, Bench::randomMat3,
+            [](const Mat3& matrix) { return Mat3(matrix).invert(); });
+}
+
+// LU based inversion the cofactor expression replaces
+void mat3InvertLU(benchmark::State& state) {
+    Bench::unary<Mat3, Mat3>(state, Bench::randomMat3, [](const Mat3& matrix) {
+        Mat3 lower;
+        Mat3 upper;
+        matrix.decompose(lower, upper);
+
+        float columns[3][3] = {};
+        Vec3 identity[] = { Vec3::UNIT_X, Vec3::UNIT_Y, Vec3::UNIT_Z };
+
+        for (int i = 0; i < 3; i++) {
+            Vec3 column(upper.solveU(lower.solveL(identity[i])));
+            for (int j = 0; j < 3; j++) {
+                columns[j][i] = column.get(j);
+            }
+        }
+
+        return Mat3(columns[0]);
+    });
+}
+
+void mat3Solve(benchmark::State& state) {
+    Mat3 matrix(Bench::randomMat3());
+    Bench::unary<Vec3, Vec3>(state, Bench::randomVec3,
+            [&matrix](const Vec3& absolute) { return matrix.solve(absolute); });
+}
+
+void mat3Decompose(benchmark::State& state) {
+    Bench::unary<Mat3, Mat3>(state, Bench::randomMat3, [](const Mat3& matrix) {
+        Mat3 lower;
+        Mat3 upper;
+        matrix.decompose(lower, upper);
+        return upper;
+    });
+}
+
+void mat4Product(benchmark::State& state) {
+    Bench::binary<Mat4, Mat4>(state, Bench::randomMat4,
+            [](const Mat4& left, const Mat4& right) { return left * right; });
+}
+
+void mat4ProductLatency(benchmark::State& state) {
+    Mat4 step(Bench::randomRigid());
+    Bench::chain(state, Mat4(), [&step](const Mat4& matrix) { return matrix * step; });
+}
+
+// One view-projection times many model matrices, the case multiply() batches
+void mat4ProductShared(benchmark::State& state) {
+    Mat4 matrix(Bench::randomMat4());
+    Bench::unary<Mat4, Mat4>(state, Bench::randomMat4,
+            [&matrix](const Mat4& model) { return matrix * model; });
+}
+
+void mat4MultiplyBatch(benchmark::State& state, Mat4::Layout layout) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Mat4> matrices(Bench::randomArray<Mat4>(size, Bench::randomMat4));
+    std::vector<Mat4> result(size);
+    Mat4 matrix(Bench::randomMat4());
+
+    for (auto _: state) {
+        matrix.multiply(matrices.data(), result.data(), size, layout);
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * sizeof(Mat4) * 2);
+}
+
+void mat4Vec4Product(benchmark::State& state) {
+    Mat4 matrix(Bench::randomMat4());
+    Bench::unary<Vec4, Vec4>(state, Bench::randomVec4,
+            [&matrix](const Vec4& vector) { return matrix * vector; });
+}
+
+void mat4Transpose(benchmark::State& state) {
+    Bench::unary<Mat4, Mat4>(state, Bench::randomMat4,
+            [](const Mat4& matrix) { return Mat4(matrix).transpose(); });
+}
+
+void mat4Upload(benchmark::State& state, bool transposed) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Mat4> matrices(Bench::randomArray<Mat4>(size, Bench::randomMat4));
+    std::vector<float> buffer(size * 16);
+
+    for (auto _: state) {
+        if (transposed) {
+            Mat4::copyTransposed(matrices.data(), buffer.data(), size);
+        } else {
+            // Transposing a copy and writing it out, the path copyTransposed() replaces
+            for (std::size_t i = 0; i < size; i++) {
+                Mat4 matrix(matrices[i]);
+                matrix.transpose();
+                std::memcpy(buffer.data() + i * 16, matrix.data(), sizeof(Mat4));
+            }
+        }
+
+        benchmark::DoNotOptimize(buffer.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * sizeof(Mat4) * 2);
+}
+
+void mat4Invert(benchmark::State& state) {
+    Bench::unary<Mat4, Mat4>(state, Bench::randomMat4,
+            [](const Mat4& matrix) { return Mat4(matrix).invert(); });
+}
+
+void mat4InvertBatch(benchmark::State& state, Mat4::Layout layout) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Mat4> matrices(Bench::randomArray<Mat4>(size, Bench::randomMat4));
+    std::vector<Mat4> result(size);
+
+    for (auto _: state) {
+        Mat4::invert(matrices.data(), result.data(), size, layout);
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * sizeof(Mat4) * 2);
+}
+
+// Former Mat4::invert() implementation, kept as a baseline for the cofactor expansion
+void mat4InvertLU(benchmark::State& state) {
+    Bench::unary<Mat4, Mat4>(state, Bench::randomMat4, [](const Mat4& matrix) {
+        Mat4 lower;
+        Mat4 upper;
+        matrix.decompose(lower, upper);
+
+        Vec4 identity[] = {
+            Vec4(1.0f, 0.0f, 0.0f, 0.0f),
+            Vec4(0.0f, 1.0f, 0.0f, 0.0f),
+            Vec4(0.0f, 0.0f, 1.0f, 0.0f),
+            Vec4(0.0f, 0.0f, 0.0f, 1.0f)
+        };
+
+        Mat4 inverse;
+        for (int i = 0; i < 4; i++) {
+            Vec4 column(upper.solveU(lower.solveL(identity[i])));
+            for (int j = 0; j < 4; j++) {
+                inverse.set(j, i, column.get(j));
+            }
+        }
+
+        return inverse;
+    });
+}
+
+void mat4InvertAffine(benchmark::State& state) {
+    Bench::unary<Mat4, Mat4>(state, Bench::randomRigid,
+            [](const Mat4& matrix) { return Mat4(matrix).invertAffine(); });
+}
+
+void mat4InvertRigid(benchmark::State& state) {
+    Bench::unary<Mat4, Mat4>(state, Bench::randomRigid,
+            [](const Mat4& matrix) { return Mat4(matrix).invertRigid(); });
+}
+
+void mat4Decompose(benchmark::State& state) {
+    Bench::unary<Mat4, Mat4>(state, Bench::randomMat4, [](const Mat4& matrix) {
+        Mat4 lower;
+        Mat4 upper;
+        matrix.decompose(lower, upper);
+        return upper;
+    });
+}
+
+void lu4Factorize(benchmark::State& state) {
+    Bench::unary<Mat4, LU4>(state, Bench::randomMat4, [](const Mat4& matrix) { return LU4(matrix); });
+}
+
+void lu4Solve(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Vec4> absolute(Bench::randomArray<Vec4>(size, Bench::randomVec4));
+    std::vector<Vec4> solution(size);
+    LU4 lu(Bench::randomMat4());
+
+    for (auto _: state) {
+        lu.solve(absolute.data(), solution.data(), size);
+        benchmark::DoNotOptimize(solution.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * sizeof(Vec4) * 2);
+}
+
+// Unpivoted decompose() factors and paired substitutions LU4 replaces
+void lu4SolveDecomposed(benchmark::State& state) {
+    Mat4 lower;
+    Mat4 upper;
+    Bench::randomMat4().decompose(lower, upper);
+    Bench::unary<Vec4, Vec4>(state, Bench::randomVec4,
+            [&lower, &upper](const Vec4& absolute) { return upper.solveU(lower.solveL(absolute)); });
+}
+
+void mat4NormalMatrix(benchmark::State& state) {
+    Bench::unary<Mat4, Mat3>(state, Bench::randomMat4,
+            [](const Mat4& matrix) { return matrix.normalMatrix(); });
+}
+
+void mat4NormalMatrixRigid(benchmark::State& state) {
+    Bench::unary<Mat4, Mat3>(state, Bench::randomRigid,
+            [](const Mat4& matrix) { return matrix.normalMatrixRigid(); });
+}
+
+// Inverse-transpose of the extracted block normalMatrix() replaces
+void mat4NormalMatrixInverseTranspose(benchmark::State& state) {
+    Bench::unary<Mat4, Mat3>(state, Bench::randomMat4,
+            [](const Mat4& matrix) { return matrix.extractMat3().invert().transpose(); });
+}
+
+struct Transform {
+    Vec3 translation;
+    Quaternion rotation;
+    Vec3 scale;
+};
+
+Transform randomTransform() {
+    return Transform { Bench::randomVec3(), Bench::randomQuaternion(), Bench::randomVec3() };
+}
+
+void mat4FromTRS(benchmark::State& state) {
+    Bench::unary<Transform, Mat4>(state, randomTransform, [](const Transform& transform) {
+        return Mat4::fromTRS(transform.translation, transform.rotation, transform.scale);
+    });
+}
+
+// Identity based composition fromTRS replaces
+void mat4FromTRSComposed(benchmark::State& state) {
+    Bench::unary<Transform, Mat4>(state, randomTransform, [](const Transform& transform) {
+        return Mat4::translate(transform.translation) * transform.rotation.extractMat4() *
+               Mat4::scale(transform.scale);
+    });
+}
+
+void mat4dProduct(benchmark::State& state) {
+    Bench::binary<Mat4d, Mat4d>(state, Bench::randomMat4d,
+            [](const Mat4d& left, const Mat4d& right) { return left * right; });
+}
+
+void mat4dVec4dProduct(benchmark::State& state) {
+    Mat4d matrix(Bench::randomMat4d());
+    Bench::unary<Vec4d, Vec4d>(state, [] { return Vec4d(Bench::randomFloat(), Bench::randomFloat(),
+                                                         Bench::randomFloat(), Bench::randomFloat()); },
+            [&matrix](const Vec4d& vector) { return matrix * vector; });
+}
+
+}  // namespace
+
+BENCHMARK(mat3Product)->Name("Mat3/operator*")->MATH_BENCH_SIZES;
+BENCHMARK(mat3Vec3Product)->Name("Mat3/operator*/Vec3")->MATH_BENCH_SIZES;
+BENCHMARK(mat3Invert)->Name("Mat3/invert")->MATH_BENCH_SIZES;
+BENCHMARK(mat3InvertLU)->Name("Mat3/invert/lu")->MATH_BENCH_SIZES;
+BENCHMARK(mat3Solve)->Name("Mat3/solve")->MATH_BENCH_SIZES;
+BENCHMARK(mat3Decompose)->Name("Mat3/decompose")->MATH_BENCH_SIZES;
+
+BENCHMARK(mat4Product)->Name("Mat4/operator*")->MATH_BENCH_SIZES;
+BENCHMARK(mat4ProductLatency)->Name("Mat4/operator*/latency");
+BENCHMARK(mat4ProductShared)->Name("Mat4/operator*/shared")->MATH_BENCH_SIZES;
+BENCHMARK_CAPTURE(mat4MultiplyBatch, rowMajor, Mat4::ROW_MAJOR)->Name("Mat4/multiply/batch")->MATH_BENCH_SIZES;
+BENCHMARK_CAPTURE(mat4MultiplyBatch, columnMajor, Mat4::COLUMN_MAJOR)
+        ->Name("Mat4/multiply/batch/columnMajor")->MATH_BENCH_SIZES;
+BENCHMARK(mat4Vec4Product)->Name("Mat4/operator*/Vec4")->MATH_BENCH_SIZES;
+BENCHMARK(mat4Transpose)->Name("Mat4/transpose")->MATH_BENCH_SIZES;
+BENCHMARK_CAPTURE(mat4Upload, copyTransposed, true)->Name("Mat4/copyTransposed")->MATH_BENCH_SIZES;
+BENCHMARK_CAPTURE(mat4Upload, transpose, false)->Name("Mat4/copyTransposed/transpose")->MATH_BENCH_SIZES;
+BENCHMARK(mat4Invert)->Name("Mat4/invert")->MATH_BENCH_SIZES;
+BENCHMARK_CAPTURE(mat4InvertBatch, rowMajor, Mat4::ROW_MAJOR)->Name("Mat4/invert/batch")->MATH_BENCH_SIZES;
+BENCHMARK_CAPTURE(mat4InvertBatch, columnMajor, Mat4::COLUMN_MAJOR)
+        ->Name("Mat4/invert/batch/columnMajor")->MATH_BENCH_SIZES;
+BENCHMARK(mat4InvertLU)->Name("Mat4/invert/lu")->MATH_BENCH_SIZES;
+BENCHMARK(mat4InvertAffine)->Name("Mat4/invertAffine")->MATH_BENCH_SIZES;
+BENCHMARK(mat4InvertRigid)->Name("Mat4/invertRigid")->MATH_BENCH_SIZES;
+BENCHMARK(mat4Decompose)->Name("Mat4/decompose")->MATH_BENCH_SIZES;
+BENCHMARK(lu4Factorize)->Name("LU4/factorize")->MATH_BENCH_SIZES;
+BENCHMARK(lu4Solve)->Name("LU4/solve")->MATH_BENCH_SIZES;
+BENCHMARK(lu4SolveDecomposed)->Name("LU4/solve/decompose")->MATH_BENCH_SIZES;
+BENCHMARK(mat4NormalMatrix)->Name("Mat4/normalMatrix")->MATH_BENCH_SIZES;
+BENCHMARK(mat4NormalMatrixRigid)->Name("Mat4/normalMatrixRigid")->MATH_BENCH_SIZES;
+BENCHMARK(mat4NormalMatrixInverseTranspose)->Name("Mat4/normalMatrix/inverseTranspose")->MATH_BENCH_SIZES;
+BENCHMARK(mat4FromTRS)->Name("Mat4/fromTRS")->MATH_BENCH_SIZES;
+BENCHMARK(mat4FromTRSComposed)->Name("Mat4/fromTRS/composed")->MATH_BENCH_SIZES;
+
+BENCHMARK(mat4dProduct)->Name("Mat4d/operator*")->MATH_BENCH_SIZES;
+BENCHMARK(mat4dVec4dProduct)->Name("Mat4d/operator*/Vec4d")->MATH_BENCH_SIZES;
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <Bench.h>
+#include <Parallel.h>
+#include <ThreadPool.h>
+#include <Vec3SoA.h>
+
+using namespace Math;
+
+namespace {
+
+ThreadPool& pool() {
+    static ThreadPool threadPool;
+    return threadPool;
+}
+
+// Serial counterparts are Mat4/transformPoints, Quaternion/rotate/batch, Mat4/invert and Vec3SoA/normalize
+void parallelTransformPoints(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Vec3> points(Bench::randomArray<Vec3>(size, Bench::randomVec3));
+    std::vector<Vec3> result(size);
+    Mat4 matrix(Bench::randomRigid());
+
+    for (auto _: state) {
+        Parallel::transformPoints(pool(), matrix, points.data(), result.data(), size);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * sizeof(Vec3) * 2);
+}
+
+void parallelRotate(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Vec3> vectors(Bench::randomArray<Vec3>(size, Bench::randomVec3));
+    std::vector<Vec3> result(size);
+    Quaternion quaternion(Bench::randomQuaternion());
+
+    for (auto _: state) {
+        Parallel::rotate(pool(), quaternion, vectors.data(), result.data(), size);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * sizeof(Vec3) * 2);
+}
+
+void parallelInvert(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Mat4> matrices(Bench::randomArray<Mat4>(size, Bench::randomMat4));
+    std::vector<Mat4> result(size);
+
+    for (auto _: state) {
+        Parallel::invert(pool(), matrices.data(), result.data(), size);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * sizeof(Mat4) * 2);
+}
+
+void parallelNormalize(benchmark::State& state, bool fast) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Vec3> vectors(Bench::randomArray<Vec3>(size, Bench::randomVec3));
+    Vec3SoA soa(vectors.data(), size);
+
+    for (auto _: state) {
+        if (fast) {
+            Parallel::normalizeFast(pool(), soa);
+        } else {
+            Parallel::normalize(pool(), soa);
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * sizeof(Vec3) * 2);
+}
+
+}  // namespace
+
+BENCHMARK(parallelTransformPoints)->Name("Parallel/transformPoints")->MATH_BENCH_SIZES->UseRealTime();
+BENCHMARK(parallelRotate)->Name("Parallel/rotate")->MATH_BENCH_SIZES->UseRealTime();
+BENCHMARK(parallelInvert)->Name("Parallel/invert")->MATH_BENCH_SIZES->UseRealTime();
+BENCHMARK_CAPTURE(parallelNormalize, exact, false)->Name("Parallel/normalize")->MATH_BENCH_SIZES->UseRealTime();
+BENCHMARK_CAPTURE(parallelNormalize, fast, true)->Name("Parallel/normalizeFast")->MATH_BENCH_SIZES->UseRealTime();
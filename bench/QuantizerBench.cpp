@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <Bench.h>
+#include <Quantizer.h>
+#include <cstddef>
+#include <vector>
+
+using namespace Math;
+
+namespace {
+
+void packedQuaternionPack(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Quaternion> quaternions(Bench::randomArray<Quaternion>(size, Bench::randomQuaternion));
+    std::vector<PackedQuaternion> packed(size);
+
+    for (auto _: state) {
+        PackedQuaternion::pack(quaternions.data(), packed.data(), size);
+        benchmark::DoNotOptimize(packed.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+void packedQuaternionPackScalar(benchmark::State& state) {
+    Bench::unary<Quaternion, PackedQuaternion>(state, Bench::randomQuaternion,
+            [](const Quaternion& quaternion) { return PackedQuaternion(quaternion); });
+}
+
+void packedQuaternionUnpack(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Quaternion> quaternions(Bench::randomArray<Quaternion>(size, Bench::randomQuaternion));
+    std::vector<PackedQuaternion> packed(size);
+    PackedQuaternion::pack(quaternions.data(), packed.data(), size);
+
+    for (auto _: state) {
+        PackedQuaternion::unpack(packed.data(), quaternions.data(), size);
+        benchmark::DoNotOptimize(quaternions.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+void packedQuaternion48Pack(benchmark::State& state) {
+    Bench::unary<Quaternion, PackedQuaternion48>(state, Bench::randomQuaternion,
+            [](const Quaternion& quaternion) { return PackedQuaternion48(quaternion); });
+}
+
+void quantizerPack(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Vec3> positions(Bench::randomArray<Vec3>(size, Bench::randomVec3));
+    std::vector<PackedVec3> packed(size);
+    Quantizer quantizer(AABB(Vec3(-1.0f, -1.0f, -1.0f), Vec3(1.0f, 1.0f, 1.0f)));
+
+    for (auto _: state) {
+        quantizer.pack(positions.data(), packed.data(), size);
+        benchmark::DoNotOptimize(packed.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+void quantizerUnpack(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Vec3> positions(Bench::randomArray<Vec3>(size, Bench::randomVec3));
+    std::vector<PackedVec3> packed(size);
+    Quantizer quantizer(AABB(Vec3(-1.0f, -1.0f, -1.0f), Vec3(1.0f, 1.0f, 1.0f)));
+    quantizer.pack(positions.data(), packed.data(), size);
+
+    for (auto _: state) {
+        quantizer.unpack(packed.data(), positions.data(), size);
+        benchmark::DoNotOptimize(positions.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+}  // namespace
+
+BENCHMARK(packedQuaternionPack)->Name("PackedQuaternion/pack")->MATH_BENCH_SIZES;
+BENCHMARK(packedQuaternionPackScalar)->Name("PackedQuaternion/pack/scalar")->MATH_BENCH_SIZES;
+BENCHMARK(packedQuaternionUnpack)->Name("PackedQuaternion/unpack")->MATH_BENCH_SIZES;
+BENCHMARK(packedQuaternion48Pack)->Name("PackedQuaternion48/pack")->MATH_BENCH_SIZES;
+BENCHMARK(quantizerPack)->Name("Quantizer/pack")->MATH_BENCH_SIZES;
+BENCHMARK(quantizerUnpack)->Name("Quantizer/unpack")->MATH_BENCH_SIZES;
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <Bench.h>
+
+using namespace Math;
+
+namespace {
+
+void quaternionProduct(benchmark::State& state) {
+    Bench::binary<Quaternion, Quaternion>(state, Bench::randomQuaternion,
+            [](const Quaternion& left, const Quaternion& right) { return left * right; });
+}
+
+void quaternionProductLatency(benchmark::State& state) {
+    Quaternion step(Bench::randomQuaternion());
+    Bench::chain(state, Quaternion(), [&step](const Quaternion& quaternion) { return quaternion * step; });
+}
+
+void quaternionNormalize(benchmark::State& state) {
+    Bench::unary<Quaternion, Quaternion>(state, Bench::randomQuaternion,
+            [](const Quaternion& quaternion) { return Quaternion(quaternion).normalize(); });
+}
+
+void quaternionNormalizeFast(benchmark::State& state) {
+    Bench::unary<Quaternion, Quaternion>(state, Bench::randomQuaternion,
+            [](const Quaternion& quaternion) { return Quaternion(quaternion).normalizeFast(); });
+}
+
+void quaternionNormalizeFastBatch(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Quaternion> quaternions(Bench::randomArray<Quaternion>(size, Bench::randomQuaternion));
+    std::vector<Quaternion> result(size);
+
+    for (auto _: state) {
+        Quaternion::normalizeFast(quaternions.data(), result.data(), size);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * sizeof(Quaternion) * 2);
+}
+
+void quaternionExtractMat4(benchmark::State& state) {
+    Bench::unary<Quaternion, Mat4>(state, Bench::randomQuaternion,
+            [](const Quaternion& quaternion) { return quaternion.extractMat4(); });
+}
+
+void quaternionExtractMat4Batch(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Quaternion> quaternions(Bench::randomArray<Quaternion>(size, Bench::randomQuaternion));
+    std::vector<Mat4> result(size);
+
+    for (auto _: state) {
+        Quaternion::extractMat4(quaternions.data(), result.data(), size);
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * (sizeof(Quaternion) + sizeof(Mat4)));
+}
+
+Mat4 randomRotation() {
+    return Bench::randomQuaternion().extractMat4();
+}
+
+void quaternionFromMat4(benchmark::State& state) {
+    Bench::unary<Mat4, Quaternion>(state, randomRotation,
+            [](const Mat4& matrix) { return Quaternion::fromMat4(matrix); });
+}
+
+void quaternionFromMat4Batch(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Mat4> matrices(Bench::randomArray<Mat4>(size, randomRotation));
+    std::vector<Quaternion> result(size);
+
+    for (auto _: state) {
+        Quaternion::fromMat4(matrices.data(), result.data(), size);
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * (sizeof(Mat4) + sizeof(Quaternion)));
+}
+
+void quaternionExtractEulerAngles(benchmark::State& state, Quaternion::Precision precision) {
+    Bench::unary<Quaternion, Vec3>(state, Bench::randomQuaternion, [precision](const Quaternion& quaternion) {
+        float xAngle, yAngle, zAngle;
+        quaternion.extractEulerAngles(xAngle, yAngle, zAngle, precision);
+        return Vec3(xAngle, yAngle, zAngle);
+    });
+}
+
+void quaternionExtractEulerAnglesBatch(benchmark::State& state, Quaternion::Precision precision) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Quaternion> quaternions(Bench::randomArray<Quaternion>(size, Bench::randomQuaternion));
+    std::vector<Vec3> angles(size);
+
+    for (auto _: state) {
+        Quaternion::extractEulerAngles(quaternions.data(), angles.data(), size, precision);
+        benchmark::DoNotOptimize(angles.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * (sizeof(Quaternion) + sizeof(Vec3)));
+}
+
+void quaternionRotate(benchmark::State& state) {
+    Quaternion quaternion(Bench::randomQuaternion());
+    Bench::unary<Vec3, Vec3>(state, Bench::randomVec3,
+            [&quaternion](const Vec3& vector) { return quaternion.rotate(vector); });
+}
+
+// Rotation through the matrix, the way it was done before rotate()
+void quaternionRotateMat4(benchmark::State& state) {
+    Quaternion quaternion(Bench::randomQuaternion());
+    Bench::unary<Vec3, Vec3>(state, Bench::randomVec3, [&quaternion](const Vec3& vector) {
+        return (quaternion.extractMat4() * Vec4(vector, 0.0f)).extractVec3();
+    });
+}
+
+void quaternionRotateBatch(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Vec3> vectors(Bench::randomArray<Vec3>(size, Bench::randomVec3));
+    std::vector<Vec3> result(size);
+    Quaternion quaternion(Bench::randomQuaternion());
+
+    for (auto _: state) {
+        quaternion.rotate(vectors.data(), result.data(), size);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * sizeof(Vec3) * 2);
+}
+
+void quaternionBlend(benchmark::State& state, Quaternion::Precision precision, bool spherical) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<Quaternion> from(Bench::randomArray<Quaternion>(size, Bench::randomQuaternion));
+    std::vector<Quaternion> to(Bench::randomArray<Quaternion>(size, Bench::randomQuaternion));
+    std::vector<float> factors(Bench::randomArray<float>(size, [] { return Bench::randomFloat() * 0.5f + 0.5f; }));
+    std::vector<Quaternion> result(size);
+
+    for (auto _: state) {
+        if (spherical) {
+            Quaternion::slerp(from.data(), to.data(), factors.data(), result.data(), size, precision);
+        } else {
+            Quaternion::nlerp(from.data(), to.data(), factors.data(), result.data(), size);
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+}  // namespace
+
+BENCHMARK(quaternionProduct)->Name("Quaternion/operator*")->MATH_BENCH_SIZES;
+BENCHMARK(quaternionProductLatency)->Name("Quaternion/operator*/latency");
+BENCHMARK(quaternionNormalize)->Name("Quaternion/normalize")->MATH_BENCH_SIZES;
+BENCHMARK(quaternionNormalizeFast)->Name("Quaternion/normalizeFast")->MATH_BENCH_SIZES;
+BENCHMARK(quaternionNormalizeFastBatch)->Name("Quaternion/normalizeFast/batch")->MATH_BENCH_SIZES;
+BENCHMARK(quaternionExtractMat4)->Name("Quaternion/extractMat4")->MATH_BENCH_SIZES;
+BENCHMARK(quaternionExtractMat4Batch)->Name("Quaternion/extractMat4/batch")->MATH_BENCH_SIZES;
+BENCHMARK(quaternionFromMat4)->Name("Quaternion/fromMat4")->MATH_BENCH_SIZES;
+BENCHMARK(quaternionFromMat4Batch)->Name("Quaternion/fromMat4/batch")->MATH_BENCH_SIZES;
+BENCHMARK_CAPTURE(quaternionExtractEulerAngles, exact, Quaternion::EXACT)
+        ->Name("Quaternion/extractEulerAngles")->MATH_BENCH_SIZES;
+BENCHMARK_CAPTURE(quaternionExtractEulerAngles, approximate, Quaternion::APPROXIMATE)
+        ->Name("Quaternion/extractEulerAngles/approximate")->MATH_BENCH_SIZES;
+BENCHMARK_CAPTURE(quaternionExtractEulerAnglesBatch, approximate, Quaternion::APPROXIMATE)
+        ->Name("Quaternion/extractEulerAngles/batch/approximate")->MATH_BENCH_SIZES;
+BENCHMARK(quaternionRotate)->Name("Quaternion/rotate")->MATH_BENCH_SIZES;
+BENCHMARK(quaternionRotateMat4)->Name("Quaternion/rotate/extractMat4")->MATH_BENCH_SIZES;
+BENCHMARK(quaternionRotateBatch)->Name("Quaternion/rotate/batch")->MATH_BENCH_SIZES;
+BENCHMARK_CAPTURE(quaternionBlend, exact, Quaternion::EXACT, true)
+        ->Name("Quaternion/slerp/batch")->MATH_BENCH_SIZES;
+BENCHMARK_CAPTURE(quaternionBlend, approximate, Quaternion::APPROXIMATE, true)
+        ->Name("Quaternion/slerp/batch/approximate")->MATH_BENCH_SIZES;
+BENCHMARK_CAPTURE(quaternionBlend, nlerp, Quaternion::EXACT, false)
+        ->Name("Quaternion/nlerp/batch")->MATH_BENCH_SIZES;
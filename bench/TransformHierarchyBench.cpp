@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <Bench.h>
+#include <TransformHierarchy.h>
+#include <cstddef>
+#include <random>
+
+using namespace Math;
+
+namespace {
+
+// Random forest with about eight children per node, most nodes are leaves
+TransformHierarchy randomHierarchy(std::size_t size) {
+    TransformHierarchy hierarchy;
+    hierarchy.reserve(size);
+
+    for (std::size_t i = 0; i < size; i++) {
+        std::size_t parent = TransformHierarchy::ROOT;
+        if (i >= 16) {
+            std::uniform_int_distribution<std::size_t> distribution(0, i / 8);
+            parent = distribution(Bench::generator());
+        }
+
+        hierarchy.add(parent, Bench::randomVec3(), Bench::randomQuaternion(), Vec3(1.0f, 1.0f, 1.0f));
+    }
+
+    hierarchy.update();
+    return hierarchy;
+}
+
+void hierarchyUpdate(benchmark::State& state, std::size_t dirtyPercent) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    TransformHierarchy hierarchy(randomHierarchy(size));
+    hierarchy.sortBreadthFirst();
+
+    std::uniform_int_distribution<std::size_t> distribution(0, size - 1);
+    std::size_t dirtyNodes = size * dirtyPercent / 100;
+    std::size_t updated = 0;
+
+    for (auto _: state) {
+        for (std::size_t i = 0; i < dirtyNodes; i++) {
+            std::size_t node = (dirtyNodes == size) ? i : distribution(Bench::generator());
+            hierarchy.setTranslation(node, hierarchy.getTranslation(node));
+        }
+
+        updated += hierarchy.update();
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["updated"] = benchmark::Counter(static_cast<double>(updated),
+            benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(hierarchyUpdate, dirty1, 1)->Name("TransformHierarchy/update/dirty1")->MATH_BENCH_SIZES;
+BENCHMARK_CAPTURE(hierarchyUpdate, dirty5, 5)->Name("TransformHierarchy/update/dirty5")->MATH_BENCH_SIZES;
+BENCHMARK_CAPTURE(hierarchyUpdate, full, 100)->Name("TransformHierarchy/update/full")->MATH_BENCH_SIZES;
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <Bench.h>
+#include <Vec3SoA.h>
+#include <Vec4SoA.h>
+
+using namespace Math;
+
+namespace {
+
+void vec3Sum(benchmark::State& state) {
+    Bench::binary<Vec3, Vec3>(state, Bench::randomVec3,
+            [](const Vec3& left, const Vec3& right) { return left + right; });
+}
+
+void vec3Difference(benchmark::State& state) {
+    Bench::binary<Vec3, Vec3>(state, Bench::randomVec3,
+            [](const Vec3& left, const Vec3& right) { return left - right; });
+}
+
+void vec3Scale(benchmark::State& state) {
+    Bench::unary<Vec3, Vec3>(state, Bench::randomVec3,
+            [](const Vec3& vector) { return vector * 2.0f; });
+}
+
+void vec3Dot(benchmark::State& state) {
+    Bench::binary<Vec3, float>(state, Bench::randomVec3,
+            [](const Vec3& left, const Vec3& right) { return left.dot(right); });
+}
+
+void vec3Cross(benchmark::State& state) {
+    Bench::binary<Vec3, Vec3>(state, Bench::randomVec3,
+            [](const Vec3& left, const Vec3& right) { return left.cross(right); });
+}
+
+void vec3Normalize(benchmark::State& state) {
+    Bench::unary<Vec3, Vec3>(state, Bench::randomVec3,
+            [](const Vec3& vector) { return Vec3(vector).normalize(); });
+}
+
+void vec3NormalizeFast(benchmark::State& state) {
+    Bench::unary<Vec3, Vec3>(state, Bench::randomVec3,
+            [](const Vec3& vector) { return Vec3(vector).normalizeFast(); });
+}
+
+void vec3Length(benchmark::State& state) {
+    Bench::unary<Vec3, float>(state, Bench::randomVec3,
+            [](const Vec3& vector) { return vector.length(); });
+}
+
+void vec3SumLatency(benchmark::State& state) {
+    Vec3 step(Bench::randomVec3());
+    Bench::chain(state, Vec3::ZERO, [&step](const Vec3& vector) { return vector + step; });
+}
+
+void vec3NormalizeLatency(benchmark::State& state) {
+    Bench::chain(state, Bench::randomVec3(), [](const Vec3& vector) { return Vec3(vector).normalize(); });
+}
+
+void vec3NormalizeFastLatency(benchmark::State& state) {
+    Bench::chain(state, Bench::randomVec3(), [](const Vec3& vector) { return Vec3(vector).normalizeFast(); });
+}
+
+void vec4Sum(benchmark::State& state) {
+    Bench::binary<Vec4, Vec4>(state, Bench::randomVec4,
+            [](const Vec4& left, const Vec4& right) { return left + right; });
+}
+
+void vec4Scale(benchmark::State& state) {
+    Bench::unary<Vec4, Vec4>(state, Bench::randomVec4,
+            [](const Vec4& vector) { return vector * 2.0f; });
+}
+
+void vec4Dot(benchmark::State& state) {
+    Bench::binary<Vec4, float>(state, Bench::randomVec4,
+            [](const Vec4& left, const Vec4& right) { return left.dot(right); });
+}
+
+void vec4Normalize(benchmark::State& state) {
+    Bench::unary<Vec4, Vec4>(state, Bench::randomVec4,
+            [](const Vec4& vector) { return Vec4(vector).normalize(); });
+}
+
+void vec4NormalizeFast(benchmark::State& state) {
+    Bench::unary<Vec4, Vec4>(state, Bench::randomVec4,
+            [](const Vec4& vector) { return Vec4(vector).normalizeFast(); });
+}
+
+Vec3SoA randomVec3SoA(std::size_t size) {
+    std::vector<Vec3> vectors(Bench::randomArray<Vec3>(size, Bench::randomVec3));
+    return Vec3SoA(vectors.data(), size);
+}
+
+Vec4SoA randomVec4SoA(std::size_t size) {
+    std::vector<Vec4> vectors(Bench::randomArray<Vec4>(size, Bench::randomVec4));
+    return Vec4SoA(vectors.data(), size);
+}
+
+void vec3SoASum(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    Vec3SoA left(randomVec3SoA(size));
+    Vec3SoA right(randomVec3SoA(size));
+
+    for (auto _: state) {
+        left += right;
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+void vec3SoADot(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    Vec3SoA left(randomVec3SoA(size));
+    Vec3SoA right(randomVec3SoA(size));
+    std::vector<float> result(size);
+
+    for (auto _: state) {
+        left.dot(right, result.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+void vec3SoACross(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    Vec3SoA left(randomVec3SoA(size));
+    Vec3SoA right(randomVec3SoA(size));
+    Vec3SoA result(size);
+
+    for (auto _: state) {
+        left.cross(right, result);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+void vec3SoANormalize(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    Vec3SoA vectors(randomVec3SoA(size));
+
+    for (auto _: state) {
+        vectors.normalize();
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+void vec3SoANormalizeFast(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    Vec3SoA vectors(randomVec3SoA(size));
+
+    for (auto _: state) {
+        vectors.normalizeFast();
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+void vec4SoADot(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    Vec4SoA left(randomVec4SoA(size));
+    Vec4SoA right(randomVec4SoA(size));
+    std::vector<float> result(size);
+
+    for (auto _: state) {
+        left.dot(right, result.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+void halfPack(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<float> source(Bench::randomArray<float>(size, Bench::randomFloat));
+    std::vector<Half> packed(size);
+
+    for (auto _: state) {
+        Half::pack(source.data(), packed.data(), size);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * (sizeof(float) + sizeof(Half)));
+}
+
+void halfUnpack(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<float> source(Bench::randomArray<float>(size, Bench::randomFloat));
+    std::vector<Half> packed(size);
+    Half::pack(source.data(), packed.data(), size);
+
+    for (auto _: state) {
+        Half::unpack(packed.data(), source.data(), size);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * (sizeof(float) + sizeof(Half)));
+}
+
+}  // namespace
+
+BENCHMARK(vec3Sum)->Name("Vec3/operator+")->MATH_BENCH_SIZES;
+BENCHMARK(vec3Difference)->Name("Vec3/operator-")->MATH_BENCH_SIZES;
+BENCHMARK(vec3Scale)->Name("Vec3/operator*")->MATH_BENCH_SIZES;
+BENCHMARK(vec3Dot)->Name("Vec3/dot")->MATH_BENCH_SIZES;
+BENCHMARK(vec3Cross)->Name("Vec3/cross")->MATH_BENCH_SIZES;
+BENCHMARK(vec3Normalize)->Name("Vec3/normalize")->MATH_BENCH_SIZES;
+BENCHMARK(vec3NormalizeFast)->Name("Vec3/normalizeFast")->MATH_BENCH_SIZES;
+BENCHMARK(vec3Length)->Name("Vec3/length")->MATH_BENCH_SIZES;
+BENCHMARK(vec3SumLatency)->Name("Vec3/operator+/latency");
+BENCHMARK(vec3NormalizeLatency)->Name("Vec3/normalize/latency");
+BENCHMARK(vec3NormalizeFastLatency)->Name("Vec3/normalizeFast/latency");
+
+BENCHMARK(vec4Sum)->Name("Vec4/operator+")->MATH_BENCH_SIZES;
+BENCHMARK(vec4Scale)->Name("Vec4/operator*")->MATH_BENCH_SIZES;
+BENCHMARK(vec4Dot)->Name("Vec4/dot")->MATH_BENCH_SIZES;
+BENCHMARK(vec4Normalize)->Name("Vec4/normalize")->MATH_BENCH_SIZES;
+BENCHMARK(vec4NormalizeFast)->Name("Vec4/normalizeFast")->MATH_BENCH_SIZES;
+
+BENCHMARK(vec3SoASum)->Name("Vec3SoA/operator+=")->MATH_BENCH_SIZES;
+BENCHMARK(vec3SoADot)->Name("Vec3SoA/dot")->MATH_BENCH_SIZES;
+BENCHMARK(vec3SoACross)->Name("Vec3SoA/cross")->MATH_BENCH_SIZES;
+BENCHMARK(vec3SoANormalize)->Name("Vec3SoA/normalize")->MATH_BENCH_SIZES;
+BENCHMARK(vec3SoANormalizeFast)->Name("Vec3SoA/normalizeFast")->MATH_BENCH_SIZES;
+BENCHMARK(vec4SoADot)->Name("Vec4SoA/dot")->MATH_BENCH_SIZES;
+
+BENCHMARK(halfPack)->Name("Half/pack")->MATH_BENCH_SIZES;
+BENCHMARK(halfUnpack)->Name("Half/unpack")->MATH_BENCH_SIZES;
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <Bench.h>
+#include <View.h>
+#include <cstddef>
+#include <vector>
+
+using namespace Math;
+
+namespace {
+
+// Interleaved vertex: position, normal and texture coordinates
+const std::size_t VERTEX_STRIDE = 8;
+
+std::vector<float> randomVertices(std::size_t size) {
+    return Bench::randomArray<float>(size * VERTEX_STRIDE, Bench::randomFloat);
+}
+
+void viewTransformPoints(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<float> vertices(randomVertices(size));
+    std::vector<float> result(vertices);
+    Mat4 matrix(Bench::randomRigid());
+
+    for (auto _: state) {
+        matrix.transformPoints(ConstVec3View(vertices.data(), size, VERTEX_STRIDE),
+                Vec3View(result.data(), size, VERTEX_STRIDE));
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Gathering positions into a Vec3 array and scattering them back, the way views replace
+void viewTransformPointsCopy(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<float> vertices(randomVertices(size));
+    std::vector<float> result(vertices);
+    std::vector<Vec3> points(size);
+    Mat4 matrix(Bench::randomRigid());
+
+    for (auto _: state) {
+        for (std::size_t i = 0; i < size; i++) {
+            const float* vertex = vertices.data() + i * VERTEX_STRIDE;
+            points[i] = Vec3(vertex[0], vertex[1], vertex[2]);
+        }
+
+        matrix.transformPoints(points.data(), points.data(), size);
+
+        for (std::size_t i = 0; i < size; i++) {
+            float* vertex = result.data() + i * VERTEX_STRIDE;
+            vertex[0] = points[i].get(Vec3::X);
+            vertex[1] = points[i].get(Vec3::Y);
+            vertex[2] = points[i].get(Vec3::Z);
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+}  // namespace
+
+BENCHMARK(viewTransformPoints)->Name("View/transformPoints")->MATH_BENCH_SIZES;
+BENCHMARK(viewTransformPointsCopy)->Name("View/transformPoints/copy")->MATH_BENCH_SIZES;
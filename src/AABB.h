@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef AABB_H
+#define AABB_H
+
+#include <Vec3.h>
+
+namespace Math {
+
+/*!
+ * \brief Axis aligned bounding box.
+ * \details AABB is stored as its minimum and maximum corners.
+ */
+class AABB {
+public:
+    /*!
+     * \brief Default constructor.
+     * \details Constructs zero size box at the origin.
+     */
+    constexpr AABB();
+
+    /*!
+     * \brief Corners constructor.
+     * \param minimum Minimum corner.
+     * \param maximum Maximum corner.
+     * \note Corners are expected to be ordered per component, no check is performed.
+     */
+    constexpr AABB(const Vec3& minimum, const Vec3& maximum);
+
+    /*!
+     * \brief Boxes equalty check.
+     * \param box Compared box.
+     * \return true if boxes are equal, false otherwise.
+     */
+    constexpr bool operator ==(const AABB& box) const;
+
+    /*!
+     * \brief Boxes inequalty check.
+     * \param box Compared box.
+     * \return false if boxes are equal, true otherwise.
+     */
+    constexpr bool operator !=(const AABB& box) const;
+
+    /*!
+     * \brief Point containment check.
+     * \param point Tested point.
+     * \return true if the point is inside the box or on its boundary, false otherwise.
+     */
+    constexpr bool contains(const Vec3& point) const;
+
+    /*!
+     * \brief Boxes overlap check.
+     * \param box Tested box.
+     * \return true if boxes overlap or touch, false otherwise.
+     */
+    constexpr bool intersects(const AABB& box) const;
+
+    /*!
+     * \brief Minimum corner selector.
+     * \return Minimum corner.
+     */
+    constexpr const Vec3& getMin() const;
+
+    /*!
+     * \brief Maximum corner selector.
+     * \return Maximum corner.
+     */
+    constexpr const Vec3& getMax() const;
+
+    /*!
+     * \brief Box center calculation.
+     * \return Box center.
+     */
+    constexpr Vec3 getCenter() const;
+
+    /*!
+     * \brief Box extent calculation.
+     * \return Half of the box size along each axis.
+     */
+    constexpr Vec3 getExtent() const;
+
+private:
+    Vec3 minimum;
+    Vec3 maximum;
+};
+
+constexpr AABB::AABB():
+        minimum(),
+        maximum() {
+}
+
+constexpr AABB::AABB(const Vec3& minimum, const Vec3& maximum):
+        minimum(minimum),
+        maximum(maximum) {
+}
+
+constexpr bool AABB::operator ==(const AABB& box) const {
+    return (this->minimum == box.getMin()) && (this->maximum == box.getMax());
+}
+
+constexpr bool AABB::operator !=(const AABB& box) const {
+    return !(*this == box);
+}
+
+constexpr bool AABB::contains(const Vec3& point) const {
+    for (int i = Vec3::X; i <= Vec3::Z; i++) {
+        if (point.get(i) < this->minimum.get(i) || point.get(i) > this->maximum.get(i)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+constexpr bool AABB::intersects(const AABB& box) const {
+    for (int i = Vec3::X; i <= Vec3::Z; i++) {
+        if (box.getMax().get(i) < this->minimum.get(i) || box.getMin().get(i) > this->maximum.get(i)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+constexpr const Vec3& AABB::getMin() const {
+    return this->minimum;
+}
+
+constexpr const Vec3& AABB::getMax() const {
+    return this->maximum;
+}
+
+constexpr Vec3 AABB::getCenter() const {
+    return (this->minimum + this->maximum) * 0.5f;
+}
+
+constexpr Vec3 AABB::getExtent() const {
+    return (this->maximum - this->minimum) * 0.5f;
+}
+
+}  // namespace Math
+
+#endif  // AABB_H
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ALIGNED_H
+#define ALIGNED_H
+
+#include <Vec3.h>
+#include <Vec4.h>
+#include <Mat4.h>
+#include <Quaternion.h>
+
+namespace Math {
+
+/*!
+ * \brief 16 byte aligned three component vector.
+ * \details Vec3A is a Vec3 padded to 16 bytes, so arrays of it never straddle a
+ *          cache line and every element starts at a SIMD register boundary.
+ *          It converts to and from Vec3 implicitly, operators return Vec3.
+ */
+class alignas(16) Vec3A: public Vec3 {
+public:
+    using Vec3::Vec3;
+
+    /*!
+     * \brief Default constructor.
+     * \details Constructs zero-length vector.
+     */
+    constexpr Vec3A() noexcept = default;
+
+    /*!
+     * \brief Vec3 conversion constructor.
+     * \param vector Source vector.
+     */
+    constexpr Vec3A(const Vec3& vector) noexcept;
+};
+
+/*!
+ * \brief 16 byte aligned four component vector.
+ * \details Vec4A is a Vec4 aligned to a SIMD register boundary.
+ *          It converts to and from Vec4 implicitly, operators return Vec4.
+ */
+class alignas(16) Vec4A: public Vec4 {
+public:
+    using Vec4::Vec4;
+
+    /*!
+     * \brief Default constructor.
+     * \details Constructs zero-length vector with W = 1.
+     */
+    constexpr Vec4A() noexcept = default;
+
+    /*!
+     * \brief Vec4 conversion constructor.
+     * \param vector Source vector.
+     */
+    constexpr Vec4A(const Vec4& vector) noexcept;
+};
+
+/*!
+ * \brief 16 byte aligned quaternion.
+ * \details QuaternionA is a Quaternion aligned to a SIMD register boundary.
+ *          It converts to and from Quaternion implicitly, operators return Quaternion.
+ */
+class alignas(16) QuaternionA: public Quaternion {
+public:
+    using Quaternion::Quaternion;
+
+    /*!
+     * \brief Default constructor.
+     * \details Constructs identity quaternion.
+     */
+    constexpr QuaternionA() noexcept = default;
+
+    /*!
+     * \brief Quaternion conversion constructor.
+     * \param quaternion Source quaternion.
+     */
+    constexpr QuaternionA(const Quaternion& quaternion) noexcept;
+};
+
+/*!
+ * \brief Cache line aligned 4x4 matrix.
+ * \details Mat4A is a Mat4 occupying exactly one 64 byte cache line.
+ *          It converts to and from Mat4 implicitly, operators return Mat4.
+ */
+class alignas(64) Mat4A: public Mat4 {
+public:
+    using Mat4::Mat4;
+
+    /*!
+     * \brief Default constructor.
+     * \details Constructs identity matrix.
+     */
+    constexpr Mat4A() noexcept = default;
+
+    /*!
+     * \brief Mat4 conversion constructor.
+     * \param matrix Source matrix.
+     */
+    constexpr Mat4A(const Mat4& matrix) noexcept;
+};
+
+static_assert(sizeof(Vec3A) == 16 && alignof(Vec3A) == 16, "Vec3A should be padded to 16 bytes");
+static_assert(sizeof(Vec4A) == 16 && alignof(Vec4A) == 16, "Vec4A should take 16 bytes");
+static_assert(sizeof(QuaternionA) == 16 && alignof(QuaternionA) == 16, "QuaternionA should take 16 bytes");
+static_assert(sizeof(Mat4A) == 64 && alignof(Mat4A) == 64, "Mat4A should take one cache line");
+
+constexpr Vec3A::Vec3A(const Vec3& vector) noexcept:
+        Vec3(vector) {
+}
+
+constexpr Vec4A::Vec4A(const Vec4& vector) noexcept:
+        Vec4(vector) {
+}
+
+constexpr QuaternionA::QuaternionA(const Quaternion& quaternion) noexcept:
+        Quaternion(quaternion) {
+}
+
+constexpr Mat4A::Mat4A(const Mat4& matrix) noexcept:
+        Mat4(matrix) {
+}
+
+}  // namespace Math
+
+#endif  // ALIGNED_H
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ALIGNEDALLOCATOR_H
+#define ALIGNEDALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+
+namespace Math {
+
+/*!
+ * \brief Standard allocator of over-aligned heap memory.
+ * \details Places container storage at an Alignment byte boundary, by default at
+ *          a cache line, so std::vector<Mat4, AlignedAllocator<Mat4>> never splits
+ *          a matrix between two lines and SIMD kernels read aligned rows.
+ * \note Alignment should be a power of 2.
+ */
+template<typename T, std::size_t Alignment = 64>
+class AlignedAllocator {
+public:
+    static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0,
+            "Alignment should be a power of 2 not weaker than alignof(T)");
+
+    typedef T value_type;  /*!< Allocated type. */
+
+    /*!
+     * \brief Rebinding helper.
+     */
+    template<typename U>
+    struct rebind {
+        typedef AlignedAllocator<U, Alignment> other;  /*!< Allocator of U. */
+    };
+
+    /*!
+     * \brief Default constructor.
+     */
+    constexpr AlignedAllocator() = default;
+
+    /*!
+     * \brief Rebinding constructor.
+     */
+    template<typename U>
+    constexpr AlignedAllocator(const AlignedAllocator<U, Alignment>& /* allocator */) {
+    }
+
+    /*!
+     * \brief Memory allocation.
+     * \param count Number of objects.
+     * \return Pointer to uninitialized memory.
+     */
+    T* allocate(std::size_t count) {
+        return static_cast<T*>(operator new(count * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    /*!
+     * \brief Memory deallocation.
+     * \param pointer Memory got from allocate().
+     */
+    void deallocate(T* pointer, std::size_t /* count */) {
+        operator delete(pointer, std::align_val_t(Alignment));
+    }
+};
+
+/*!
+ * \brief Allocators equality check.
+ * \return true, memory of any AlignedAllocator can be released by another one.
+ */
+template<typename T, typename U, std::size_t Alignment>
+constexpr bool operator ==(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) {
+    return true;
+}
+
+/*!
+ * \brief Allocators inequality check.
+ * \return false, memory of any AlignedAllocator can be released by another one.
+ */
+template<typename T, typename U, std::size_t Alignment>
+constexpr bool operator !=(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) {
+    return false;
+}
+
+}  // namespace Math
+
+#endif  // ALIGNEDALLOCATOR_H
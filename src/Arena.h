@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <MathApi.h>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace Math {
+
+/*!
+ * \brief Linear arena for bulk arrays.
+ * \details Arena owns a single cache line aligned block and hands out consecutive
+ *          pieces of it. Allocations are never freed one by one, reset() rewinds the
+ *          whole arena instead, so per-frame buffers are carved from memory allocated
+ *          once. Arena is not thread safe.
+ */
+class Arena {
+public:
+    enum {
+        Alignment = 64  /*!< Block and default allocation alignment. */
+    };
+
+    /*!
+     * \brief Capacity constructor.
+     * \param capacity Block size in bytes.
+     */
+    MATH_API explicit Arena(std::size_t capacity);
+
+    /*!
+     * \brief Destructor.
+     * \details Releases the block, objects allocated from the arena are not destroyed.
+     */
+    MATH_API ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator =(const Arena&) = delete;
+
+    /*!
+     * \brief Raw memory allocation.
+     * \param size Requested size in bytes.
+     * \param alignment Requested alignment, must be a power of 2 not exceeding #Alignment.
+     * \return Pointer to uninitialized memory, nullptr if the arena is exhausted.
+     */
+    MATH_API void* allocate(std::size_t size, std::size_t alignment = Alignment);
+
+    /*!
+     * \brief Array allocation.
+     * \details Default constructs count objects starting at a cache line boundary.
+     * \param count Number of objects.
+     * \return Pointer to the first object, nullptr if the arena is exhausted.
+     * \note T should be trivially destructible, its destructor is never called.
+     */
+    template<typename T>
+    T* allocate(std::size_t count);
+
+    /*!
+     * \brief Arena rewinding.
+     * \details Makes the whole block available again, previous allocations become invalid.
+     */
+    MATH_API void reset();
+
+    /*!
+     * \brief Arena's used size selector.
+     * \return Number of bytes allocated since construction or the last reset().
+     */
+    MATH_API std::size_t size() const;
+
+    /*!
+     * \brief Arena's capacity selector.
+     * \return Block size in bytes.
+     */
+    MATH_API std::size_t capacity() const;
+
+private:
+    unsigned char* storage;
+    std::size_t offset;
+    std::size_t limit;
+};
+
+/*!
+ * \brief Standard allocator drawing from an Arena.
+ * \details Lets standard containers keep their elements in an arena, every allocation
+ *          starts at a cache line boundary. Deallocation is a no-op, memory comes back
+ *          with Arena::reset().
+ * \note Exhausted arena makes allocate() throw std::bad_alloc as the standard requires.
+ */
+template<typename T>
+class ArenaAllocator {
+public:
+    typedef T value_type;  /*!< Allocated type. */
+
+    /*!
+     * \brief Arena constructor.
+     * \param arena Arena to allocate from, must outlive the allocator and its copies.
+     */
+    explicit ArenaAllocator(Arena& arena);
+
+    /*!
+     * \brief Rebinding constructor.
+     * \param allocator Allocator of another type drawing from the same arena.
+     */
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& allocator);
+
+    /*!
+     * \brief Memory allocation.
+     * \param count Number of objects.
+     * \return Pointer to uninitialized memory.
+     */
+    T* allocate(std::size_t count);
+
+    /*!
+     * \brief Memory deallocation.
+     * \details Does nothing, memory is reclaimed by Arena::reset().
+     */
+    void deallocate(T* pointer, std::size_t count);
+
+    /*!
+     * \brief Arena selector.
+     * \return Arena the allocator draws from.
+     */
+    Arena& getArena() const;
+
+private:
+    Arena* arena;
+};
+
+template<typename T>
+T* Arena::allocate(std::size_t count) {
+    static_assert(std::is_trivially_destructible<T>::value, "Arena never calls destructors");
+    static_assert(alignof(T) <= Alignment, "Arena block alignment is exceeded");
+
+    void* memory = this->allocate(count * sizeof(T), Alignment);
+    if (memory == nullptr) {
+        return nullptr;
+    }
+
+    T* objects = static_cast<T*>(memory);
+    for (std::size_t i = 0; i < count; i++) {
+        new (objects + i) T();
+    }
+
+    return objects;
+}
+
+template<typename T>
+ArenaAllocator<T>::ArenaAllocator(Arena& arena):
+        arena(&arena) {
+}
+
+template<typename T>
+template<typename U>
+ArenaAllocator<T>::ArenaAllocator(const ArenaAllocator<U>& allocator):
+        arena(&allocator.getArena()) {
+}
+
+template<typename T>
+T* ArenaAllocator<T>::allocate(std::size_t count) {
+    static_assert(alignof(T) <= Arena::Alignment, "Arena block alignment is exceeded");
+
+    void* memory = this->arena->allocate(count * sizeof(T), Arena::Alignment);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return static_cast<T*>(memory);
+}
+
+template<typename T>
+void ArenaAllocator<T>::deallocate(T* /* pointer */, std::size_t /* count */) {
+}
+
+template<typename T>
+Arena& ArenaAllocator<T>::getArena() const {
+    return *this->arena;
+}
+
+/*!
+ * \brief Allocators equality check.
+ * \return true if both allocators draw from the same arena, false otherwise.
+ */
+template<typename T, typename U>
+bool operator ==(const ArenaAllocator<T>& left, const ArenaAllocator<U>& right) {
+    return &left.getArena() == &right.getArena();
+}
+
+/*!
+ * \brief Allocators inequality check.
+ * \return false if both allocators draw from the same arena, true otherwise.
+ */
+template<typename T, typename U>
+bool operator !=(const ArenaAllocator<T>& left, const ArenaAllocator<U>& right) {
+    return !(left == right);
+}
+
+}  // namespace Math
+
+#ifdef MATH_HEADER_ONLY
+#include <Arena.inl>
+#endif
+
+#endif  // ARENA_H
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ARENA_INL
+#define ARENA_INL
+
+#include <Arena.h>
+#include <cassert>
+#include <new>
+
+namespace Math {
+
+MATH_INLINE Arena::Arena(std::size_t capacity):
+        storage(static_cast<unsigned char*>(operator new(capacity, std::align_val_t(Alignment)))),
+        offset(0),
+        limit(capacity) {
+}
+
+MATH_INLINE Arena::~Arena() {
+    operator delete(this->storage, std::align_val_t(Alignment));
+}
+
+MATH_INLINE void* Arena::allocate(std::size_t size, std::size_t alignment) {
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0 && alignment <= Alignment);
+    std::size_t start = (this->offset + alignment - 1) & ~(alignment - 1);
+
+    if (start > this->limit || size > this->limit - start) {
+        return nullptr;
+    }
+
+    this->offset = start + size;
+    return this->storage + start;
+}
+
+MATH_INLINE void Arena::reset() {
+    this->offset = 0;
+}
+
+MATH_INLINE std::size_t Arena::size() const {
+    return this->offset;
+}
+
+MATH_INLINE std::size_t Arena::capacity() const {
+    return this->limit;
+}
+
+}  // namespace Math
+
+#endif  // ARENA_INL
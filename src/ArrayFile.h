@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ARRAYFILE_H
+#define ARRAYFILE_H
+
+#include <MathApi.h>
+#include <View.h>
+#include <cassert>
+#include <cstddef>
+
+namespace Math {
+
+class Vec3;
+class Vec4;
+class Mat3;
+class Mat4;
+class Quaternion;
+
+/*!
+ * \brief Memory mapped binary container of math arrays.
+ * \details ArrayFile stores one array of Vec3, Vec4, Mat3, Mat4 or Quaternion
+ *          elements as a 64 byte header followed by the raw element payload. Header
+ *          fields are little-endian:
+ *          * 8 bytes magic "MATHARR\0";
+ *          * 4 bytes format version, 4 bytes ElementType, 4 bytes element size,
+ *            4 bytes reserved;
+ *          * 8 bytes element count, 8 bytes payload offset.
+ *
+ *          Payload starts 64 byte aligned and holds elements exactly as they are laid
+ *          out in memory, so open() maps the file read-only and data() or view()
+ *          hand it to the batch APIs in place, nothing is parsed or copied. Payload
+ *          floats are little-endian, big-endian hosts are rejected.
+ */
+class ArrayFile {
+public:
+    enum {
+        Version = 1,     /*!< Current format version. */
+        HeaderSize = 64  /*!< Header size and payload alignment in bytes. */
+    };
+
+    enum ElementType {
+        NONE = 0,       /*!< No file is open. */
+        VEC3 = 1,       /*!< Vec3 elements. */
+        VEC4 = 2,       /*!< Vec4 elements. */
+        MAT3 = 3,       /*!< Mat3 elements. */
+        MAT4 = 4,       /*!< Mat4 elements. */
+        QUATERNION = 5  /*!< Quaternion elements. */
+    };
+
+    /*!
+     * \brief Default constructor.
+     * \details Constructs a closed file.
+     */
+    MATH_API ArrayFile();
+
+    /*!
+     * \brief Move constructor.
+     * \param file Moved file, becomes closed.
+     */
+    MATH_API ArrayFile(ArrayFile&& file);
+
+    /*!
+     * \brief Destructor.
+     * \details Unmaps the file, pointers got from data() become invalid.
+     */
+    MATH_API ~ArrayFile();
+
+    ArrayFile(const ArrayFile&) = delete;
+    ArrayFile& operator =(const ArrayFile&) = delete;
+
+    /*!
+     * \brief Move assignment.
+     * \param file Moved file, becomes closed.
+     * \return Reference to the file.
+     */
+    MATH_API ArrayFile& operator =(ArrayFile&& file);
+
+    /*!
+     * \brief File mapping.
+     * \details Maps the whole file read-only and validates its header against the
+     *          file size. Previously opened file is closed first.
+     * \param path File path.
+     * \return true if the file is mapped, false if it cannot be mapped or is malformed.
+     */
+    MATH_API bool open(const char* path);
+
+    /*!
+     * \brief File unmapping.
+     */
+    MATH_API void close();
+
+    /*!
+     * \brief Mapping state selector.
+     * \return true if a file is mapped, false otherwise.
+     */
+    MATH_API bool isOpen() const;
+
+    /*!
+     * \brief Element type selector.
+     * \return Type of stored elements, NONE if no file is open.
+     */
+    MATH_API ElementType getType() const;
+
+    /*!
+     * \brief Array size selector.
+     * \return Number of stored elements.
+     */
+    MATH_API std::size_t size() const;
+
+    /*!
+     * \brief Payload accessor.
+     * \return Pointer to the mapped payload, nullptr if no file is open.
+     */
+    MATH_API const void* getPayload() const;
+
+    /*!
+     * \brief Typed payload accessor.
+     * \return Pointer to size() mapped elements.
+     * \note There is an assert for T to match getType().
+     */
+    template<typename T>
+    const T* data() const;
+
+    /*!
+     * \brief Payload view.
+     * \return Read-only view over size() mapped elements, e.g. for Mat4::transformPoints().
+     * \note There is an assert for T to match getType().
+     */
+    template<typename T>
+    View<T, const float> view() const;
+
+    /*!
+     * \brief Array writer.
+     * \param path File path, existing file is replaced.
+     * \param elements Stored elements.
+     * \param count Number of elements.
+     * \return true if the file is written, false otherwise.
+     */
+    template<typename T>
+    static bool write(const char* path, const T* elements, std::size_t count);
+
+    /*!
+     * \brief Untyped array writer.
+     * \param path File path, existing file is replaced.
+     * \param type Type of stored elements.
+     * \param elements Stored elements.
+     * \param count Number of elements.
+     * \return true if the file is written, false otherwise.
+     * \note There is an assert for type not to be NONE.
+     */
+    MATH_API static bool write(const char* path, ElementType type, const void* elements, std::size_t count);
+
+    /*!
+     * \brief Element size selector.
+     * \param type Element type.
+     * \return Size of one element in bytes, 0 for NONE.
+     */
+    MATH_API static std::size_t getElementSize(ElementType type);
+
+private:
+    template<typename T>
+    struct Element;
+
+    static bool isLittleEndian();
+
+    const unsigned char* mapping;
+    std::size_t mappingSize;
+    const unsigned char* payload;
+    ElementType type;
+    std::size_t count;
+};
+
+template<>
+struct ArrayFile::Element<Vec3> {
+    static constexpr ElementType TYPE = VEC3;
+};
+
+template<>
+struct ArrayFile::Element<Vec4> {
+    static constexpr ElementType TYPE = VEC4;
+};
+
+template<>
+struct ArrayFile::Element<Mat3> {
+    static constexpr ElementType TYPE = MAT3;
+};
+
+template<>
+struct ArrayFile::Element<Mat4> {
+    static constexpr ElementType TYPE = MAT4;
+};
+
+template<>
+struct ArrayFile::Element<Quaternion> {
+    static constexpr ElementType TYPE = QUATERNION;
+};
+
+template<typename T>
+const T* ArrayFile::data() const {
+    assert(this->type == Element<T>::TYPE);
+    return static_cast<const T*>(this->getPayload());
+}
+
+template<typename T>
+View<T, const float> ArrayFile::view() const {
+    assert(this->type == Element<T>::TYPE);
+    return View<T, const float>(static_cast<const float*>(this->getPayload()), this->count);
+}
+
+template<typename T>
+bool ArrayFile::write(const char* path, const T* elements, std::size_t count) {
+    return ArrayFile::write(path, Element<T>::TYPE, elements, count);
+}
+
+}  // namespace Math
+
+#ifdef MATH_HEADER_ONLY
+#include <ArrayFile.inl>
+#endif
+
+#endif  // ARRAYFILE_H
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ARRAYFILE_INL
+#define ARRAYFILE_INL
+
+#include <ArrayFile.h>
+#include <Vec3.h>
+#include <Vec4.h>
+#include <Mat3.h>
+#include <Mat4.h>
+#include <Quaternion.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Math {
+
+MATH_INLINE ArrayFile::ArrayFile():
+        mapping(nullptr),
+        mappingSize(0),
+        payload(nullptr),
+        type(NONE),
+        count(0) {
+}
+
+MATH_INLINE ArrayFile::ArrayFile(ArrayFile&& file):
+        mapping(file.mapping),
+        mappingSize(file.mappingSize),
+        payload(file.payload),
+        type(file.type),
+        count(file.count) {
+    file.mapping = nullptr;
+    file.mappingSize = 0;
+    file.payload = nullptr;
+    file.type = NONE;
+    file.count = 0;
+}
+
+MATH_INLINE ArrayFile::~ArrayFile() {
+    this->close();
+}
+
+MATH_INLINE ArrayFile& ArrayFile::operator =(ArrayFile&& file) {
+    if (this != &file) {
+        this->close();
+
+        this->mapping = file.mapping;
+        this->mappingSize = file.mappingSize;
+        this->payload = file.payload;
+        this->type = file.type;
+        this->count = file.count;
+
+        file.mapping = nullptr;
+        file.mappingSize = 0;
+        file.payload = nullptr;
+        file.type = NONE;
+        file.count = 0;
+    }
+
+    return *this;
+}
+
+MATH_INLINE bool ArrayFile::open(const char* path) {
+    this->close();
+
+    if (!ArrayFile::isLittleEndian()) {
+        return false;
+    }
+
+    // Handles are not needed once the view is mapped
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || static_cast<unsigned long long>(fileSize.QuadPart) < HeaderSize ||
+            static_cast<unsigned long long>(fileSize.QuadPart) > SIZE_MAX) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE fileMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (fileMapping == nullptr) {
+        return false;
+    }
+
+    const void* view = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(fileMapping);
+    if (view == nullptr) {
+        return false;
+    }
+
+    this->mapping = static_cast<const unsigned char*>(view);
+    this->mappingSize = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    int file = ::open(path, O_RDONLY);
+    if (file < 0) {
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(file, &status) != 0 || status.st_size < HeaderSize) {
+        ::close(file);
+        return false;
+    }
+
+    std::size_t fileSize = static_cast<std::size_t>(status.st_size);
+    void* view = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+
+    this->mapping = static_cast<const unsigned char*>(view);
+    this->mappingSize = fileSize;
+#endif
+
+    const unsigned char* header = this->mapping;
+    std::uint32_t version;
+    std::uint32_t elementType;
+    std::uint32_t elementSize;
+    std::uint64_t elementCount;
+    std::uint64_t payloadOffset;
+
+    std::memcpy(&version, header + 8, sizeof(version));
+    std::memcpy(&elementType, header + 12, sizeof(elementType));
+    std::memcpy(&elementSize, header + 16, sizeof(elementSize));
+    std::memcpy(&elementCount, header + 24, sizeof(elementCount));
+    std::memcpy(&payloadOffset, header + 32, sizeof(payloadOffset));
+
+    bool valid = std::memcmp(header, "MATHARR", 8) == 0 && version == Version &&
+            elementType > NONE && elementType <= QUATERNION &&
+            elementSize == ArrayFile::getElementSize(static_cast<ElementType>(elementType)) &&
+            payloadOffset >= HeaderSize && payloadOffset % HeaderSize == 0 && payloadOffset <= this->mappingSize &&
+            elementCount <= (this->mappingSize - payloadOffset) / elementSize;
+
+    if (!valid) {
+        this->close();
+        return false;
+    }
+
+    this->payload = this->mapping + payloadOffset;
+    this->type = static_cast<ElementType>(elementType);
+    this->count = static_cast<std::size_t>(elementCount);
+
+    return true;
+}
+
+MATH_INLINE void ArrayFile::close() {
+    if (this->mapping == nullptr) {
+        return;
+    }
+
+#if defined(_WIN32)
+    UnmapViewOfFile(this->mapping);
+#else
+    munmap(const_cast<unsigned char*>(this->mapping), this->mappingSize);
+#endif
+
+    this->mapping = nullptr;
+    this->mappingSize = 0;
+    this->payload = nullptr;
+    this->type = NONE;
+    this->count = 0;
+}
+
+MATH_INLINE bool ArrayFile::isOpen() const {
+    return this->mapping != nullptr;
+}
+
+MATH_INLINE ArrayFile::ElementType ArrayFile::getType() const {
+    return this->type;
+}
+
+MATH_INLINE std::size_t ArrayFile::size() const {
+    return this->count;
+}
+
+MATH_INLINE const void* ArrayFile::getPayload() const {
+    return this->payload;
+}
+
+MATH_INLINE bool ArrayFile::write(const char* path, ElementType type, const void* elements, std::size_t count) {
+    assert(type != NONE);
+
+    if (!ArrayFile::isLittleEndian()) {
+        return false;
+    }
+
+    unsigned char header[HeaderSize] = {};
+    std::uint32_t version = Version;
+    std::uint32_t elementType = type;
+    std::uint32_t elementSize = static_cast<std::uint32_t>(ArrayFile::getElementSize(type));
+    std::uint64_t elementCount = count;
+    std::uint64_t payloadOffset = HeaderSize;
+
+    std::memcpy(header, "MATHARR", 8);
+    std::memcpy(header + 8, &version, sizeof(version));
+    std::memcpy(header + 12, &elementType, sizeof(elementType));
+    std::memcpy(header + 16, &elementSize, sizeof(elementSize));
+    std::memcpy(header + 24, &elementCount, sizeof(elementCount));
+    std::memcpy(header + 32, &payloadOffset, sizeof(payloadOffset));
+
+    std::FILE* file = std::fopen(path, "wb");
+    if (file == nullptr) {
+        return false;
+    }
+
+    std::size_t payloadSize = count * elementSize;
+    bool written = std::fwrite(header, 1, sizeof(header), file) == sizeof(header) &&
+            (payloadSize == 0 || std::fwrite(elements, 1, payloadSize, file) == payloadSize);
+
+    return (std::fclose(file) == 0) && written;
+}
+
+MATH_INLINE std::size_t ArrayFile::getElementSize(ElementType type) {
+    switch (type) {
+        case VEC3:
+            return sizeof(Vec3);
+        case VEC4:
+            return sizeof(Vec4);
+        case MAT3:
+            return sizeof(Mat3);
+        case MAT4:
+            return sizeof(Mat4);
+        case QUATERNION:
+            return sizeof(Quaternion);
+        default:
+            return 0;
+    }
+}
+
+MATH_INLINE bool ArrayFile::isLittleEndian() {
+    std::uint32_t value = 1;
+    unsigned char bytes[sizeof(value)];
+    std::memcpy(bytes, &value, sizeof(value));
+    return bytes[0] == 1;
+}
+
+}  // namespace Math
+
+#endif  // ARRAYFILE_INL
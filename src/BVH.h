@@ -0,0 +1,498 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BVH_H
+#define BVH_H
+
+#include <MathApi.h>
+#include <MathSimd.h>
+#include <AABB.h>
+#include <Vec3.h>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Math {
+
+class Executor;
+
+/*!
+ * \brief Bounding volume hierarchy.
+ * \details BVH is built over primitive boxes (or points) with a binned surface area
+ *          heuristic and flattened into 4 wide nodes, children bounds of a node are
+ *          stored per component so that a single SIMD test covers all of them.
+ *          Queries return indices into the arrays the hierarchy was built from.
+ *          Intersect, distance and visitor callbacks refine box tests for custom
+ *          primitives such as triangles.
+ */
+class BVH {
+public:
+    static constexpr std::size_t NONE = static_cast<std::size_t>(-1);  /*!< No primitive. */
+    static constexpr std::size_t MAX_LEAF_SIZE = 4;                     /*!< Primitives per leaf. */
+
+    /*!
+     * \brief Default constructor.
+     * \details Constructs empty hierarchy.
+     */
+    MATH_API BVH();
+
+    /*!
+     * \brief Build over boxes.
+     * \param boxes Primitive bounds.
+     * \param count Number of primitives.
+     * \note There is an assert for count fitting 32 bits.
+     */
+    MATH_API void build(const AABB* boxes, std::size_t count);
+
+    /*!
+     * \brief Parallel build over boxes.
+     * \details Top levels are split on the calling thread, subtrees are built as
+     *          independent Executor tasks. Result is the same as the serial build.
+     * \param executor Executor running the subtrees.
+     * \param boxes Primitive bounds.
+     * \param count Number of primitives.
+     * \note There is an assert for count fitting 32 bits.
+     */
+    MATH_API void build(Executor& executor, const AABB* boxes, std::size_t count);
+
+    /*!
+     * \brief Build over points.
+     * \param points Primitive positions, degenerate boxes.
+     * \param count Number of points.
+     * \note There is an assert for count fitting 32 bits.
+     */
+    MATH_API void build(const Vec3* points, std::size_t count);
+
+    /*!
+     * \brief Parallel build over points.
+     * \param executor Executor running the subtrees.
+     * \param points Primitive positions, degenerate boxes.
+     * \param count Number of points.
+     * \note There is an assert for count fitting 32 bits.
+     */
+    MATH_API void build(Executor& executor, const Vec3* points, std::size_t count);
+
+    /*!
+     * \brief Closest primitive box hit by a ray.
+     * \param origin Ray origin.
+     * \param direction Ray direction, distances are measured in its lengths.
+     * \param distance Maximum distance on input, hit distance on output.
+     * \return Hit primitive, #NONE if nothing is hit within the distance.
+     */
+    MATH_API std::size_t raycast(const Vec3& origin, const Vec3& direction, float& distance) const;
+
+    /*!
+     * \brief Closest primitive hit by a ray.
+     * \param origin Ray origin.
+     * \param direction Ray direction, distances are measured in its lengths.
+     * \param distance Maximum distance on input, hit distance on output.
+     * \param intersect Called as bool(std::size_t primitive, float& distance) for
+     *        primitives whose box is hit closer than distance, returns true and
+     *        lowers distance if the primitive is hit closer.
+     * \return Hit primitive, #NONE if nothing is hit within the distance.
+     */
+    template<typename Intersect>
+    std::size_t raycast(const Vec3& origin, const Vec3& direction, float& distance, Intersect intersect) const;
+
+    /*!
+     * \brief Closest primitive box to a point.
+     * \details Exact nearest neighbour for hierarchies built over points.
+     * \param point Query point.
+     * \param squareDistance Maximum square distance on input, square distance to
+     *        the closest box on output.
+     * \return Closest primitive, #NONE if none is closer than the distance.
+     */
+    MATH_API std::size_t nearest(const Vec3& point, float& squareDistance) const;
+
+    /*!
+     * \brief Closest primitive to a point.
+     * \param point Query point.
+     * \param squareDistance Maximum square distance on input, square distance to
+     *        the closest primitive on output.
+     * \param distance Called as float(std::size_t primitive) for primitives whose box
+     *        is closer than squareDistance, returns square distance to the primitive.
+     * \return Closest primitive, #NONE if none is closer than the distance.
+     */
+    template<typename Distance>
+    std::size_t nearest(const Vec3& point, float& squareDistance, Distance distance) const;
+
+    /*!
+     * \brief Overlapping primitives enumeration.
+     * \details Radius queries are box queries with the visitor checking the distance.
+     * \param box Query box.
+     * \param visitor Called as void(std::size_t primitive) for every primitive whose
+     *        box overlaps or touches the query box, in no particular order.
+     */
+    template<typename Visitor>
+    void query(const AABB& box, Visitor visitor) const;
+
+    /*!
+     * \brief Primitives count selector.
+     * \return Number of primitives.
+     */
+    MATH_API std::size_t size() const;
+
+    /*!
+     * \brief Nodes count selector.
+     * \return Number of 4 wide nodes.
+     */
+    MATH_API std::size_t getNodeCount() const;
+
+    /*!
+     * \brief Hierarchy bounds selector.
+     * \return Bounds of all primitives, zero size box if empty.
+     */
+    MATH_API AABB getBounds() const;
+
+private:
+    enum {
+        MIN_X, MIN_Y, MIN_Z, MAX_X, MAX_Y, MAX_Z
+    };
+
+    // Leaf children have non zero counts and index primitives, unused children have
+    // inverted bounds that no test passes.
+    struct Node {
+        alignas(16) float bounds[6][4];
+        std::uint32_t children[4];
+        std::uint32_t counts[4];
+    };
+
+    struct Entry {
+        std::uint32_t node;
+        float distance;
+    };
+
+    class Builder;
+
+    // Node depth is bounded by the builder, a node pops one entry and pushes 4 at most
+    static constexpr std::size_t STACK_SIZE = 256;
+
+    MATH_API void buildTree(Executor* executor, const AABB* boxes, std::size_t count);
+
+    // Traversals calling back with leaf slots, the public queries map them to primitives
+    template<typename Intersect>
+    std::size_t castRay(const Vec3& origin, const Vec3& direction, float& distance, Intersect intersect) const;
+
+    template<typename Distance>
+    std::size_t findNearest(const Vec3& point, float& squareDistance, Distance distance) const;
+
+    static int intersectRay(const Node& node, const float* origin, const float* inverse,
+            const int* near, const int* far, float distance, float* entries);
+    static int intersectPoint(const Node& node, const float* point, float squareDistance, float* distances);
+    static int intersectBox(const Node& node, const AABB& box);
+    static int sortLanes(int mask, const float* distances, int* lanes);
+
+    std::vector<Node> nodes;
+    std::vector<AABB> boxes;
+    std::vector<std::uint32_t> indices;
+};
+
+inline int BVH::intersectRay(const Node& node, const float* origin, const float* inverse,
+        const int* near, const int* far, float distance, float* entries) {
+#if defined(MATH_SIMD)
+    Simd::Float4 entry = Simd::splat(0.0f);
+    Simd::Float4 exit = Simd::splat(distance);
+
+    for (int i = 0; i < 3; i++) {
+        Simd::Float4 start = Simd::splat(origin[i]);
+        Simd::Float4 scale = Simd::splat(inverse[i]);
+        entry = Simd::max(entry, Simd::mul(Simd::sub(Simd::load(node.bounds[near[i]]), start), scale));
+        exit = Simd::min(exit, Simd::mul(Simd::sub(Simd::load(node.bounds[far[i]]), start), scale));
+    }
+
+    Simd::store(entries, entry);
+    return ~Simd::maskBits(Simd::compareLess(exit, entry)) & 0xF;
+#else
+    int mask = 0;
+
+    for (int lane = 0; lane < 4; lane++) {
+        float entry = 0.0f;
+        float exit = distance;
+
+        for (int i = 0; i < 3; i++) {
+            entry = std::max(entry, (node.bounds[near[i]][lane] - origin[i]) * inverse[i]);
+            exit = std::min(exit, (node.bounds[far[i]][lane] - origin[i]) * inverse[i]);
+        }
+
+        entries[lane] = entry;
+        mask |= (exit < entry) ? 0 : (1 << lane);
+    }
+
+    return mask;
+#endif
+}
+
+inline int BVH::intersectPoint(const Node& node, const float* point, float squareDistance, float* distances) {
+#if defined(MATH_SIMD)
+    Simd::Float4 zero = Simd::splat(0.0f);
+    Simd::Float4 squareSum = zero;
+
+    for (int i = 0; i < 3; i++) {
+        Simd::Float4 position = Simd::splat(point[i]);
+        Simd::Float4 below = Simd::sub(Simd::load(node.bounds[MIN_X + i]), position);
+        Simd::Float4 above = Simd::sub(position, Simd::load(node.bounds[MAX_X + i]));
+        Simd::Float4 offset = Simd::max(Simd::max(below, above), zero);
+        squareSum = Simd::madd(offset, offset, squareSum);
+    }
+
+    Simd::store(distances, squareSum);
+    return Simd::maskBits(Simd::compareLess(squareSum, Simd::splat(squareDistance)));
+#else
+    int mask = 0;
+
+    for (int lane = 0; lane < 4; lane++) {
+        float squareSum = 0.0f;
+
+        for (int i = 0; i < 3; i++) {
+            float below = node.bounds[MIN_X + i][lane] - point[i];
+            float above = point[i] - node.bounds[MAX_X + i][lane];
+            float offset = std::max(std::max(below, above), 0.0f);
+            squareSum += offset * offset;
+        }
+
+        distances[lane] = squareSum;
+        mask |= (squareSum < squareDistance) ? (1 << lane) : 0;
+    }
+
+    return mask;
+#endif
+}
+
+inline int BVH::intersectBox(const Node& node, const AABB& box) {
+#if defined(MATH_SIMD)
+    Simd::Float4 outside = Simd::splat(0.0f);
+
+    for (int i = 0; i < 3; i++) {
+        outside = Simd::maskOr(outside,
+                Simd::compareLess(Simd::load(node.bounds[MAX_X + i]), Simd::splat(box.getMin().get(i))));
+        outside = Simd::maskOr(outside,
+                Simd::compareLess(Simd::splat(box.getMax().get(i)), Simd::load(node.bounds[MIN_X + i])));
+    }
+
+    return ~Simd::maskBits(outside) & 0xF;
+#else
+    int mask = 0;
+
+    for (int lane = 0; lane < 4; lane++) {
+        bool outside = false;
+
+        for (int i = 0; i < 3; i++) {
+            outside = outside || node.bounds[MAX_X + i][lane] < box.getMin().get(i) ||
+                      box.getMax().get(i) < node.bounds[MIN_X + i][lane];
+        }
+
+        mask |= outside ? 0 : (1 << lane);
+    }
+
+    return mask;
+#endif
+}
+
+inline int BVH::sortLanes(int mask, const float* distances, int* lanes) {
+    int count = 0;
+
+    // Insertion sort by distance, four lanes at most
+    for (int lane = 0; lane < 4; lane++) {
+        if ((mask >> lane) & 1) {
+            int position = count++;
+            for (; position > 0 && distances[lanes[position - 1]] > distances[lane]; position--) {
+                lanes[position] = lanes[position - 1];
+            }
+
+            lanes[position] = lane;
+        }
+    }
+
+    return count;
+}
+
+template<typename Intersect>
+std::size_t BVH::raycast(const Vec3& origin, const Vec3& direction, float& distance, Intersect intersect) const {
+    return this->castRay(origin, direction, distance, [this, &intersect](std::uint32_t slot, float& hitDistance) {
+        return intersect(static_cast<std::size_t>(this->indices[slot]), hitDistance);
+    });
+}
+
+template<typename Distance>
+std::size_t BVH::nearest(const Vec3& point, float& squareDistance, Distance distance) const {
+    return this->findNearest(point, squareDistance, [this, &distance](std::uint32_t slot) {
+        return distance(static_cast<std::size_t>(this->indices[slot]));
+    });
+}
+
+template<typename Intersect>
+std::size_t BVH::castRay(const Vec3& origin, const Vec3& direction, float& distance, Intersect intersect) const {
+    std::size_t hit = NONE;
+    if (this->nodes.empty()) {
+        return hit;
+    }
+
+    float start[3], inverse[3];
+    int near[3], far[3];
+
+    for (int i = 0; i < 3; i++) {
+        // Zero components give infinities, slabs parallel to the ray then either span it or miss
+        start[i] = origin.get(i);
+        inverse[i] = 1.0f / direction.get(i);
+        near[i] = (inverse[i] < 0.0f) ? MAX_X + i : MIN_X + i;
+        far[i] = (inverse[i] < 0.0f) ? MIN_X + i : MAX_X + i;
+    }
+
+    Entry stack[STACK_SIZE];
+    std::size_t top = 0;
+    stack[top++] = { 0, 0.0f };
+
+    while (top > 0) {
+        Entry entry = stack[--top];
+        if (entry.distance > distance) {
+            continue;
+        }
+
+        const Node& node = this->nodes[entry.node];
+        alignas(16) float entries[4];
+        int lanes[4];
+        int mask = BVH::intersectRay(node, start, inverse, near, far, distance, entries);
+        int count = BVH::sortLanes(mask, entries, lanes);
+
+        // Leaves are tested in near to far order, inner nodes are pushed far to near
+        for (int i = 0; i < count; i++) {
+            int lane = lanes[i];
+            if (node.counts[lane] == 0 || entries[lane] > distance) {
+                continue;
+            }
+
+            std::uint32_t first = node.children[lane];
+            for (std::uint32_t j = first; j < first + node.counts[lane]; j++) {
+                if (intersect(j, distance)) {
+                    hit = this->indices[j];
+                }
+            }
+        }
+
+        for (int i = count - 1; i >= 0; i--) {
+            int lane = lanes[i];
+            if (node.counts[lane] == 0 && entries[lane] <= distance) {
+                assert(top < STACK_SIZE);
+                stack[top++] = { node.children[lane], entries[lane] };
+            }
+        }
+    }
+
+    return hit;
+}
+
+template<typename Distance>
+std::size_t BVH::findNearest(const Vec3& point, float& squareDistance, Distance distance) const {
+    std::size_t closest = NONE;
+    if (this->nodes.empty()) {
+        return closest;
+    }
+
+    float position[3] = { point.get(Vec3::X), point.get(Vec3::Y), point.get(Vec3::Z) };
+    Entry stack[STACK_SIZE];
+    std::size_t top = 0;
+    stack[top++] = { 0, 0.0f };
+
+    while (top > 0) {
+        Entry entry = stack[--top];
+        if (entry.distance >= squareDistance) {
+            continue;
+        }
+
+        const Node& node = this->nodes[entry.node];
+        alignas(16) float distances[4];
+        int lanes[4];
+        int mask = BVH::intersectPoint(node, position, squareDistance, distances);
+        int count = BVH::sortLanes(mask, distances, lanes);
+
+        for (int i = 0; i < count; i++) {
+            int lane = lanes[i];
+            if (node.counts[lane] == 0 || distances[lane] >= squareDistance) {
+                continue;
+            }
+
+            std::uint32_t first = node.children[lane];
+            for (std::uint32_t j = first; j < first + node.counts[lane]; j++) {
+                float primitiveDistance = distance(j);
+                if (primitiveDistance < squareDistance) {
+                    squareDistance = primitiveDistance;
+                    closest = this->indices[j];
+                }
+            }
+        }
+
+        for (int i = count - 1; i >= 0; i--) {
+            int lane = lanes[i];
+            if (node.counts[lane] == 0 && distances[lane] < squareDistance) {
+                assert(top < STACK_SIZE);
+                stack[top++] = { node.children[lane], distances[lane] };
+            }
+        }
+    }
+
+    return closest;
+}
+
+template<typename Visitor>
+void BVH::query(const AABB& box, Visitor visitor) const {
+    if (this->nodes.empty()) {
+        return;
+    }
+
+    std::uint32_t stack[STACK_SIZE];
+    std::size_t top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const Node& node = this->nodes[stack[--top]];
+        int mask = BVH::intersectBox(node, box);
+
+        for (int lane = 0; lane < 4; lane++) {
+            if (((mask >> lane) & 1) == 0) {
+                continue;
+            }
+
+            if (node.counts[lane] == 0) {
+                assert(top < STACK_SIZE);
+                stack[top++] = node.children[lane];
+                continue;
+            }
+
+            std::uint32_t first = node.children[lane];
+            for (std::uint32_t j = first; j < first + node.counts[lane]; j++) {
+                if (box.intersects(this->boxes[j])) {
+                    visitor(static_cast<std::size_t>(this->indices[j]));
+                }
+            }
+        }
+    }
+}
+
+}  // namespace Math
+
+#ifdef MATH_HEADER_ONLY
+#include <BVH.inl>
+#endif
+
+#endif  // BVH_H
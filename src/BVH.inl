@@ -0,0 +1,571 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BVH_INL
+#define BVH_INL
+
+#include <BVH.h>
+#include <AABB.h>
+#include <Vec3.h>
+#include <Executor.h>
+#include <Parallel.h>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace Math {
+
+/*
+ * Binned SAH builder of a binary tree, flattened into 4 wide nodes afterwards. Child
+ * nodes are allocated in pairs from a shared counter so that subtrees build in
+ * parallel without merging.
+ */
+class BVH::Builder {
+public:
+    Builder(const AABB* boxes, std::size_t count):
+            boxes(boxes),
+            primitives(count),
+            nodes(2 * count - 1),
+            nodeCount(1) {
+    }
+
+    void build(Executor* executor) {
+        std::size_t count = this->primitives.size();
+        auto prepare = [this](std::size_t first, std::size_t chunk) {
+            for (std::size_t i = first; i < first + chunk; i++) {
+                Primitive& primitive = this->primitives[i];
+                for (int j = 0; j < 3; j++) {
+                    primitive.bounds.minimum[j] = this->boxes[i].getMin().get(j);
+                    primitive.bounds.maximum[j] = this->boxes[i].getMax().get(j);
+                    primitive.centroid[j] = (primitive.bounds.minimum[j] + primitive.bounds.maximum[j]) * 0.5f;
+                }
+
+                primitive.bounds.minimum[3] = 0.0f;
+                primitive.bounds.maximum[3] = 0.0f;
+
+                primitive.index = static_cast<std::uint32_t>(i);
+            }
+        };
+
+        if (executor != nullptr) {
+            Parallel::forEach(*executor, count, sizeof(AABB), prepare);
+        } else {
+            prepare(0, count);
+        }
+
+        Task root = { 0, 0, static_cast<std::uint32_t>(count), 0 };
+        this->nodes[0].bounds = this->rangeBounds(0, root.count);
+
+        if (executor == nullptr) {
+            this->buildSubtree(root);
+            return;
+        }
+
+        // Top levels split here until there are enough subtrees to keep every thread busy
+        std::size_t target = std::max<std::size_t>(executor->concurrency(), 1) * Parallel::CHUNKS_PER_THREAD;
+        std::vector<Task> pending(1, root);
+        std::vector<Task> subtrees;
+
+        while (!pending.empty() && pending.size() + subtrees.size() < target) {
+            Task task = pending.front();
+            pending.erase(pending.begin());
+
+            Task children[2];
+            if (!this->split(task, children[0], children[1])) {
+                continue;
+            }
+
+            for (const Task& child: children) {
+                (child.count < MIN_TASK_SIZE ? subtrees : pending).push_back(child);
+            }
+        }
+
+        subtrees.insert(subtrees.end(), pending.begin(), pending.end());
+        executor->run(subtrees.size(), [this, &subtrees](std::size_t index) {
+            this->buildSubtree(subtrees[index]);
+        });
+    }
+
+    void flatten(BVH& bvh) const {
+        bvh.indices.resize(this->primitives.size());
+        bvh.boxes.resize(this->primitives.size());
+        for (std::size_t i = 0; i < this->primitives.size(); i++) {
+            bvh.indices[i] = this->primitives[i].index;
+            bvh.boxes[i] = this->boxes[this->primitives[i].index];
+        }
+
+        bvh.nodes.clear();
+        bvh.nodes.reserve(this->nodeCount.load() / 2 + 1);
+        bvh.nodes.emplace_back();
+
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> stack(1, std::make_pair(0u, 0u));
+
+        while (!stack.empty()) {
+            std::uint32_t source = stack.back().first;
+            std::uint32_t destination = stack.back().second;
+            stack.pop_back();
+
+            // Pull grandchildren up while there are free lanes, largest surface area first
+            std::uint32_t children[4] = { source, 0, 0, 0 };
+            int childCount = 1;
+
+            if (this->nodes[source].count == 0) {
+                children[0] = this->nodes[source].left;
+                children[1] = this->nodes[source].left + 1;
+                childCount = 2;
+            }
+
+            while (childCount < 4) {
+                int expanded = -1;
+                float largestArea = -1.0f;
+
+                for (int i = 0; i < childCount; i++) {
+                    const BuildNode& child = this->nodes[children[i]];
+                    float area = Builder::area(child.bounds);
+                    if (child.count == 0 && area > largestArea) {
+                        largestArea = area;
+                        expanded = i;
+                    }
+                }
+
+                if (expanded < 0) {
+                    break;
+                }
+
+                std::uint32_t left = this->nodes[children[expanded]].left;
+                children[expanded] = left;
+                children[childCount++] = left + 1;
+            }
+
+            Node node;
+            for (int lane = 0; lane < 4; lane++) {
+                if (lane >= childCount) {
+                    for (int i = 0; i < 3; i++) {
+                        node.bounds[MIN_X + i][lane] = std::numeric_limits<float>::infinity();
+                        node.bounds[MAX_X + i][lane] = -std::numeric_limits<float>::infinity();
+                    }
+
+                    node.children[lane] = 0;
+                    node.counts[lane] = 0;
+                    continue;
+                }
+
+                const BuildNode& child = this->nodes[children[lane]];
+                for (int i = 0; i < 3; i++) {
+                    node.bounds[MIN_X + i][lane] = child.bounds.minimum[i];
+                    node.bounds[MAX_X + i][lane] = child.bounds.maximum[i];
+                }
+
+                if (child.count > 0) {
+                    node.children[lane] = child.first;
+                    node.counts[lane] = child.count;
+                } else {
+                    node.children[lane] = static_cast<std::uint32_t>(bvh.nodes.size());
+                    node.counts[lane] = 0;
+                    bvh.nodes.emplace_back();
+                }
+            }
+
+            // Depth first order keeps nodes close to their parents
+            for (int lane = childCount - 1; lane >= 0; lane--) {
+                if (node.counts[lane] == 0) {
+                    stack.emplace_back(children[lane], node.children[lane]);
+                }
+            }
+
+            bvh.nodes[destination] = node;
+        }
+    }
+
+private:
+    static constexpr int BINS = 16;
+    static constexpr std::uint32_t MAX_DEPTH = 48;         // Median splits below, bounds BVH::STACK_SIZE
+    static constexpr std::uint32_t MIN_TASK_SIZE = 4096;   // Smaller subtrees are not split further serially
+    static constexpr float TRAVERSAL_COST = 1.0f;          // Relative to a primitive test
+
+    // Fourth lane is padding, merges are two SIMD operations
+    struct Box {
+        alignas(16) float minimum[4];
+        alignas(16) float maximum[4];
+    };
+
+    // Leaf if count is not zero, inner node children are left and left + 1
+    struct BuildNode {
+        Box bounds;
+        std::uint32_t first;
+        std::uint32_t count;
+        std::uint32_t left;
+    };
+
+    struct Task {
+        std::uint32_t node;
+        std::uint32_t first;
+        std::uint32_t count;
+        std::uint32_t depth;
+    };
+
+    // Sorted in place during the build, index refers to the input box
+    struct Primitive {
+        Box bounds;
+        float centroid[3];
+        std::uint32_t index;
+    };
+
+    struct Bin {
+        Box bounds;
+        std::uint32_t count;
+    };
+
+    static void clear(Box& box) {
+        for (int i = 0; i < 4; i++) {
+            box.minimum[i] = std::numeric_limits<float>::infinity();
+            box.maximum[i] = -std::numeric_limits<float>::infinity();
+        }
+    }
+
+    static void merge(Box& box, const Box& other) {
+#if defined(MATH_SIMD)
+        Simd::store(box.minimum, Simd::min(Simd::load(box.minimum), Simd::load(other.minimum)));
+        Simd::store(box.maximum, Simd::max(Simd::load(box.maximum), Simd::load(other.maximum)));
+#else
+        for (int i = 0; i < 4; i++) {
+            box.minimum[i] = std::min(box.minimum[i], other.minimum[i]);
+            box.maximum[i] = std::max(box.maximum[i], other.maximum[i]);
+        }
+#endif
+    }
+
+    // Half of the surface area, empty boxes are zero
+    static float area(const Box& box) {
+        float x = std::max(box.maximum[0] - box.minimum[0], 0.0f);
+        float y = std::max(box.maximum[1] - box.minimum[1], 0.0f);
+        float z = std::max(box.maximum[2] - box.minimum[2], 0.0f);
+        return x * y + y * z + z * x;
+    }
+
+    Box rangeBounds(std::uint32_t first, std::uint32_t count) const {
+        Box bounds;
+        Builder::clear(bounds);
+
+        for (std::uint32_t i = first; i < first + count; i++) {
+            Builder::merge(bounds, this->primitives[i].bounds);
+        }
+
+        return bounds;
+    }
+
+    void buildSubtree(const Task& root) {
+        std::vector<Task> stack(1, root);
+
+        while (!stack.empty()) {
+            Task task = stack.back();
+            stack.pop_back();
+
+            Task left, right;
+            if (this->split(task, left, right)) {
+                stack.push_back(right);
+                stack.push_back(left);
+            }
+        }
+    }
+
+    // Either turns the node into a leaf or splits it, returns true in the latter case
+    bool split(const Task& task, Task& left, Task& right) {
+        BuildNode& node = this->nodes[task.node];
+        node.first = task.first;
+        node.count = task.count;
+        node.left = 0;
+
+        if (task.count == 1) {
+            return false;
+        }
+
+        Primitive* begin = this->primitives.data() + task.first;
+        Primitive* end = begin + task.count;
+
+        float centroidMin[3];
+        float centroidMax[3];
+        for (int axis = 0; axis < 3; axis++) {
+            centroidMin[axis] = std::numeric_limits<float>::infinity();
+            centroidMax[axis] = -std::numeric_limits<float>::infinity();
+        }
+
+        for (const Primitive* primitive = begin; primitive != end; primitive++) {
+            const float* centroid = primitive->centroid;
+            for (int axis = 0; axis < 3; axis++) {
+                centroidMin[axis] = std::min(centroidMin[axis], centroid[axis]);
+                centroidMax[axis] = std::max(centroidMax[axis], centroid[axis]);
+            }
+        }
+
+        // All three axes are binned in a single pass over the primitives, small nodes use fewer bins
+        int binCount = static_cast<int>(std::min<std::uint32_t>(BINS, task.count));
+        Bin bins[3][BINS];
+        float scales[3];
+
+        for (int axis = 0; axis < 3; axis++) {
+            float extent = centroidMax[axis] - centroidMin[axis];
+            scales[axis] = (extent > 0.0f) ? static_cast<float>(binCount) / extent : 0.0f;
+
+            for (int i = 0; i < binCount; i++) {
+                Builder::clear(bins[axis][i].bounds);
+                bins[axis][i].count = 0;
+            }
+        }
+
+        if (task.depth < MAX_DEPTH) {
+            for (const Primitive* primitive = begin; primitive != end; primitive++) {
+                for (int axis = 0; axis < 3; axis++) {
+                    Bin& bin = bins[axis][Builder::binIndex(*primitive, axis, centroidMin[axis], scales[axis], binCount)];
+                    Builder::merge(bin.bounds, primitive->bounds);
+                    bin.count++;
+                }
+            }
+        }
+
+        int bestAxis = -1;
+        int bestBin = 0;
+        float bestCost = std::numeric_limits<float>::infinity();
+        Box bestBounds[2];
+
+        for (int axis = 0; axis < 3 && task.depth < MAX_DEPTH; axis++) {
+            if (scales[axis] == 0.0f) {
+                continue;
+            }
+
+            // Right to left sweep first, then costs of splitting after every bin
+            Box rightBounds[BINS];
+            std::uint32_t rightCounts[BINS];
+            Box bounds;
+            std::uint32_t count = 0;
+
+            Builder::clear(bounds);
+            for (int i = binCount - 1; i > 0; i--) {
+                Builder::merge(bounds, bins[axis][i].bounds);
+                count += bins[axis][i].count;
+                rightBounds[i] = bounds;
+                rightCounts[i] = count;
+            }
+
+            Builder::clear(bounds);
+            count = 0;
+
+            for (int i = 0; i < binCount - 1; i++) {
+                Builder::merge(bounds, bins[axis][i].bounds);
+                count += bins[axis][i].count;
+                if (count == 0 || rightCounts[i + 1] == 0) {
+                    continue;
+                }
+
+                float cost = Builder::area(bounds) * static_cast<float>(count) +
+                             Builder::area(rightBounds[i + 1]) * static_cast<float>(rightCounts[i + 1]);
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = i;
+                    bestBounds[0] = bounds;
+                    bestBounds[1] = rightBounds[i + 1];
+                }
+            }
+        }
+
+        float nodeArea = Builder::area(node.bounds);
+        float leafCost = nodeArea * static_cast<float>(task.count);
+        float splitCost = nodeArea * TRAVERSAL_COST + bestCost;
+
+        if (task.count <= MAX_LEAF_SIZE && (bestAxis < 0 || leafCost <= splitCost)) {
+            return false;
+        }
+
+        Primitive* middle;
+
+        if (bestAxis >= 0) {
+            float minimum = centroidMin[bestAxis];
+            float scale = scales[bestAxis];
+            middle = std::partition(begin, end, [bestAxis, bestBin, minimum, scale, binCount](const Primitive& primitive) {
+                return Builder::binIndex(primitive, bestAxis, minimum, scale, binCount) <= bestBin;
+            });
+        } else {
+            // Coincident centroids or too deep, median split along the widest centroid extent
+            int axis = 0;
+            for (int i = 1; i < 3; i++) {
+                if (centroidMax[i] - centroidMin[i] > centroidMax[axis] - centroidMin[axis]) {
+                    axis = i;
+                }
+            }
+
+            middle = begin + task.count / 2;
+            std::nth_element(begin, middle, end, [axis](const Primitive& a, const Primitive& b) {
+                return a.centroid[axis] < b.centroid[axis];
+            });
+        }
+
+        std::uint32_t leftCount = static_cast<std::uint32_t>(middle - begin);
+        assert(leftCount > 0 && leftCount < task.count);
+
+        node.count = 0;
+        node.left = this->nodeCount.fetch_add(2, std::memory_order_relaxed);
+        left = { node.left, task.first, leftCount, task.depth + 1 };
+        right = { node.left + 1, task.first + leftCount, task.count - leftCount, task.depth + 1 };
+
+        if (bestAxis >= 0) {
+            this->nodes[left.node].bounds = bestBounds[0];
+            this->nodes[right.node].bounds = bestBounds[1];
+        } else {
+            this->nodes[left.node].bounds = this->rangeBounds(left.first, left.count);
+            this->nodes[right.node].bounds = this->rangeBounds(right.first, right.count);
+        }
+
+        return true;
+    }
+
+    static int binIndex(const Primitive& primitive, int axis, float minimum, float scale, int binCount) {
+        int bin = static_cast<int>((primitive.centroid[axis] - minimum) * scale);
+        return std::min(bin, binCount - 1);
+    }
+
+    const AABB* boxes;
+    std::vector<Primitive> primitives;
+    std::vector<BuildNode> nodes;
+    std::atomic<std::uint32_t> nodeCount;
+};
+
+MATH_INLINE BVH::BVH() {
+}
+
+MATH_INLINE void BVH::build(const AABB* boxes, std::size_t count) {
+    this->buildTree(nullptr, boxes, count);
+}
+
+MATH_INLINE void BVH::build(Executor& executor, const AABB* boxes, std::size_t count) {
+    this->buildTree(&executor, boxes, count);
+}
+
+MATH_INLINE void BVH::build(const Vec3* points, std::size_t count) {
+    std::vector<AABB> boxes;
+    boxes.reserve(count);
+
+    for (std::size_t i = 0; i < count; i++) {
+        boxes.emplace_back(points[i], points[i]);
+    }
+
+    this->buildTree(nullptr, boxes.data(), count);
+}
+
+MATH_INLINE void BVH::build(Executor& executor, const Vec3* points, std::size_t count) {
+    std::vector<AABB> boxes(count);
+    Parallel::forEach(executor, count, sizeof(AABB), [points, &boxes](std::size_t first, std::size_t chunk) {
+        for (std::size_t i = first; i < first + chunk; i++) {
+            boxes[i] = AABB(points[i], points[i]);
+        }
+    });
+
+    this->buildTree(&executor, boxes.data(), count);
+}
+
+MATH_INLINE std::size_t BVH::raycast(const Vec3& origin, const Vec3& direction, float& distance) const {
+    float start[3] = { origin.get(Vec3::X), origin.get(Vec3::Y), origin.get(Vec3::Z) };
+    float inverse[3] = { 1.0f / direction.get(Vec3::X), 1.0f / direction.get(Vec3::Y), 1.0f / direction.get(Vec3::Z) };
+
+    return this->castRay(origin, direction, distance, [this, &start, &inverse](std::uint32_t slot, float& hitDistance) {
+        const AABB& box = this->boxes[slot];
+        float entry = 0.0f;
+        float exit = hitDistance;
+
+        for (int i = 0; i < 3; i++) {
+            float near = (box.getMin().get(i) - start[i]) * inverse[i];
+            float far = (box.getMax().get(i) - start[i]) * inverse[i];
+            entry = std::max(entry, std::min(near, far));
+            exit = std::min(exit, std::max(near, far));
+        }
+
+        if (entry > exit || entry >= hitDistance) {
+            return false;
+        }
+
+        hitDistance = entry;
+        return true;
+    });
+}
+
+MATH_INLINE std::size_t BVH::nearest(const Vec3& point, float& squareDistance) const {
+    return this->findNearest(point, squareDistance, [this, &point](std::uint32_t slot) {
+        const AABB& box = this->boxes[slot];
+        float squareSum = 0.0f;
+
+        for (int i = 0; i < 3; i++) {
+            float offset = std::max(std::max(box.getMin().get(i) - point.get(i), point.get(i) - box.getMax().get(i)), 0.0f);
+            squareSum += offset * offset;
+        }
+
+        return squareSum;
+    });
+}
+
+MATH_INLINE std::size_t BVH::size() const {
+    return this->indices.size();
+}
+
+MATH_INLINE std::size_t BVH::getNodeCount() const {
+    return this->nodes.size();
+}
+
+MATH_INLINE AABB BVH::getBounds() const {
+    if (this->nodes.empty()) {
+        return AABB();
+    }
+
+    // Unused lanes have inverted bounds and do not change the union
+    const Node& root = this->nodes[0];
+    float bounds[6];
+
+    for (int i = 0; i < 3; i++) {
+        bounds[MIN_X + i] = std::min(std::min(root.bounds[MIN_X + i][0], root.bounds[MIN_X + i][1]),
+                                     std::min(root.bounds[MIN_X + i][2], root.bounds[MIN_X + i][3]));
+        bounds[MAX_X + i] = std::max(std::max(root.bounds[MAX_X + i][0], root.bounds[MAX_X + i][1]),
+                                     std::max(root.bounds[MAX_X + i][2], root.bounds[MAX_X + i][3]));
+    }
+
+    return AABB(Vec3(bounds[MIN_X], bounds[MIN_Y], bounds[MIN_Z]), Vec3(bounds[MAX_X], bounds[MAX_Y], bounds[MAX_Z]));
+}
+
+MATH_INLINE void BVH::buildTree(Executor* executor, const AABB* boxes, std::size_t count) {
+    assert(count <= UINT32_MAX);
+    this->nodes.clear();
+    this->boxes.clear();
+    this->indices.clear();
+
+    if (count == 0) {
+        return;
+    }
+
+    Builder builder(boxes, count);
+    builder.build(executor);
+    builder.flatten(*this);
+}
+
+}  // namespace Math
+
+#endif  // BVH_INL
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DISPATCH_H
+#define DISPATCH_H
+
+#include <MathApi.h>
+#include <cstddef>
+
+namespace Math {
+
+/*!
+ * \brief Batch kernel function table.
+ * \details Raw float entry points behind the Mat4, Vec3SoA and Vec4SoA batch members,
+ *          one table per instruction set. Matrices are 16 byte aligned row major 4x4
+ *          float blocks, SoA streams are 16 byte aligned.
+ */
+struct KernelTable {
+    void (*transform)(const float* matrix, const float* source, std::size_t sourceStride,
+            float* destination, std::size_t destinationStride, std::size_t count);
+    void (*transformVec3)(const float* matrix, const float* source, std::size_t sourceStride,
+            float* destination, std::size_t destinationStride, std::size_t count, float w);
+    void (*multiply)(const float* matrix, const float* matrices, float* result, std::size_t count, bool transpose);
+    std::size_t (*invert)(const float* matrices, float* result, std::size_t count, bool transpose);
+    void (*dot3)(const float* const* left, const float* const* right, float* result,
+            std::size_t first, std::size_t end);
+    void (*dot4)(const float* const* left, const float* const* right, float* result,
+            std::size_t first, std::size_t end);
+    void (*normalize3)(float* const* streams, std::size_t first, std::size_t end);
+};
+
+/*!
+ * \brief Runtime instruction set selection.
+ * \details The library is built with a kernel table per instruction set it supports,
+ *          scalar and baseline SIMD always, AVX2 with FMA on x86 when the compiler
+ *          allows it. The best one the CPU runs is selected once at load time. In
+ *          header only mode kernels are inlined for the compile time instruction set
+ *          and there is nothing to select.
+ */
+class Dispatch {
+public:
+    enum Isa {
+        SCALAR,  /*!< Reference scalar code */
+        SSE2,    /*!< Baseline x86 build */
+        AVX2,    /*!< AVX2 with FMA */
+        NEON     /*!< Baseline ARM build */
+    };
+
+    /*!
+     * \brief Best supported instruction set selector.
+     * \return Widest instruction set both compiled in and supported by the CPU.
+     */
+    MATH_API static Isa getSupported();
+
+    /*!
+     * \brief Selected instruction set selector.
+     * \return Instruction set the batch kernels currently run.
+     */
+    MATH_API static Isa getSelected();
+
+    /*!
+     * \brief Force instruction set.
+     * \details Meant for reproducible benchmarks and testing the scalar reference
+     *          code on SIMD capable machines.
+     * \param isa Instruction set to run the batch kernels with.
+     * \return True if selected, false if not compiled in or not supported by the CPU.
+     * \note Selection is atomic, batch calls already running finish with the previous
+     *       kernels.
+     */
+    MATH_API static bool select(Isa isa);
+
+    /*!
+     * \brief Instruction set name selector.
+     * \param isa Instruction set.
+     * \return Human readable name.
+     */
+    MATH_API static const char* getName(Isa isa);
+
+    /*!
+     * \brief Selected kernel table selector.
+     * \return Kernels of the selected instruction set.
+     */
+    MATH_API static const KernelTable& getKernels();
+
+private:
+    static const KernelTable* getTable(Isa isa);
+};
+
+}  // namespace Math
+
+#ifdef MATH_HEADER_ONLY
+#include <Dispatch.inl>
+#endif
+
+#endif  // DISPATCH_H
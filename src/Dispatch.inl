@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DISPATCH_INL
+#define DISPATCH_INL
+
+#include <Dispatch.h>
+#include <MathSimd.h>
+
+#if defined(MATH_HEADER_ONLY)
+#include <Kernels.inl>
+#else
+#include <atomic>
+
+#if defined(MATH_DISPATCH_AVX2) && defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+#endif
+
+namespace Math {
+
+#if defined(MATH_HEADER_ONLY)
+
+MATH_INLINE Dispatch::Isa Dispatch::getSupported() {
+#if defined(__AVX2__) && defined(MATH_FMA)
+    return AVX2;
+#elif defined(MATH_SSE2)
+    return SSE2;
+#elif defined(MATH_NEON)
+    return NEON;
+#else
+    return SCALAR;
+#endif
+}
+
+MATH_INLINE Dispatch::Isa Dispatch::getSelected() {
+    return Dispatch::getSupported();
+}
+
+MATH_INLINE bool Dispatch::select(Isa isa) {
+    return isa == Dispatch::getSupported();
+}
+
+MATH_INLINE const KernelTable& Dispatch::getKernels() {
+    return Kernels::Native::table;
+}
+
+MATH_INLINE const KernelTable* Dispatch::getTable(Isa isa) {
+    return (isa == Dispatch::getSupported()) ? &Kernels::Native::table : nullptr;
+}
+
+#else
+
+namespace Kernels {
+
+namespace Scalar {
+extern const KernelTable table;
+}
+
+namespace Baseline {
+extern const KernelTable table;
+}
+
+namespace Avx2 {
+extern const KernelTable table;
+}
+
+}  // namespace Kernels
+
+namespace {
+
+// Constant initialized, explicit selections made before the load time one are kept
+std::atomic<const KernelTable*> selectedKernels(nullptr);
+
+bool hasAvx2() {
+#if !defined(MATH_DISPATCH_AVX2)
+    return false;
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+
+    // FMA, OSXSAVE and AVX bits, then the OS has to save YMM state on context switches
+    __cpuid(info, 1);
+    int features = (1 << 12) | (1 << 27) | (1 << 28);
+    if ((info[2] & features) != features || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    // Constructors of other shared objects may run before the compiler runtime one
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+
+struct LoadTimeSelection {
+    LoadTimeSelection() {
+        Dispatch::getKernels();
+    }
+} loadTimeSelection;
+
+}  // namespace
+
+MATH_INLINE Dispatch::Isa Dispatch::getSupported() {
+    static const Isa supported = hasAvx2() ? AVX2 :
+#if defined(MATH_SSE2)
+            SSE2;
+#elif defined(MATH_NEON)
+            NEON;
+#else
+            SCALAR;
+#endif
+
+    return supported;
+}
+
+MATH_INLINE Dispatch::Isa Dispatch::getSelected() {
+    const KernelTable* kernels = &Dispatch::getKernels();
+    for (int isa = SSE2; isa <= NEON; isa++) {
+        if (kernels == Dispatch::getTable(static_cast<Isa>(isa))) {
+            return static_cast<Isa>(isa);
+        }
+    }
+
+    return SCALAR;
+}
+
+MATH_INLINE bool Dispatch::select(Isa isa) {
+    const KernelTable* kernels = Dispatch::getTable(isa);
+    if (kernels == nullptr) {
+        return false;
+    }
+
+    selectedKernels.store(kernels, std::memory_order_relaxed);
+    return true;
+}
+
+MATH_INLINE const KernelTable& Dispatch::getKernels() {
+    const KernelTable* kernels = selectedKernels.load(std::memory_order_relaxed);
+    if (kernels == nullptr) {
+        // First call, possibly from a constructor running ahead of the load time selection
+        const KernelTable* supported = Dispatch::getTable(Dispatch::getSupported());
+        kernels = selectedKernels.compare_exchange_strong(kernels, supported, std::memory_order_relaxed) ?
+                supported : kernels;
+    }
+
+    return *kernels;
+}
+
+MATH_INLINE const KernelTable* Dispatch::getTable(Isa isa) {
+    switch (isa) {
+        case SCALAR:
+            return &Kernels::Scalar::table;
+
+#if defined(MATH_SSE2)
+        case SSE2:
+            return &Kernels::Baseline::table;
+#elif defined(MATH_NEON)
+        case NEON:
+            return &Kernels::Baseline::table;
+#endif
+
+#if defined(MATH_DISPATCH_AVX2)
+        case AVX2:
+            return hasAvx2() ? &Kernels::Avx2::table : nullptr;
+#endif
+
+        default:
+            return nullptr;
+    }
+}
+
+#endif
+
+MATH_INLINE const char* Dispatch::getName(Isa isa) {
+    switch (isa) {
+        case SCALAR:
+            return "scalar";
+        case SSE2:
+            return "sse2";
+        case AVX2:
+            return "avx2";
+        case NEON:
+            return "neon";
+        default:
+            return "unknown";
+    }
+}
+
+}  // namespace Math
+
+#endif  // DISPATCH_INL
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DUALQUATERNION_H
+#define DUALQUATERNION_H
+
+#include <MathApi.h>
+#include <Quaternion.h>
+#include <cstddef>
+
+namespace Math {
+
+class Vec3;
+class Mat4;
+
+/*!
+ * \brief Dual quaternion representation of rigid transformations.
+ * \details DualQuaternion stores rotation as a real Quaternion part and translation
+ *          as a dual part equal to 0.5 * t * r. It implements basic operations that are:
+ *          * composition, normalization, inversion;
+ *          * point and direction transformation;
+ *          * Mat4 conversion;
+ *          * dual quaternion linear blend skinning.
+ */
+class DualQuaternion {
+public:
+    /*!
+     * \brief Default constructor.
+     * \details Constructs the identity transformation.
+     */
+    MATH_API DualQuaternion();
+
+    /*!
+     * \brief Per-part constructor.
+     * \param real Real part.
+     * \param dual Dual part.
+     */
+    MATH_API DualQuaternion(const Quaternion& real, const Quaternion& dual);
+
+    /*!
+     * \brief Rotation-translation based constructor.
+     * \details Constructs transformation rotating by rotation first and then translating
+     *          by translation.
+     * \param rotation Unit rotation quaternion.
+     * \param translation Translation vector.
+     */
+    MATH_API DualQuaternion(const Quaternion& rotation, const Vec3& translation);
+
+    /*!
+     * \brief Mat4 based constructor.
+     * \details Extracts rotation from the upper 3x3 block by Quaternion::fromMat4() and
+     *          translation from the last column.
+     * \param matrix Rigid transformation matrix.
+     * \note Matrix is assumed to be a rigid transformation, no check is performed.
+     */
+    MATH_API explicit DualQuaternion(const Mat4& matrix);
+
+    /*!
+     * \brief Transformations composition.
+     * \details Resulting transformation applies dualQuaternion first, the same way
+     *          Mat4 product does.
+     * \param dualQuaternion Dual quaternion multiplier.
+     * \return Product dual quaternion.
+     */
+    MATH_API DualQuaternion operator *(const DualQuaternion& dualQuaternion) const;
+
+    /*!
+     * \brief Dual quaternion normalization.
+     * \details Divides both parts by the real part length.
+     * \return Normalized dual quaternion.
+     * \note Method has a side-effect.
+     */
+    MATH_API DualQuaternion& normalize();
+
+    /*!
+     * \brief Transformation inversion.
+     * \details Conjugates both parts which is the inverse of a unit dual quaternion.
+     * \return Inverted dual quaternion.
+     * \note Method has a side-effect.
+     */
+    MATH_API DualQuaternion& invert();
+
+    /*!
+     * \brief Point transformation.
+     * \param point Transformed point.
+     * \return Rotated and translated point.
+     * \note Dual quaternion is assumed to be normalized, no check is performed.
+     */
+    MATH_API Vec3 transformPoint(const Vec3& point) const;
+
+    /*!
+     * \brief Direction transformation.
+     * \param direction Transformed direction.
+     * \return Rotated direction, translation is ignored.
+     * \note Dual quaternion is assumed to be normalized, no check is performed.
+     */
+    MATH_API Vec3 transformDirection(const Vec3& direction) const;
+
+    /*!
+     * \brief Batch points transformation.
+     * \param points Source points.
+     * \param result Transformed points, may be the same array as points.
+     * \param count Number of points.
+     * \note Dual quaternion is assumed to be normalized, no check is performed.
+     */
+    MATH_API void transformPoints(const Vec3* points, Vec3* result, std::size_t count) const;
+
+    /*!
+     * \brief Real part selector.
+     * \return Real (rotation) part.
+     */
+    MATH_API const Quaternion& getReal() const;
+
+    /*!
+     * \brief Dual part selector.
+     * \return Dual part.
+     */
+    MATH_API const Quaternion& getDual() const;
+
+    /*!
+     * \brief Translation extraction.
+     * \details Derives translation as the vector part of 2 * d * r^-1.
+     * \return Translation vector.
+     * \note Dual quaternion is assumed to be normalized, no check is performed.
+     */
+    MATH_API Vec3 extractTranslation() const;
+
+    /*!
+     * \brief Mat4 matrix extraction.
+     * \details Composes Mat4 rigid transformation matrix.
+     * \return 4x4 two dimetional matrix.
+     * \note Dual quaternion is assumed to be normalized, no check is performed.
+     */
+    MATH_API Mat4 extractMat4() const;
+
+    /*!
+     * \brief Dual quaternion linear blend skinning.
+     * \details For every point blends weighted joint transformations, flipping joints
+     *          lying in the opposite hemisphere to the first influence, normalizes the
+     *          blend and transforms the point. References:
+     *           * https://users.cs.utah.edu/~ladislav/kavan07skinning/kavan07skinning.pdf
+     *
+     * \param joints Joint transformations.
+     * \param indices Joint indices, influences per point.
+     * \param weights Joint weights, influences per point.
+     * \param influences Number of joints influencing every point.
+     * \param points Source points.
+     * \param result Skinned points, may be the same array as points.
+     * \param count Number of points.
+     */
+    MATH_API static void skin(const DualQuaternion* joints, const unsigned int* indices, const float* weights,
+            std::size_t influences, const Vec3* points, Vec3* result, std::size_t count);
+
+private:
+    Quaternion real;
+    Quaternion dual;
+};
+
+}  // namespace Math
+
+#ifdef MATH_HEADER_ONLY
+#include <DualQuaternion.inl>
+#endif
+
+#endif  // DUALQUATERNION_H
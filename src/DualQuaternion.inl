@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DUALQUATERNION_INL
+#define DUALQUATERNION_INL
+
+#include <DualQuaternion.h>
+#include <Quaternion.h>
+#include <Vec3.h>
+#include <Mat4.h>
+#include <MathSimd.h>
+#include <Instrumentation.h>
+#include <cmath>
+#include <cassert>
+
+namespace Math {
+
+MATH_INLINE DualQuaternion::DualQuaternion():
+        real(0.0f, 0.0f, 0.0f, 1.0f),
+        dual(0.0f, 0.0f, 0.0f, 0.0f) {
+}
+
+MATH_INLINE DualQuaternion::DualQuaternion(const Quaternion& real, const Quaternion& dual):
+        real(real),
+        dual(dual) {
+}
+
+MATH_INLINE DualQuaternion::DualQuaternion(const Quaternion& rotation, const Vec3& translation):
+        real(rotation) {
+    Quaternion offset(translation.get(Vec3::X), translation.get(Vec3::Y), translation.get(Vec3::Z), 0.0f);
+    this->dual = (offset * rotation) * 0.5f;
+}
+
+MATH_INLINE DualQuaternion::DualQuaternion(const Mat4& matrix) {
+    *this = DualQuaternion(Quaternion::fromMat4(matrix),
+                           Vec3(matrix.get(0, 3), matrix.get(1, 3), matrix.get(2, 3)));
+}
+
+MATH_INLINE DualQuaternion DualQuaternion::operator *(const DualQuaternion& dualQuaternion) const {
+    // real = r1 * r2, dual = r1 * d2 + d1 * r2
+    DualQuaternion result;
+
+#if defined(MATH_SIMD)
+    // Columns of the left operand multiply sign flipped permutations of the right one
+    Simd::Float4 signX = Simd::set(1.0f, -1.0f, 1.0f, -1.0f);
+    Simd::Float4 signY = Simd::set(1.0f, 1.0f, -1.0f, -1.0f);
+    Simd::Float4 signZ = Simd::set(-1.0f, 1.0f, 1.0f, -1.0f);
+
+    auto product = [&](Simd::Float4 left, Simd::Float4 right) {
+        Simd::Float4 value = Simd::mul(Simd::broadcast<Quaternion::W>(left), right);
+        value = Simd::madd(Simd::xorSign(Simd::broadcast<Quaternion::X>(left), signX), Simd::reverse(right), value);
+        value = Simd::madd(Simd::xorSign(Simd::broadcast<Quaternion::Y>(left), signY), Simd::swapHalves(right), value);
+        return Simd::madd(Simd::xorSign(Simd::broadcast<Quaternion::Z>(left), signZ), Simd::swapPairs(right), value);
+    };
+
+    Simd::Float4 leftReal = Simd::loadu(this->real.vector);
+    Simd::Float4 rightReal = Simd::loadu(dualQuaternion.real.vector);
+
+    Simd::storeu(result.real.vector, product(leftReal, rightReal));
+    Simd::storeu(result.dual.vector, Simd::add(product(leftReal, Simd::loadu(dualQuaternion.dual.vector)),
+                                               product(Simd::loadu(this->dual.vector), rightReal)));
+#else
+    const float* leftReal = this->real.vector;
+    const float* leftDual = this->dual.vector;
+    const float* rightReal = dualQuaternion.real.vector;
+    const float* rightDual = dualQuaternion.dual.vector;
+
+    float* real = result.real.vector;
+    float* dual = result.dual.vector;
+
+    real[Quaternion::X] = leftReal[Quaternion::W] * rightReal[Quaternion::X] + leftReal[Quaternion::X] * rightReal[Quaternion::W] +
+                          leftReal[Quaternion::Y] * rightReal[Quaternion::Z] - leftReal[Quaternion::Z] * rightReal[Quaternion::Y];
+    real[Quaternion::Y] = leftReal[Quaternion::W] * rightReal[Quaternion::Y] - leftReal[Quaternion::X] * rightReal[Quaternion::Z] +
+                          leftReal[Quaternion::Y] * rightReal[Quaternion::W] + leftReal[Quaternion::Z] * rightReal[Quaternion::X];
+    real[Quaternion::Z] = leftReal[Quaternion::W] * rightReal[Quaternion::Z] + leftReal[Quaternion::X] * rightReal[Quaternion::Y] -
+                          leftReal[Quaternion::Y] * rightReal[Quaternion::X] + leftReal[Quaternion::Z] * rightReal[Quaternion::W];
+    real[Quaternion::W] = leftReal[Quaternion::W] * rightReal[Quaternion::W] - leftReal[Quaternion::X] * rightReal[Quaternion::X] -
+                          leftReal[Quaternion::Y] * rightReal[Quaternion::Y] - leftReal[Quaternion::Z] * rightReal[Quaternion::Z];
+
+    dual[Quaternion::X] = leftReal[Quaternion::W] * rightDual[Quaternion::X] + leftReal[Quaternion::X] * rightDual[Quaternion::W] +
+                          leftReal[Quaternion::Y] * rightDual[Quaternion::Z] - leftReal[Quaternion::Z] * rightDual[Quaternion::Y] +
+                          leftDual[Quaternion::W] * rightReal[Quaternion::X] + leftDual[Quaternion::X] * rightReal[Quaternion::W] +
+                          leftDual[Quaternion::Y] * rightReal[Quaternion::Z] - leftDual[Quaternion::Z] * rightReal[Quaternion::Y];
+    dual[Quaternion::Y] = leftReal[Quaternion::W] * rightDual[Quaternion::Y] - leftReal[Quaternion::X] * rightDual[Quaternion::Z] +
+                          leftReal[Quaternion::Y] * rightDual[Quaternion::W] + leftReal[Quaternion::Z] * rightDual[Quaternion::X] +
+                          leftDual[Quaternion::W] * rightReal[Quaternion::Y] - leftDual[Quaternion::X] * rightReal[Quaternion::Z] +
+                          leftDual[Quaternion::Y] * rightReal[Quaternion::W] + leftDual[Quaternion::Z] * rightReal[Quaternion::X];
+    dual[Quaternion::Z] = leftReal[Quaternion::W] * rightDual[Quaternion::Z] + leftReal[Quaternion::X] * rightDual[Quaternion::Y] -
+                          leftReal[Quaternion::Y] * rightDual[Quaternion::X] + leftReal[Quaternion::Z] * rightDual[Quaternion::W] +
+                          leftDual[Quaternion::W] * rightReal[Quaternion::Z] + leftDual[Quaternion::X] * rightReal[Quaternion::Y] -
+                          leftDual[Quaternion::Y] * rightReal[Quaternion::X] + leftDual[Quaternion::Z] * rightReal[Quaternion::W];
+    dual[Quaternion::W] = leftReal[Quaternion::W] * rightDual[Quaternion::W] - leftReal[Quaternion::X] * rightDual[Quaternion::X] -
+                          leftReal[Quaternion::Y] * rightDual[Quaternion::Y] - leftReal[Quaternion::Z] * rightDual[Quaternion::Z] +
+                          leftDual[Quaternion::W] * rightReal[Quaternion::W] - leftDual[Quaternion::X] * rightReal[Quaternion::X] -
+                          leftDual[Quaternion::Y] * rightReal[Quaternion::Y] - leftDual[Quaternion::Z] * rightReal[Quaternion::Z];
+
+#endif
+
+    return result;
+}
+
+MATH_INLINE DualQuaternion& DualQuaternion::normalize() {
+    float length = this->real.length();
+    this->real = this->real * (1.0f / length);
+    this->dual = this->dual * (1.0f / length);
+    return *this;
+}
+
+MATH_INLINE DualQuaternion& DualQuaternion::invert() {
+    this->real.conjugate();
+    this->dual.conjugate();
+    return *this;
+}
+
+MATH_INLINE Vec3 DualQuaternion::transformPoint(const Vec3& point) const {
+    return this->real.rotate(point) + this->extractTranslation();
+}
+
+MATH_INLINE Vec3 DualQuaternion::transformDirection(const Vec3& direction) const {
+    return this->real.rotate(direction);
+}
+
+MATH_INLINE void DualQuaternion::transformPoints(const Vec3* points, Vec3* result, std::size_t count) const {
+    Vec3 translation(this->extractTranslation());
+    this->real.rotate(points, result, count);
+
+    for (std::size_t i = 0; i < count; i++) {
+        result[i] += translation;
+    }
+}
+
+MATH_INLINE const Quaternion& DualQuaternion::getReal() const {
+    return this->real;
+}
+
+MATH_INLINE const Quaternion& DualQuaternion::getDual() const {
+    return this->dual;
+}
+
+MATH_INLINE Vec3 DualQuaternion::extractTranslation() const {
+    const float* real = this->real.vector;
+    const float* dual = this->dual.vector;
+
+    // Vector part of 2 * d * r^-1
+    return Vec3(2.0f * (real[Quaternion::W] * dual[Quaternion::X] - dual[Quaternion::W] * real[Quaternion::X] +
+                        real[Quaternion::Y] * dual[Quaternion::Z] - real[Quaternion::Z] * dual[Quaternion::Y]),
+                2.0f * (real[Quaternion::W] * dual[Quaternion::Y] - dual[Quaternion::W] * real[Quaternion::Y] +
+                        real[Quaternion::Z] * dual[Quaternion::X] - real[Quaternion::X] * dual[Quaternion::Z]),
+                2.0f * (real[Quaternion::W] * dual[Quaternion::Z] - dual[Quaternion::W] * real[Quaternion::Z] +
+                        real[Quaternion::X] * dual[Quaternion::Y] - real[Quaternion::Y] * dual[Quaternion::X]));
+}
+
+MATH_INLINE Mat4 DualQuaternion::extractMat4() const {
+    Mat4 result(this->real.extractMat4());
+    Vec3 translation(this->extractTranslation());
+
+    result.set(0, 3, translation.get(Vec3::X));
+    result.set(1, 3, translation.get(Vec3::Y));
+    result.set(2, 3, translation.get(Vec3::Z));
+
+    return result;
+}
+
+MATH_INLINE void DualQuaternion::skin(const DualQuaternion* joints, const unsigned int* indices, const float* weights,
+        std::size_t influences, const Vec3* points, Vec3* result, std::size_t count) {
+    MATH_PROBE(DUAL_QUATERNION_SKIN, count);
+
+    assert(influences > 0);
+
+    for (std::size_t i = 0; i < count; i++) {
+        const unsigned int* pointIndices = indices + i * influences;
+        const float* pointWeights = weights + i * influences;
+        const float* pivot = joints[pointIndices[0]].real.vector;
+
+        // Both parts are accumulated in one eight component register friendly array
+        float blend[8] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+
+        for (std::size_t j = 0; j < influences; j++) {
+            const DualQuaternion& joint = joints[pointIndices[j]];
+            const float* real = joint.real.vector;
+            const float* dual = joint.dual.vector;
+
+            float hemisphere = real[Quaternion::X] * pivot[Quaternion::X] + real[Quaternion::Y] * pivot[Quaternion::Y] +
+                               real[Quaternion::Z] * pivot[Quaternion::Z] + real[Quaternion::W] * pivot[Quaternion::W];
+            float weight = (hemisphere < 0.0f) ? -pointWeights[j] : pointWeights[j];
+
+            for (int k = 0; k < 4; k++) {
+                blend[k] += real[k] * weight;
+                blend[k + 4] += dual[k] * weight;
+            }
+        }
+
+        // Normalize the blend and expand transformPoint() to keep everything in registers
+        float scale = 1.0f / sqrtf(blend[Quaternion::X] * blend[Quaternion::X] + blend[Quaternion::Y] * blend[Quaternion::Y] +
+                                   blend[Quaternion::Z] * blend[Quaternion::Z] + blend[Quaternion::W] * blend[Quaternion::W]);
+
+        float x = blend[Quaternion::X] * scale;
+        float y = blend[Quaternion::Y] * scale;
+        float z = blend[Quaternion::Z] * scale;
+        float w = blend[Quaternion::W] * scale;
+
+        float dualX = blend[Quaternion::X + 4] * scale;
+        float dualY = blend[Quaternion::Y + 4] * scale;
+        float dualZ = blend[Quaternion::Z + 4] * scale;
+        float dualW = blend[Quaternion::W + 4] * scale;
+
+        const float* point = points[i].data();
+        float pointX = point[Vec3::X];
+        float pointY = point[Vec3::Y];
+        float pointZ = point[Vec3::Z];
+
+        float tX = 2.0f * (y * pointZ - z * pointY);
+        float tY = 2.0f * (z * pointX - x * pointZ);
+        float tZ = 2.0f * (x * pointY - y * pointX);
+
+        result[i] = Vec3(pointX + w * tX + (y * tZ - z * tY) + 2.0f * (w * dualX - dualW * x + y * dualZ - z * dualY),
+                         pointY + w * tY + (z * tX - x * tZ) + 2.0f * (w * dualY - dualW * y + z * dualX - x * dualZ),
+                         pointZ + w * tZ + (x * tY - y * tX) + 2.0f * (w * dualZ - dualW * z + x * dualY - y * dualX));
+    }
+}
+
+}  // namespace Math
+
+#endif  // DUALQUATERNION_INL
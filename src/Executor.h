@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include <cstddef>
+#include <functional>
+
+namespace Math {
+
+/*!
+ * \brief Task executor interface.
+ * \details Parallel batch operations split their work into independent tasks and
+ *          hand them to an Executor. Implement it on top of an existing job system
+ *          to share its threads, or use ThreadPool.
+ */
+class Executor {
+public:
+    virtual ~Executor() = default;
+
+    /*!
+     * \brief Tasks execution.
+     * \details Calls task(index) once for every index in 0..count - 1, tasks may run
+     *          concurrently and in any order. Returns when all tasks are complete.
+     *          An exception thrown by a task propagates to the caller, remaining
+     *          tasks may be skipped.
+     * \param count Number of tasks.
+     * \param task Task body.
+     */
+    virtual void run(std::size_t count, const std::function<void(std::size_t)>& task) = 0;
+
+    /*!
+     * \brief Concurrency selector.
+     * \return Number of tasks that may run simultaneously, used to size the chunks.
+     */
+    virtual std::size_t concurrency() const = 0;
+};
+
+}  // namespace Math
+
+#endif  // EXECUTOR_H
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <MathApi.h>
+#include <Plane.h>
+#include <cstddef>
+
+namespace Math {
+
+class Mat4;
+class Vec3;
+class AABB;
+class Sphere;
+
+/*!
+ * \brief View frustum.
+ * \details Frustum is bounded by six planes extracted from a projection-view
+ *          matrix, plane normals point inside. Implements:
+ *          * point, AABB and sphere visibility tests;
+ *          * batch culling of AABB and sphere arrays into visible index lists.
+ */
+class Frustum {
+public:
+    enum {
+        LEFT = 0,    /*!< Left plane index. */
+        RIGHT = 1,   /*!< Right plane index. */
+        BOTTOM = 2,  /*!< Bottom plane index. */
+        TOP = 3,     /*!< Top plane index. */
+        FRONT = 4,   /*!< Near plane index. */
+        BACK = 5     /*!< Far plane index. */
+    };
+
+    /*!
+     * \brief Default constructor.
+     * \details Constructs frustum of the identity matrix, that is -1..1 cube.
+     */
+    MATH_API Frustum();
+
+    /*!
+     * \brief Matrix constructor.
+     * \details Extracts normalized planes from the rows of a projection-view
+     *          matrix, clip space is -w <= x, y, z <= w.
+     * \param projectionView Projection-view matrix.
+     */
+    MATH_API explicit Frustum(const Mat4& projectionView);
+
+    /*!
+     * \brief Point visibility check.
+     * \param point Tested point.
+     * \return true if the point is inside the frustum, false otherwise.
+     */
+    MATH_API bool contains(const Vec3& point) const;
+
+    /*!
+     * \brief Box visibility check.
+     * \param box Tested box.
+     * \return false if the box is entirely outside of any plane, true otherwise.
+     * \note Test is conservative, boxes near frustum corners may pass it.
+     */
+    MATH_API bool intersects(const AABB& box) const;
+
+    /*!
+     * \brief Sphere visibility check.
+     * \param sphere Tested sphere.
+     * \return false if the sphere is entirely outside of any plane, true otherwise.
+     * \note Test is conservative, spheres near frustum corners may pass it.
+     */
+    MATH_API bool intersects(const Sphere& sphere) const;
+
+    /*!
+     * \brief Batch box culling.
+     * \details Tests four boxes per iteration against all planes and writes
+     *          indices of boxes passing intersects() in ascending order.
+     * \param boxes Source box array.
+     * \param count Number of boxes.
+     * \param visible Visible indices array, must have room for count indices.
+     * \return Number of visible boxes.
+     */
+    MATH_API std::size_t cull(const AABB* boxes, std::size_t count, std::size_t* visible) const;
+
+    /*!
+     * \brief Batch sphere culling.
+     * \details Tests four spheres per iteration against all planes and writes
+     *          indices of spheres passing intersects() in ascending order.
+     * \param spheres Source sphere array.
+     * \param count Number of spheres.
+     * \param visible Visible indices array, must have room for count indices.
+     * \return Number of visible spheres.
+     */
+    MATH_API std::size_t cull(const Sphere* spheres, std::size_t count, std::size_t* visible) const;
+
+    /*!
+     * \brief Frustum's plane selector.
+     * \param index Plane's index.
+     * \return Normalized plane.
+     * \note You are advised to use #LEFT, #RIGHT, #BOTTOM, #TOP, #FRONT, #BACK constants as indices.
+     */
+    MATH_API const Plane& getPlane(int index) const;
+
+private:
+    Plane planes[6];
+};
+
+}  // namespace Math
+
+#ifdef MATH_HEADER_ONLY
+#include <Frustum.inl>
+#endif
+
+#endif  // FRUSTUM_H
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FRUSTUM_INL
+#define FRUSTUM_INL
+
+#include <Frustum.h>
+#include <Plane.h>
+#include <AABB.h>
+#include <Sphere.h>
+#include <Mat4.h>
+#include <Vec3.h>
+#include <MathSimd.h>
+#include <Instrumentation.h>
+#include <cmath>
+#include <cassert>
+
+namespace Math {
+
+MATH_INLINE Frustum::Frustum():
+        Frustum(Mat4()) {
+}
+
+MATH_INLINE Frustum::Frustum(const Mat4& projectionView) {
+    // Gribb-Hartmann: every plane is the last row plus or minus one of the others
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 4; j++) {
+            float w = projectionView.get(3, j);
+            float value = projectionView.get(i, j);
+            this->planes[i * 2].set(j, w + value);
+            this->planes[i * 2 + 1].set(j, w - value);
+        }
+
+        this->planes[i * 2].normalize();
+        this->planes[i * 2 + 1].normalize();
+    }
+}
+
+MATH_INLINE bool Frustum::contains(const Vec3& point) const {
+    for (int i = 0; i < 6; i++) {
+        if (this->planes[i].distanceTo(point) < 0.0f) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+MATH_INLINE bool Frustum::intersects(const AABB& box) const {
+    Vec3 center(box.getCenter());
+    Vec3 extent(box.getExtent());
+
+    for (int i = 0; i < 6; i++) {
+        const Plane& plane = this->planes[i];
+        float radius = fabsf(plane.get(Plane::A)) * extent.get(Vec3::X) +
+                       fabsf(plane.get(Plane::B)) * extent.get(Vec3::Y) +
+                       fabsf(plane.get(Plane::C)) * extent.get(Vec3::Z);
+
+        if (plane.distanceTo(center) + radius < 0.0f) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+MATH_INLINE bool Frustum::intersects(const Sphere& sphere) const {
+    for (int i = 0; i < 6; i++) {
+        if (this->planes[i].distanceTo(sphere.getCenter()) + sphere.getRadius() < 0.0f) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+MATH_INLINE std::size_t Frustum::cull(const AABB* boxes, std::size_t count, std::size_t* visible) const {
+    MATH_PROBE(FRUSTUM_CULL, count);
+
+    static_assert(sizeof(AABB) == sizeof(float) * 6, "AABB is expected to be tightly packed");
+    std::size_t visibleCount = 0;
+    std::size_t i = 0;
+
+#if defined(MATH_SIMD)
+    Simd::Float4 planeA[6], planeB[6], planeC[6], planeD[6];
+    Simd::Float4 absA[6], absB[6], absC[6];
+
+    for (int j = 0; j < 6; j++) {
+        planeA[j] = Simd::splat(this->planes[j].get(Plane::A));
+        planeB[j] = Simd::splat(this->planes[j].get(Plane::B));
+        planeC[j] = Simd::splat(this->planes[j].get(Plane::C));
+        planeD[j] = Simd::splat(this->planes[j].get(Plane::D));
+        absA[j] = Simd::abs(planeA[j]);
+        absB[j] = Simd::abs(planeB[j]);
+        absC[j] = Simd::abs(planeC[j]);
+    }
+
+    const float* source = reinterpret_cast<const float*>(boxes);
+    Simd::Float4 zero = Simd::splat(0.0f);
+    Simd::Float4 half = Simd::splat(0.5f);
+
+    for (; i + 4 <= count; i += 4) {
+        // Four boxes are 4x6 matrix, two overlapping 4x4 transpositions turn it into components
+        const float* box = source + i * 6;
+        Simd::Float4 minX = Simd::loadu(box);
+        Simd::Float4 minY = Simd::loadu(box + 6);
+        Simd::Float4 minZ = Simd::loadu(box + 12);
+        Simd::Float4 maxX = Simd::loadu(box + 18);
+        Simd::transpose(minX, minY, minZ, maxX);
+
+        Simd::Float4 unused0 = Simd::loadu(box + 2);
+        Simd::Float4 unused1 = Simd::loadu(box + 8);
+        Simd::Float4 maxY = Simd::loadu(box + 14);
+        Simd::Float4 maxZ = Simd::loadu(box + 20);
+        Simd::transpose(unused0, unused1, maxY, maxZ);
+
+        Simd::Float4 centerX = Simd::mul(Simd::add(maxX, minX), half);
+        Simd::Float4 centerY = Simd::mul(Simd::add(maxY, minY), half);
+        Simd::Float4 centerZ = Simd::mul(Simd::add(maxZ, minZ), half);
+        Simd::Float4 extentX = Simd::mul(Simd::sub(maxX, minX), half);
+        Simd::Float4 extentY = Simd::mul(Simd::sub(maxY, minY), half);
+        Simd::Float4 extentZ = Simd::mul(Simd::sub(maxZ, minZ), half);
+        Simd::Float4 outside = zero;
+
+        for (int j = 0; j < 6; j++) {
+            Simd::Float4 distance = Simd::madd(centerX, planeA[j], planeD[j]);
+            distance = Simd::madd(centerY, planeB[j], distance);
+            distance = Simd::madd(centerZ, planeC[j], distance);
+            distance = Simd::madd(extentX, absA[j], distance);
+            distance = Simd::madd(extentY, absB[j], distance);
+            distance = Simd::madd(extentZ, absC[j], distance);
+            outside = Simd::maskOr(outside, Simd::compareLess(distance, zero));
+        }
+
+        // Every index is written, only visible ones advance the output position
+        int mask = Simd::maskBits(outside);
+        for (int j = 0; j < 4; j++) {
+            visible[visibleCount] = i + j;
+            visibleCount += ((mask >> j) & 1) ^ 1;
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        visible[visibleCount] = i;
+        visibleCount += this->intersects(boxes[i]) ? 1 : 0;
+    }
+
+    return visibleCount;
+}
+
+MATH_INLINE std::size_t Frustum::cull(const Sphere* spheres, std::size_t count, std::size_t* visible) const {
+    MATH_PROBE(FRUSTUM_CULL, count);
+
+    static_assert(sizeof(Sphere) == sizeof(float) * 4, "Sphere is expected to be tightly packed");
+    std::size_t visibleCount = 0;
+    std::size_t i = 0;
+
+#if defined(MATH_SIMD)
+    Simd::Float4 planeA[6], planeB[6], planeC[6], planeD[6];
+
+    for (int j = 0; j < 6; j++) {
+        planeA[j] = Simd::splat(this->planes[j].get(Plane::A));
+        planeB[j] = Simd::splat(this->planes[j].get(Plane::B));
+        planeC[j] = Simd::splat(this->planes[j].get(Plane::C));
+        planeD[j] = Simd::splat(this->planes[j].get(Plane::D));
+    }
+
+    const float* source = reinterpret_cast<const float*>(spheres);
+    Simd::Float4 zero = Simd::splat(0.0f);
+
+    for (; i + 4 <= count; i += 4) {
+        const float* sphere = source + i * 4;
+        Simd::Float4 centerX = Simd::loadu(sphere);
+        Simd::Float4 centerY = Simd::loadu(sphere + 4);
+        Simd::Float4 centerZ = Simd::loadu(sphere + 8);
+        Simd::Float4 radius = Simd::loadu(sphere + 12);
+        Simd::transpose(centerX, centerY, centerZ, radius);
+        Simd::Float4 outside = zero;
+
+        for (int j = 0; j < 6; j++) {
+            Simd::Float4 distance = Simd::madd(centerX, planeA[j], planeD[j]);
+            distance = Simd::madd(centerY, planeB[j], distance);
+            distance = Simd::madd(centerZ, planeC[j], distance);
+            outside = Simd::maskOr(outside, Simd::compareLess(Simd::add(distance, radius), zero));
+        }
+
+        int mask = Simd::maskBits(outside);
+        for (int j = 0; j < 4; j++) {
+            visible[visibleCount] = i + j;
+            visibleCount += ((mask >> j) & 1) ^ 1;
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        visible[visibleCount] = i;
+        visibleCount += this->intersects(spheres[i]) ? 1 : 0;
+    }
+
+    return visibleCount;
+}
+
+MATH_INLINE const Plane& Frustum::getPlane(int index) const {
+    assert(index >= LEFT && index <= BACK);
+    return this->planes[index];
+}
+
+}  // namespace Math
+
+#endif  // FRUSTUM_INL
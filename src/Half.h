@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef HALF_H
+#define HALF_H
+
+#include <MathApi.h>
+#include <cstddef>
+
+namespace Math {
+
+/*!
+ * \brief IEEE 754 binary16 floating point storage type.
+ * \details Half keeps 16 bit storage and converts to float for arithmetic. It is
+ *          meant for packed GPU upload buffers, see Vec<N, Half>. Conversions round
+ *          to nearest even and keep infinities, NaNs and subnormals.
+ */
+class Half {
+public:
+    /*!
+     * \brief Default constructor.
+     * \details Constructs positive zero.
+     */
+    constexpr Half();
+
+    /*!
+     * \brief Float based constructor.
+     * \param value Converted value, out of range values become infinities.
+     */
+    MATH_API explicit Half(float value);
+
+    /*!
+     * \brief Float conversion.
+     * \return Exact float value.
+     */
+    MATH_API operator float() const;
+
+    /*!
+     * \brief Binary representation selector.
+     * \return 16 bit IEEE 754 representation.
+     */
+    constexpr unsigned short bits() const;
+
+    /*!
+     * \brief Binary representation based factory.
+     * \param bits 16 bit IEEE 754 representation.
+     * \return Half value.
+     */
+    static constexpr Half fromBits(unsigned short bits);
+
+    /*!
+     * \brief Batch float to half conversion.
+     * \param source Source floats.
+     * \param destination Converted halves.
+     * \param count Number of values.
+     * \note F16C or NEON conversion is used when available.
+     */
+    MATH_API static void pack(const float* source, Half* destination, std::size_t count);
+
+    /*!
+     * \brief Batch half to float conversion.
+     * \param source Source halves.
+     * \param destination Converted floats.
+     * \param count Number of values.
+     * \note F16C or NEON conversion is used when available.
+     */
+    MATH_API static void unpack(const Half* source, float* destination, std::size_t count);
+
+private:
+    unsigned short value;
+};
+
+constexpr Half::Half():
+        value(0) {
+}
+
+constexpr unsigned short Half::bits() const {
+    return this->value;
+}
+
+constexpr Half Half::fromBits(unsigned short bits) {
+    Half half;
+    half.value = bits;
+    return half;
+}
+
+}  // namespace Math
+
+#ifdef MATH_HEADER_ONLY
+#include <Half.inl>
+#endif
+
+#endif  // HALF_H
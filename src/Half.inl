@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef HALF_INL
+#define HALF_INL
+
+#include <Half.h>
+#include <MathSimd.h>
+#include <cstring>
+#include <cstdint>
+
+namespace Math {
+
+MATH_INLINE Half::Half(float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    std::uint32_t sign = (bits >> 16) & 0x8000u;
+    std::uint32_t magnitude = bits & 0x7fffffffu;
+
+    if (magnitude >= 0x7f800000u) {
+        // Infinity, or NaN with the payload truncated and the quiet bit set
+        std::uint32_t payload = (magnitude > 0x7f800000u) ? (0x200u | ((magnitude >> 13) & 0x3ffu)) : 0u;
+        this->value = static_cast<unsigned short>(sign | 0x7c00u | payload);
+    } else if (magnitude >= 0x477ff000u) {
+        // 65520 and above round beyond the largest finite half
+        this->value = static_cast<unsigned short>(sign | 0x7c00u);
+    } else if (magnitude < 0x38800000u) {
+        // Below 2^-14 the result is subnormal, mantissa is shifted into m * 2^-24
+        std::uint32_t exponent = magnitude >> 23;
+        std::uint32_t halfMantissa = 0;
+
+        if (exponent >= 102) {
+            std::uint32_t mantissa = (magnitude & 0x7fffffu) | 0x800000u;
+            std::uint32_t shift = 126 - exponent;
+            std::uint32_t remainder = mantissa & ((1u << shift) - 1);
+            std::uint32_t halfway = 1u << (shift - 1);
+
+            halfMantissa = mantissa >> shift;
+            if (remainder > halfway || (remainder == halfway && (halfMantissa & 1u))) {
+                halfMantissa++;
+            }
+        }
+
+        this->value = static_cast<unsigned short>(sign | halfMantissa);
+    } else {
+        // Rebias exponent from 127 to 15 and round the 13 dropped bits to nearest even
+        std::uint32_t rounded = magnitude + 0xfffu + ((magnitude >> 13) & 1u);
+        this->value = static_cast<unsigned short>(sign | ((rounded - 0x38000000u) >> 13));
+    }
+}
+
+MATH_INLINE Half::operator float() const {
+    std::uint32_t sign = static_cast<std::uint32_t>(this->value & 0x8000u) << 16;
+    std::uint32_t exponent = (this->value >> 10) & 0x1fu;
+    std::uint32_t mantissa = this->value & 0x3ffu;
+    std::uint32_t bits;
+
+    if (exponent == 0x1fu) {
+        bits = sign | 0x7f800000u | (mantissa << 13);
+    } else if (exponent != 0) {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    } else {
+        // Zero or subnormal m * 2^-24, exact in float
+        float magnitude = static_cast<float>(mantissa) * 5.9604644775390625e-8f;
+        std::memcpy(&bits, &magnitude, sizeof(bits));
+        bits |= sign;
+    }
+
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+MATH_INLINE void Half::pack(const float* source, Half* destination, std::size_t count) {
+    std::size_t i = 0;
+
+#if defined(MATH_F16C)
+    for (; i + 8 <= count; i += 8) {
+        __m128i packed = _mm256_cvtps_ph(_mm256_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), packed);
+    }
+#elif defined(MATH_NEON) && defined(__aarch64__)
+    for (; i + 4 <= count; i += 4) {
+        float16x4_t packed = vcvt_f16_f32(vld1q_f32(source + i));
+        vst1_u16(reinterpret_cast<std::uint16_t*>(destination + i), vreinterpret_u16_f16(packed));
+    }
+#endif
+
+    for (; i < count; i++) {
+        destination[i] = Half(source[i]);
+    }
+}
+
+MATH_INLINE void Half::unpack(const Half* source, float* destination, std::size_t count) {
+    std::size_t i = 0;
+
+#if defined(MATH_F16C)
+    for (; i + 8 <= count; i += 8) {
+        __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        _mm256_storeu_ps(destination + i, _mm256_cvtph_ps(packed));
+    }
+#elif defined(MATH_NEON) && defined(__aarch64__)
+    for (; i + 4 <= count; i += 4) {
+        float16x4_t packed = vreinterpret_f16_u16(vld1_u16(reinterpret_cast<const std::uint16_t*>(source + i)));
+        vst1q_f32(destination + i, vcvt_f32_f16(packed));
+    }
+#endif
+
+    for (; i < count; i++) {
+        destination[i] = source[i];
+    }
+}
+
+}  // namespace Math
+
+#endif  // HALF_INL
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <MathApi.h>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(MATH_INSTRUMENTATION)
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif !defined(__aarch64__)
+#include <chrono>
+#endif
+#endif
+
+/*
+ * Hot path probes, expand to nothing unless MATH_INSTRUMENTATION is defined (the
+ * elements expression is not evaluated either). Probe is an Instrumentation::Probe
+ * enumerator name. MATH_PROBE times a span lasting until the end of the enclosing
+ * scope, MATH_COUNT only counts single element calls too short to be timed.
+ */
+#if defined(MATH_INSTRUMENTATION)
+#define MATH_PROBE(probe, elements) \
+    Math::Instrumentation::Scope mathProbe(Math::Instrumentation::probe, static_cast<std::size_t>(elements))
+#define MATH_COUNT(probe) Math::Instrumentation::count(Math::Instrumentation::probe)
+#else
+#define MATH_PROBE(probe, elements)
+#define MATH_COUNT(probe)
+#endif
+
+namespace Math {
+
+/*!
+ * \brief Hot path counters and tracing hooks.
+ * \details Probed members count calls, elements processed and cycles spent per probe
+ *          when the library and its users are built with MATH_INSTRUMENTATION defined
+ *          (-DMATH_INSTRUMENTATION=ON). Cycles are TSC ticks on x86, virtual counter
+ *          ticks on AArch64 and nanoseconds elsewhere. Counters stay zero otherwise
+ *          and probes compile to nothing. Batch spans can also be forwarded to a
+ *          profiler, they nest per thread so begin and end hooks may keep a thread
+ *          local stack of Tracy zone contexts or emit perfetto TRACE_EVENT_BEGIN and
+ *          TRACE_EVENT_END. Single element probes (Mat4::invert(), Mat4::decompose()
+ *          and Quaternion::normalize()) count calls only, timing them would cost more
+ *          than the call itself and flood the trace.
+ */
+class Instrumentation {
+public:
+    enum Probe {
+        MAT4_INVERT,                  /*!< Mat4::invert(), counted only */
+        MAT4_DECOMPOSE,               /*!< Mat4::decompose(), counted only */
+        MAT4_INVERT_BATCH,            /*!< Mat4::invert(const Mat4*, Mat4*, std::size_t, Layout) */
+        MAT4_MULTIPLY_BATCH,          /*!< Mat4::multiply() */
+        MAT4_TRANSFORM_BATCH,         /*!< Mat4::transform(), transformPoints() and transformDirections() */
+        QUATERNION_NORMALIZE,         /*!< Quaternion::normalize(), counted only */
+        QUATERNION_ROTATE_BATCH,      /*!< Quaternion::rotate(const Vec3*, Vec3*, std::size_t) */
+        QUATERNION_INTERPOLATE_BATCH, /*!< Quaternion batch slerp() and nlerp() */
+        QUATERNION_CONVERT_BATCH,     /*!< Quaternion batch extractMat4(), fromMat4() and extractEulerAngles() */
+        VEC_SOA_DOT,                  /*!< Vec3SoA::dot() and Vec4SoA::dot() */
+        VEC_SOA_NORMALIZE,            /*!< Vec3SoA::normalize() */
+        DUAL_QUATERNION_SKIN,         /*!< DualQuaternion::skin() */
+        FRUSTUM_CULL,                 /*!< Frustum::cull() */
+        TRANSFORM_HIERARCHY_UPDATE,   /*!< TransformHierarchy::update() */
+        PROBE_COUNT
+    };
+
+    struct Counters {
+        std::uint64_t calls;
+        std::uint64_t elements;
+        std::uint64_t cycles;
+    };
+
+    typedef void (*BeginHook)(Probe probe, void* context);
+    typedef void (*EndHook)(Probe probe, std::size_t elements, void* context);
+
+    /*!
+     * \brief Probe counters selector.
+     * \param probe Probe.
+     * \return Counters accumulated since start or the last reset().
+     * \note There is an assert for probe range.
+     */
+    MATH_API static Counters get(Probe probe);
+
+    /*!
+     * \brief Reset probe counters.
+     * \details Calling it once per frame after reading the counters gives per frame
+     *          math budget.
+     */
+    MATH_API static void reset();
+
+    /*!
+     * \brief Set span hooks.
+     * \param begin Called when a probe span starts, nullptr disables.
+     * \param end Called when a probe span ends, nullptr disables.
+     * \param context Opaque pointer passed to the hooks.
+     * \note Hooks are not synchronized with running spans, set them before work is spawned.
+     */
+    MATH_API static void setHooks(BeginHook begin, EndHook end, void* context);
+
+    /*!
+     * \brief Probe name selector.
+     * \param probe Probe.
+     * \return Static name, such as "Mat4::invert".
+     * \note There is an assert for probe range.
+     */
+    MATH_API static const char* getName(Probe probe);
+
+    /*!
+     * \brief Count a single element call.
+     * \param probe Probe, see MATH_COUNT.
+     */
+    MATH_API static void count(Probe probe);
+
+#if defined(MATH_INSTRUMENTATION)
+    static std::uint64_t now() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        std::uint64_t ticks;
+        __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(ticks));
+        return ticks;
+#else
+        auto time = std::chrono::steady_clock::now().time_since_epoch();
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count());
+#endif
+    }
+
+    class Scope {
+    public:
+        Scope(Probe probe, std::size_t elements):
+                probe(probe),
+                elements(elements) {
+            Instrumentation::begin(probe);
+            this->start = Instrumentation::now();
+        }
+
+        ~Scope() {
+            Instrumentation::end(this->probe, this->elements, Instrumentation::now() - this->start);
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator =(const Scope&) = delete;
+
+    private:
+        Probe probe;
+        std::size_t elements;
+        std::uint64_t start;
+    };
+#endif
+
+private:
+    struct State;
+
+    static State& getState();
+
+    MATH_API static void begin(Probe probe);
+    MATH_API static void end(Probe probe, std::size_t elements, std::uint64_t cycles);
+};
+
+}  // namespace Math
+
+#ifdef MATH_HEADER_ONLY
+#include <Instrumentation.inl>
+#endif
+
+#endif  // INSTRUMENTATION_H
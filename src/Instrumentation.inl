@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INSTRUMENTATION_INL
+#define INSTRUMENTATION_INL
+
+#include <Instrumentation.h>
+#include <atomic>
+#include <cassert>
+
+namespace Math {
+
+struct Instrumentation::State {
+    // Probes updated from different threads do not share cache lines
+    struct alignas(64) Totals {
+        std::atomic<std::uint64_t> calls { 0 };
+        std::atomic<std::uint64_t> elements { 0 };
+        std::atomic<std::uint64_t> cycles { 0 };
+    };
+
+    Totals probes[PROBE_COUNT];
+    BeginHook begin = nullptr;
+    EndHook end = nullptr;
+    void* context = nullptr;
+};
+
+MATH_INLINE Instrumentation::Counters Instrumentation::get(Probe probe) {
+    assert(probe >= 0 && probe < PROBE_COUNT);
+    const State::Totals& counters = Instrumentation::getState().probes[probe];
+
+    Counters result = {
+        counters.calls.load(std::memory_order_relaxed),
+        counters.elements.load(std::memory_order_relaxed),
+        counters.cycles.load(std::memory_order_relaxed)
+    };
+
+    return result;
+}
+
+MATH_INLINE void Instrumentation::reset() {
+    for (State::Totals& counters: Instrumentation::getState().probes) {
+        counters.calls.store(0, std::memory_order_relaxed);
+        counters.elements.store(0, std::memory_order_relaxed);
+        counters.cycles.store(0, std::memory_order_relaxed);
+    }
+}
+
+MATH_INLINE void Instrumentation::setHooks(BeginHook begin, EndHook end, void* context) {
+    State& state = Instrumentation::getState();
+    state.begin = begin;
+    state.end = end;
+    state.context = context;
+}
+
+MATH_INLINE const char* Instrumentation::getName(Probe probe) {
+    assert(probe >= 0 && probe < PROBE_COUNT);
+
+    static const char* const names[PROBE_COUNT] = {
+        "Mat4::invert",
+        "Mat4::decompose",
+        "Mat4::invert/batch",
+        "Mat4::multiply/batch",
+        "Mat4::transform/batch",
+        "Quaternion::normalize",
+        "Quaternion::rotate/batch",
+        "Quaternion::interpolate/batch",
+        "Quaternion::convert/batch",
+        "VecSoA::dot",
+        "VecSoA::normalize",
+        "DualQuaternion::skin",
+        "Frustum::cull",
+        "TransformHierarchy::update"
+    };
+
+    return names[probe];
+}
+
+MATH_INLINE void Instrumentation::count(Probe probe) {
+    State::Totals& counters = Instrumentation::getState().probes[probe];
+    counters.calls.fetch_add(1, std::memory_order_relaxed);
+    counters.elements.fetch_add(1, std::memory_order_relaxed);
+}
+
+MATH_INLINE Instrumentation::State& Instrumentation::getState() {
+    // Constant initialized, probes running in static constructors are counted too
+    static State state;
+    return state;
+}
+
+MATH_INLINE void Instrumentation::begin(Probe probe) {
+    const State& state = Instrumentation::getState();
+    if (state.begin != nullptr) {
+        state.begin(probe, state.context);
+    }
+}
+
+MATH_INLINE void Instrumentation::end(Probe probe, std::size_t elements, std::uint64_t cycles) {
+    State& state = Instrumentation::getState();
+    if (state.end != nullptr) {
+        state.end(probe, elements, state.context);
+    }
+
+    State::Totals& counters = state.probes[probe];
+    counters.calls.fetch_add(1, std::memory_order_relaxed);
+    counters.elements.fetch_add(elements, std::memory_order_relaxed);
+    counters.cycles.fetch_add(cycles, std::memory_order_relaxed);
+}
+
+}  // namespace Math
+
+#endif  // INSTRUMENTATION_INL
@@ -0,0 +1,395 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef KERNELS_INL
+#define KERNELS_INL
+
+/*
+ * Batch kernels compiled once per instruction set. Each including translation unit
+ * picks the namespace through MATH_KERNELS_ISA and its own compiler flags, kernels
+ * must only use Simd wrappers (Simd::MATH_SIMD_ISA is distinct for every flag set)
+ * and no other inline library code to keep the instruction sets apart.
+ */
+#include <Dispatch.h>
+#include <MathSimd.h>
+#include <Unroll.h>
+#include <algorithm>
+#include <cmath>
+
+#if !defined(MATH_KERNELS_ISA)
+#define MATH_KERNELS_ISA Native
+#endif
+
+namespace Math {
+
+namespace Kernels {
+
+namespace MATH_KERNELS_ISA {
+
+inline void transform(const float* matrix, const float* source, std::size_t sourceStride,
+        float* destination, std::size_t destinationStride, std::size_t count) {
+#if defined(MATH_SIMD)
+    Simd::Float4 column0 = Simd::load(matrix);
+    Simd::Float4 column1 = Simd::load(matrix + 4);
+    Simd::Float4 column2 = Simd::load(matrix + 8);
+    Simd::Float4 column3 = Simd::load(matrix + 12);
+    Simd::transpose(column0, column1, column2, column3);
+
+    for (std::size_t i = 0; i < count; i++) {
+        Simd::Float4 vector = Simd::loadu(source);
+        Simd::Float4 product = Simd::mul(column0, Simd::broadcast<0>(vector));
+        product = Simd::madd(column1, Simd::broadcast<1>(vector), product);
+        product = Simd::madd(column2, Simd::broadcast<2>(vector), product);
+        product = Simd::madd(column3, Simd::broadcast<3>(vector), product);
+        Simd::storeu(destination, product);
+
+        source += sourceStride;
+        destination += destinationStride;
+    }
+#else
+    for (std::size_t i = 0; i < count; i++) {
+        float x = source[0];
+        float y = source[1];
+        float z = source[2];
+        float w = source[3];
+
+        for (int j = 0; j < 4; j++) {
+            const float* row = matrix + j * 4;
+            destination[j] = row[0] * x + row[1] * y + row[2] * z + row[3] * w;
+        }
+
+        source += sourceStride;
+        destination += destinationStride;
+    }
+#endif
+}
+
+inline void transformVec3(const float* matrix, const float* source, std::size_t sourceStride,
+        float* destination, std::size_t destinationStride, std::size_t count, float w) {
+#if defined(MATH_SIMD)
+    Simd::Float4 column0 = Simd::load(matrix);
+    Simd::Float4 column1 = Simd::load(matrix + 4);
+    Simd::Float4 column2 = Simd::load(matrix + 8);
+    Simd::Float4 column3 = Simd::load(matrix + 12);
+    Simd::transpose(column0, column1, column2, column3);
+    Simd::Float4 offset = Simd::mul(column3, Simd::splat(w));
+
+    for (std::size_t i = 0; i < count; i++) {
+        Simd::Float4 product = Simd::madd(column0, Simd::splat(source[0]), offset);
+        product = Simd::madd(column1, Simd::splat(source[1]), product);
+        product = Simd::madd(column2, Simd::splat(source[2]), product);
+        Simd::store3(destination, product);
+
+        source += sourceStride;
+        destination += destinationStride;
+    }
+#else
+    float offset[3] = {
+        matrix[3] * w,
+        matrix[7] * w,
+        matrix[11] * w
+    };
+
+    for (std::size_t i = 0; i < count; i++) {
+        float x = source[0];
+        float y = source[1];
+        float z = source[2];
+
+        for (int j = 0; j < 3; j++) {
+            const float* row = matrix + j * 4;
+            destination[j] = row[0] * x + row[1] * y + row[2] * z + offset[j];
+        }
+
+        source += sourceStride;
+        destination += destinationStride;
+    }
+#endif
+}
+
+inline void multiply(const float* matrix, const float* matrices, float* result, std::size_t count, bool transpose) {
+#if defined(MATH_SIMD)
+    Simd::Float4 left[4][4];
+
+    unroll<4>([&](int i) {
+        Simd::Float4 row = Simd::load(matrix + i * 4);
+        left[i][0] = Simd::broadcast<0>(row);
+        left[i][1] = Simd::broadcast<1>(row);
+        left[i][2] = Simd::broadcast<2>(row);
+        left[i][3] = Simd::broadcast<3>(row);
+    });
+
+    for (std::size_t k = 0; k < count; k++) {
+        Simd::Float4 row0 = Simd::load(matrices);
+        Simd::Float4 row1 = Simd::load(matrices + 4);
+        Simd::Float4 row2 = Simd::load(matrices + 8);
+        Simd::Float4 row3 = Simd::load(matrices + 12);
+        Simd::Float4 product[4];
+
+        unroll<4>([&](int i) {
+            product[i] = Simd::mul(left[i][0], row0);
+            product[i] = Simd::madd(left[i][1], row1, product[i]);
+            product[i] = Simd::madd(left[i][2], row2, product[i]);
+            product[i] = Simd::madd(left[i][3], row3, product[i]);
+        });
+
+        if (transpose) {
+            Simd::transpose(product[0], product[1], product[2], product[3]);
+        }
+
+        unroll<4>([&](int i) {
+            Simd::store(result + i * 4, product[i]);
+        });
+
+        matrices += 16;
+        result += 16;
+    }
+#else
+    // Both operands are read before the store, the same as the SIMD path, so result may alias either
+    float left[16];
+    std::copy(matrix, matrix + 16, left);
+
+    for (std::size_t k = 0; k < count; k++) {
+        float product[16];
+
+        for (int i = 0; i < 4; i++) {
+            for (int j = 0; j < 4; j++) {
+                product[i * 4 + j] = 0.0f;
+                for (int l = 0; l < 4; l++) {
+                    product[i * 4 + j] += left[i * 4 + l] * matrices[l * 4 + j];
+                }
+            }
+        }
+
+        for (int i = 0; i < 4; i++) {
+            for (int j = 0; j < 4; j++) {
+                result[transpose ? j * 4 + i : i * 4 + j] = product[i * 4 + j];
+            }
+        }
+
+        matrices += 16;
+        result += 16;
+    }
+#endif
+}
+
+inline std::size_t invert(const float* matrices, float* result, std::size_t count, bool transpose) {
+    std::size_t k = 0;
+
+#if defined(MATH_SIMD)
+    // Cofactor expansion of Mat4::invert(), lane l of m[i][j] holds element (i, j) of matrix k + l
+    for (; k + 4 <= count; k += 4) {
+        const float* source = matrices + k * 16;
+        float* destination = result + k * 16;
+        Simd::Float4 m[4][4];
+
+        unroll<4>([&](int i) {
+            m[i][0] = Simd::load(source + i * 4);
+            m[i][1] = Simd::load(source + 16 + i * 4);
+            m[i][2] = Simd::load(source + 32 + i * 4);
+            m[i][3] = Simd::load(source + 48 + i * 4);
+            Simd::transpose(m[i][0], m[i][1], m[i][2], m[i][3]);
+        });
+
+        auto difference = [](Simd::Float4 a, Simd::Float4 b, Simd::Float4 c, Simd::Float4 d) {
+            return Simd::sub(Simd::mul(a, b), Simd::mul(c, d));
+        };
+
+        auto cofactor = [](Simd::Float4 a, Simd::Float4 b, Simd::Float4 c, Simd::Float4 d,
+                Simd::Float4 e, Simd::Float4 f, Simd::Float4 scale) {
+            return Simd::mul(Simd::add(Simd::sub(Simd::mul(a, b), Simd::mul(c, d)), Simd::mul(e, f)), scale);
+        };
+
+        Simd::Float4 s0 = difference(m[0][0], m[1][1], m[1][0], m[0][1]);
+        Simd::Float4 s1 = difference(m[0][0], m[1][2], m[1][0], m[0][2]);
+        Simd::Float4 s2 = difference(m[0][0], m[1][3], m[1][0], m[0][3]);
+        Simd::Float4 s3 = difference(m[0][1], m[1][2], m[1][1], m[0][2]);
+        Simd::Float4 s4 = difference(m[0][1], m[1][3], m[1][1], m[0][3]);
+        Simd::Float4 s5 = difference(m[0][2], m[1][3], m[1][2], m[0][3]);
+
+        Simd::Float4 c0 = difference(m[2][0], m[3][1], m[3][0], m[2][1]);
+        Simd::Float4 c1 = difference(m[2][0], m[3][2], m[3][0], m[2][2]);
+        Simd::Float4 c2 = difference(m[2][0], m[3][3], m[3][0], m[2][3]);
+        Simd::Float4 c3 = difference(m[2][1], m[3][2], m[3][1], m[2][2]);
+        Simd::Float4 c4 = difference(m[2][1], m[3][3], m[3][1], m[2][3]);
+        Simd::Float4 c5 = difference(m[2][2], m[3][3], m[3][2], m[2][3]);
+
+        Simd::Float4 determinant = Simd::add(Simd::sub(Simd::mul(s0, c5), Simd::mul(s1, c4)), Simd::mul(s2, c3));
+        determinant = Simd::add(Simd::sub(Simd::add(determinant, Simd::mul(s3, c2)), Simd::mul(s4, c1)),
+                Simd::mul(s5, c0));
+
+        Simd::Float4 p = Simd::div(Simd::splat(1.0f), determinant);
+        Simd::Float4 n = Simd::sub(Simd::splat(0.0f), p);
+
+        Simd::Float4 inverse[4][4] = {
+            {
+                cofactor(m[1][1], c5, m[1][2], c4, m[1][3], c3, p),
+                cofactor(m[0][1], c5, m[0][2], c4, m[0][3], c3, n),
+                cofactor(m[3][1], s5, m[3][2], s4, m[3][3], s3, p),
+                cofactor(m[2][1], s5, m[2][2], s4, m[2][3], s3, n)
+            },
+            {
+                cofactor(m[1][0], c5, m[1][2], c2, m[1][3], c1, n),
+                cofactor(m[0][0], c5, m[0][2], c2, m[0][3], c1, p),
+                cofactor(m[3][0], s5, m[3][2], s2, m[3][3], s1, n),
+                cofactor(m[2][0], s5, m[2][2], s2, m[2][3], s1, p)
+            },
+            {
+                cofactor(m[1][0], c4, m[1][1], c2, m[1][3], c0, p),
+                cofactor(m[0][0], c4, m[0][1], c2, m[0][3], c0, n),
+                cofactor(m[3][0], s4, m[3][1], s2, m[3][3], s0, p),
+                cofactor(m[2][0], s4, m[2][1], s2, m[2][3], s0, n)
+            },
+            {
+                cofactor(m[1][0], c3, m[1][1], c1, m[1][2], c0, n),
+                cofactor(m[0][0], c3, m[0][1], c1, m[0][2], c0, p),
+                cofactor(m[3][0], s3, m[3][1], s1, m[3][2], s0, n),
+                cofactor(m[2][0], s3, m[2][1], s1, m[2][2], s0, p)
+            }
+        };
+
+        // Transposing back to one matrix per register, transposed result just swaps the grid
+        unroll<4>([&](int i) {
+            Simd::Float4 row0 = transpose ? inverse[0][i] : inverse[i][0];
+            Simd::Float4 row1 = transpose ? inverse[1][i] : inverse[i][1];
+            Simd::Float4 row2 = transpose ? inverse[2][i] : inverse[i][2];
+            Simd::Float4 row3 = transpose ? inverse[3][i] : inverse[i][3];
+            Simd::transpose(row0, row1, row2, row3);
+
+            Simd::store(destination + i * 4, row0);
+            Simd::store(destination + 16 + i * 4, row1);
+            Simd::store(destination + 32 + i * 4, row2);
+            Simd::store(destination + 48 + i * 4, row3);
+        });
+    }
+#else
+    static_cast<void>(matrices);
+    static_cast<void>(result);
+    static_cast<void>(count);
+    static_cast<void>(transpose);
+#endif
+
+    // Remaining matrices are left to the scalar Mat4::invert()
+    return k;
+}
+
+inline void dot3(const float* const* left, const float* const* right, float* result,
+        std::size_t first, std::size_t end) {
+    const float* x = left[0];
+    const float* y = left[1];
+    const float* z = left[2];
+    const float* otherX = right[0];
+    const float* otherY = right[1];
+    const float* otherZ = right[2];
+    std::size_t i = first;
+
+#if defined(MATH_SIMD)
+    for (; i + 4 <= end; i += 4) {
+        Simd::Float4 product = Simd::mul(Simd::load(x + i), Simd::load(otherX + i));
+        product = Simd::madd(Simd::load(y + i), Simd::load(otherY + i), product);
+        product = Simd::madd(Simd::load(z + i), Simd::load(otherZ + i), product);
+        Simd::storeu(result + i, product);
+    }
+#endif
+
+    for (; i < end; i++) {
+        result[i] = x[i] * otherX[i] + y[i] * otherY[i] + z[i] * otherZ[i];
+    }
+}
+
+inline void dot4(const float* const* left, const float* const* right, float* result,
+        std::size_t first, std::size_t end) {
+    const float* x = left[0];
+    const float* y = left[1];
+    const float* z = left[2];
+    const float* w = left[3];
+    const float* otherX = right[0];
+    const float* otherY = right[1];
+    const float* otherZ = right[2];
+    const float* otherW = right[3];
+    std::size_t i = first;
+
+#if defined(MATH_SIMD)
+    for (; i + 4 <= end; i += 4) {
+        Simd::Float4 product = Simd::mul(Simd::load(x + i), Simd::load(otherX + i));
+        product = Simd::madd(Simd::load(y + i), Simd::load(otherY + i), product);
+        product = Simd::madd(Simd::load(z + i), Simd::load(otherZ + i), product);
+        product = Simd::madd(Simd::load(w + i), Simd::load(otherW + i), product);
+        Simd::storeu(result + i, product);
+    }
+#endif
+
+    for (; i < end; i++) {
+        result[i] = x[i] * otherX[i] + y[i] * otherY[i] + z[i] * otherZ[i] + w[i] * otherW[i];
+    }
+}
+
+inline void normalize3(float* const* streams, std::size_t first, std::size_t end) {
+    float* x = streams[0];
+    float* y = streams[1];
+    float* z = streams[2];
+    std::size_t i = first;
+
+#if defined(MATH_SIMD)
+    for (; i + 4 <= end; i += 4) {
+        Simd::Float4 vectorX = Simd::load(x + i);
+        Simd::Float4 vectorY = Simd::load(y + i);
+        Simd::Float4 vectorZ = Simd::load(z + i);
+        Simd::Float4 length = Simd::mul(vectorX, vectorX);
+        length = Simd::madd(vectorY, vectorY, length);
+        length = Simd::madd(vectorZ, vectorZ, length);
+        length = Simd::sqrt(length);
+        Simd::store(x + i, Simd::div(vectorX, length));
+        Simd::store(y + i, Simd::div(vectorY, length));
+        Simd::store(z + i, Simd::div(vectorZ, length));
+    }
+#endif
+
+    for (; i < end; i++) {
+        float length = sqrtf(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+        x[i] /= length;
+        y[i] /= length;
+        z[i] /= length;
+    }
+}
+
+#if defined(MATH_HEADER_ONLY)
+inline constexpr KernelTable table = {
+#else
+extern const KernelTable table;
+const KernelTable table = {
+#endif
+    transform,
+    transformVec3,
+    multiply,
+    invert,
+    dot3,
+    dot4,
+    normalize3
+};
+
+}  // namespace MATH_KERNELS_ISA
+
+}  // namespace Kernels
+
+}  // namespace Math
+
+#endif  // KERNELS_INL
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LU_H
+#define LU_H
+
+#include <cstddef>
+
+namespace Math {
+
+/*!
+ * \brief Compile time sized LU factorization template.
+ * \details LU<N, T> factorizes P * A = L * U with partial (row) pivoting. Unit lower
+ *          triangular L and upper triangular U are packed into a single N x N array,
+ *          row permutation P is kept as a vector of source row indices. Factorization
+ *          cost is paid once, every solve() afterwards is a forward and backward
+ *          substitution. References:
+ *           * http://en.wikipedia.org/wiki/LU_decomposition#LU_factorization_with_partial_pivoting
+ *
+ *          Pivot which magnitude is below N * epsilon of the largest matrix component
+ *          marks the factorization as singular, subsequent solves fail instead of
+ *          producing infinities and NaNs. LU3 and LU4 wrap LU<3, float> and
+ *          LU<4, float>.
+ */
+template<int N, typename T>
+class LU {
+public:
+    static_assert(N > 0, "Matrix dimension must be positive");
+
+    typedef T Type;  /*!< Component type. */
+
+    enum {
+        Size = N  /*!< Number of rows and columns. */
+    };
+
+    /*!
+     * \brief Default constructor.
+     * \details Constructs the identity matrix factorization.
+     */
+    constexpr LU();
+
+    /*!
+     * \brief Factorizing constructor.
+     * \param data Pointer to N x N row-major matrix components.
+     */
+    explicit constexpr LU(const T* data);
+
+    /*!
+     * \brief Singularity check.
+     * \return true if a pivot has vanished during factorization, false otherwise.
+     */
+    constexpr bool isSingular() const;
+
+    /*!
+     * \brief Matrix determinant calculation.
+     * \return Product of U diagonal with the permutation sign, 0 if matrix is singular.
+     */
+    constexpr T determinant() const;
+
+    /*!
+     * \brief Solve matrix equation A * X = B.
+     * \param absolute Pointer to N absolute values.
+     * \param solution Pointer to N unknown values.
+     * \return false if matrix is singular and solution is left untouched, true otherwise.
+     * \note solution may alias absolute.
+     */
+    constexpr bool solve(const T* absolute, T* solution) const;
+
+    /*!
+     * \brief Solve matrix equation A * X = B for a batch of absolute vectors.
+     * \param absolute Pointer to count * N absolute values.
+     * \param solution Pointer to count * N unknown values.
+     * \param count Number of vectors.
+     * \return false if matrix is singular and solution is left untouched, true otherwise.
+     * \note solution may alias absolute.
+     */
+    constexpr bool solve(const T* absolute, T* solution, std::size_t count) const;
+
+    /*!
+     * \brief Packed factorization component selector.
+     * \param row Component's row.
+     * \param column Component's column.
+     * \return L component below the diagonal (unit diagonal is implied), U otherwise.
+     * \note There are asserts for row and column bounds.
+     */
+    constexpr T get(int row, int column) const;
+
+    /*!
+     * \brief Row permutation selector.
+     * \param row Row of the factorized matrix.
+     * \return Row of the source matrix that was pivoted into row.
+     * \note There is an assert for row bounds.
+     */
+    constexpr int getPivot(int row) const;
+
+    /*!
+     * \brief Packed factorization data accessor.
+     * \return Pointer to N x N row-major L\\U components.
+     */
+    constexpr const T* data() const;
+
+private:
+    static constexpr T magnitude(T value);
+
+    constexpr void factorize();
+    constexpr void substitute(const T* absolute, T* solution) const;
+
+    T lu[N][N];
+    T inverseDiagonal[N];
+    int pivots[N];
+    int sign;
+    bool singular;
+};
+
+typedef LU<3, double> LU3d;  /*!< 3x3 double precision factorization. */
+typedef LU<4, double> LU4d;  /*!< 4x4 double precision factorization. */
+
+}  // namespace Math
+
+// Templates are always defined in headers, MATH_HEADER_ONLY makes no difference here
+#include <LU.inl>
+
+#endif  // LU_H
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LU_INL
+#define LU_INL
+
+#include <LU.h>
+#include <Unroll.h>
+#include <limits>
+#include <cassert>
+
+namespace Math {
+
+template<int N, typename T>
+constexpr LU<N, T>::LU():
+        lu(),
+        inverseDiagonal(),
+        pivots(),
+        sign(1),
+        singular(false) {
+    unroll<N>([&](int i) {
+        this->lu[i][i] = static_cast<T>(1);
+        this->inverseDiagonal[i] = static_cast<T>(1);
+        this->pivots[i] = i;
+    });
+}
+
+template<int N, typename T>
+constexpr LU<N, T>::LU(const T* data):
+        lu(),
+        inverseDiagonal(),
+        pivots(),
+        sign(1),
+        singular(false) {
+    unroll<N>([&](int i) {
+        unroll<N>([&](int j) { this->lu[i][j] = data[i * N + j]; });
+        this->pivots[i] = i;
+    });
+
+    this->factorize();
+}
+
+template<int N, typename T>
+constexpr bool LU<N, T>::isSingular() const {
+    return this->singular;
+}
+
+template<int N, typename T>
+constexpr T LU<N, T>::determinant() const {
+    if (this->singular) {
+        return static_cast<T>(0);
+    }
+
+    T determinant = static_cast<T>(this->sign);
+    unroll<N>([&](int i) { determinant *= this->lu[i][i]; });
+    return determinant;
+}
+
+template<int N, typename T>
+constexpr bool LU<N, T>::solve(const T* absolute, T* solution) const {
+    if (this->singular) {
+        return false;
+    }
+
+    this->substitute(absolute, solution);
+    return true;
+}
+
+template<int N, typename T>
+constexpr bool LU<N, T>::solve(const T* absolute, T* solution, std::size_t count) const {
+    if (this->singular) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < count; i++) {
+        this->substitute(absolute + i * N, solution + i * N);
+    }
+
+    return true;
+}
+
+template<int N, typename T>
+constexpr T LU<N, T>::get(int row, int column) const {
+    assert(row >= 0 && row < N);
+    assert(column >= 0 && column < N);
+    return this->lu[row][column];
+}
+
+template<int N, typename T>
+constexpr int LU<N, T>::getPivot(int row) const {
+    assert(row >= 0 && row < N);
+    return this->pivots[row];
+}
+
+template<int N, typename T>
+constexpr const T* LU<N, T>::data() const {
+    return &this->lu[0][0];
+}
+
+template<int N, typename T>
+constexpr T LU<N, T>::magnitude(T value) {
+    // Sign test compiles to a branch mispredicted on random data, max(x, -x) does not
+    return (value > -value) ? value : -value;
+}
+
+template<int N, typename T>
+constexpr void LU<N, T>::factorize() {
+    T scale = static_cast<T>(0);
+    unroll<N>([&](int i) {
+        unroll<N>([&](int j) {
+            T magnitude = LU::magnitude(this->lu[i][j]);
+            scale = (magnitude > scale) ? magnitude : scale;
+        });
+    });
+
+    T tolerance = scale * static_cast<T>(N) * std::numeric_limits<T>::epsilon();
+
+    // Every index is a compile time constant and row swaps are selects, so the matrix
+    // stays in registers and there are no data dependent branches to mispredict
+    unroll<N>([&](auto k) {
+        if (this->singular) {
+            return;
+        }
+
+        int pivot = k;
+        T pivotMagnitude = LU::magnitude(this->lu[k][k]);
+        unroll<N - 1 - k>([&](int offset) {
+            int i = k + 1 + offset;
+            T magnitude = LU::magnitude(this->lu[i][k]);
+            bool larger = magnitude > pivotMagnitude;
+            pivot = larger ? i : pivot;
+            pivotMagnitude = larger ? magnitude : pivotMagnitude;
+        });
+
+        // Zero matrix has zero tolerance, comparison still has to fail
+        if (!(pivotMagnitude > tolerance)) {
+            this->singular = true;
+            return;
+        }
+
+        unroll<N - 1 - k>([&](int offset) {
+            int i = k + 1 + offset;
+            bool swap = (i == pivot);
+
+            unroll<N>([&](int j) {
+                T upper = this->lu[k][j];
+                T lower = this->lu[i][j];
+                this->lu[k][j] = swap ? lower : upper;
+                this->lu[i][j] = swap ? upper : lower;
+            });
+
+            int upperPivot = this->pivots[k];
+            int lowerPivot = this->pivots[i];
+            this->pivots[k] = swap ? lowerPivot : upperPivot;
+            this->pivots[i] = swap ? upperPivot : lowerPivot;
+        });
+
+        this->sign = (pivot != k) ? -this->sign : this->sign;
+        this->inverseDiagonal[k] = static_cast<T>(1) / this->lu[k][k];
+
+        unroll<N - 1 - k>([&](int offset) {
+            int i = k + 1 + offset;
+            T factor = this->lu[i][k] * this->inverseDiagonal[k];
+            this->lu[i][k] = factor;
+            unroll<N - 1 - k>([&](int column) {
+                int j = k + 1 + column;
+                this->lu[i][j] -= factor * this->lu[k][j];
+            });
+        });
+    });
+}
+
+template<int N, typename T>
+constexpr void LU<N, T>::substitute(const T* absolute, T* solution) const {
+    T values[N] = {};
+
+    // Forward substitution with unit diagonal L, absolute values are read in pivot order
+    unroll<N>([&](auto i) {
+        T value = absolute[this->pivots[i]];
+        unroll<i>([&](int j) { value -= this->lu[i][j] * values[j]; });
+        values[i] = value;
+    });
+
+    // Backward substitution with U, diagonal division is replaced by multiplication
+    unroll<N>([&](auto step) {
+        constexpr int i = N - 1 - decltype(step)::value;
+        T value = values[i];
+        unroll<N - 1 - i>([&](int offset) { value -= this->lu[i][i + 1 + offset] * values[i + 1 + offset]; });
+        values[i] = value * this->inverseDiagonal[i];
+    });
+
+    unroll<N>([&](int i) { solution[i] = values[i]; });
+}
+
+}  // namespace Math
+
+#endif  // LU_INL
@@ -0,0 +1,548 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LAZY_H
+#define LAZY_H
+
+#include <Vec3.h>
+#include <Vec4.h>
+#include <Mat3.h>
+#include <Mat4.h>
+#include <MathSimd.h>
+#include <type_traits>
+
+namespace Math {
+
+/*!
+ * \brief Opt-in expression templates.
+ * \details Products, sums, differences and scalings involving a lazy() operand build
+ *          an expression tree instead of intermediate matrices. The tree is evaluated
+ *          once, when converted to Mat3, Mat4, Vec3 or Vec4:
+ *
+ *              Mat4 mvp = lazy(projection) * view * model;
+ *              Vec4 position = lazy(projection) * view * model * vertex;
+ *              Mat4 blend = lazy(left) * 0.25f + lazy(right) * 0.75f;
+ *
+ *          Matrix results are evaluated row by row, every row of a product chain is a
+ *          row vector passed from the leftmost operand through the rest of the chain.
+ *          Vector results are evaluated right to left the same way, so no temporary
+ *          matrices are ever formed.
+ *
+ * \note Expressions refer to their operands, evaluate them within the full expression
+ *       which created them.
+ */
+namespace Lazy {
+
+/*!
+ * \brief Lazy operand traits.
+ * \details Specialized for types which may appear in expressions.
+ */
+template<typename T>
+struct Traits {
+};
+
+template<>
+struct Traits<Vec3> {
+    enum { Rows = 3, Columns = 1 };
+};
+
+template<>
+struct Traits<Vec4> {
+    enum { Rows = 4, Columns = 1 };
+};
+
+template<>
+struct Traits<Mat3> {
+    enum { Rows = 3, Columns = 3 };
+};
+
+template<>
+struct Traits<Mat4> {
+    enum { Rows = 4, Columns = 4 };
+};
+
+/*!
+ * \brief Expression result type.
+ * \details Maps expression dimensions to the type it is evaluated to.
+ */
+template<int Rows, int Columns>
+struct Result {
+};
+
+template<>
+struct Result<3, 1> {
+    typedef Vec3 Type;
+    static Vec3 make(const float* data) { return Vec3(data[0], data[1], data[2]); }
+};
+
+template<>
+struct Result<4, 1> {
+    typedef Vec4 Type;
+    static Vec4 make(const float* data) { return Vec4(data[0], data[1], data[2], data[3]); }
+};
+
+template<>
+struct Result<3, 3> {
+    typedef Mat3 Type;
+    static Mat3 make(const float* data) { return Mat3(data); }
+};
+
+template<>
+struct Result<4, 4> {
+    typedef Mat4 Type;
+    static Mat4 make(const float* data) { return Mat4(data); }
+};
+
+/*!
+ * \brief Dense row-major kernels.
+ * \details leftMultiply() computes the row vector source * matrix, rightMultiply()
+ *          computes the column vector matrix * source.
+ */
+template<int Rows, int Columns>
+struct Kernel {
+    static void row(const float* matrix, int row, float* result) {
+#if defined(MATH_SIMD)
+        if constexpr (Columns == 4) {
+            Simd::storeu(result, Simd::loadu(matrix + row * 4));
+            return;
+        }
+#endif
+
+        for (int j = 0; j < Columns; j++) {
+            result[j] = matrix[row * Columns + j];
+        }
+    }
+
+    static void column(const float* matrix, int column, float* result) {
+        for (int i = 0; i < Rows; i++) {
+            result[i] = matrix[i * Columns + column];
+        }
+    }
+
+    static void leftMultiply(const float* matrix, const float* source, float* result) {
+#if defined(MATH_SIMD)
+        if constexpr (Rows == 4 && Columns == 4) {
+            Simd::Float4 vector = Simd::loadu(source);
+            Simd::Float4 product = Simd::mul(Simd::broadcast<0>(vector), Simd::loadu(matrix));
+            product = Simd::madd(Simd::broadcast<1>(vector), Simd::loadu(matrix + 4), product);
+            product = Simd::madd(Simd::broadcast<2>(vector), Simd::loadu(matrix + 8), product);
+            product = Simd::madd(Simd::broadcast<3>(vector), Simd::loadu(matrix + 12), product);
+
+            Simd::storeu(result, product);
+            return;
+        }
+#endif
+
+        for (int j = 0; j < Columns; j++) {
+            float product = 0.0f;
+            for (int i = 0; i < Rows; i++) {
+                product += source[i] * matrix[i * Columns + j];
+            }
+
+            result[j] = product;
+        }
+    }
+
+    static void rightMultiply(const float* matrix, const float* source, float* result) {
+#if defined(MATH_SIMD)
+        if constexpr (Rows == 4 && Columns == 4) {
+            Simd::Float4 column0 = Simd::loadu(matrix);
+            Simd::Float4 column1 = Simd::loadu(matrix + 4);
+            Simd::Float4 column2 = Simd::loadu(matrix + 8);
+            Simd::Float4 column3 = Simd::loadu(matrix + 12);
+            Simd::transpose(column0, column1, column2, column3);
+
+            Simd::Float4 vector = Simd::loadu(source);
+            Simd::Float4 product = Simd::mul(column0, Simd::broadcast<0>(vector));
+            product = Simd::madd(column1, Simd::broadcast<1>(vector), product);
+            product = Simd::madd(column2, Simd::broadcast<2>(vector), product);
+            product = Simd::madd(column3, Simd::broadcast<3>(vector), product);
+
+            Simd::storeu(result, product);
+            return;
+        }
+#endif
+
+        for (int i = 0; i < Rows; i++) {
+            float product = 0.0f;
+            for (int j = 0; j < Columns; j++) {
+                product += matrix[i * Columns + j] * source[j];
+            }
+
+            result[i] = product;
+        }
+    }
+};
+
+/*!
+ * \brief Expression base.
+ * \details Every expression node provides row(), column(), leftMultiply() and
+ *          rightMultiply() with the Kernel semantics.
+ */
+template<typename Derived, int ExpressionRows, int ExpressionColumns>
+class Expression {
+public:
+    enum { Rows = ExpressionRows, Columns = ExpressionColumns };
+
+    typedef typename Result<Rows, Columns>::Type Type;
+
+    const Derived& self() const {
+        return static_cast<const Derived&>(*this);
+    }
+
+    /*!
+     * \brief Expression evaluation.
+     * \return Evaluated Mat3, Mat4, Vec3 or Vec4.
+     */
+    Type evaluate() const {
+        alignas(16) float data[Rows * Columns];
+
+        if constexpr (Columns == 1) {
+            this->self().column(0, data);
+        } else {
+            for (int i = 0; i < Rows; i++) {
+                this->self().row(i, data + i * Columns);
+            }
+        }
+
+        return Result<Rows, Columns>::make(data);
+    }
+
+    operator Type() const {
+        return this->evaluate();
+    }
+};
+
+/*!
+ * \brief Expression leaf referring to Mat3, Mat4, Vec3 or Vec4 instance.
+ */
+template<typename T>
+class Terminal: public Expression<Terminal<T>, Traits<T>::Rows, Traits<T>::Columns> {
+public:
+    typedef Kernel<Traits<T>::Rows, Traits<T>::Columns> Dense;
+
+    // Operand types are standard layout with the storage as the only member, which
+    // saves an out-of-line data() call per leaf when linking with the library
+    static_assert(std::is_standard_layout<T>::value, "Lazy operand is not standard layout");
+
+    explicit Terminal(const T& value):
+            data(reinterpret_cast<const float*>(&value)) {
+    }
+
+    void row(int row, float* result) const {
+        Dense::row(this->data, row, result);
+    }
+
+    void column(int column, float* result) const {
+        Dense::column(this->data, column, result);
+    }
+
+    void leftMultiply(const float* source, float* result) const {
+        Dense::leftMultiply(this->data, source, result);
+    }
+
+    void rightMultiply(const float* source, float* result) const {
+        Dense::rightMultiply(this->data, source, result);
+    }
+
+private:
+    const float* data;
+};
+
+/*!
+ * \brief Expression leaf holding an evaluated subexpression.
+ * \details Used for sums and scalings multiplied from the left, which are cheaper to
+ *          evaluate once than to distribute over every product row.
+ */
+template<int EvaluatedRows, int EvaluatedColumns>
+class Evaluated: public Expression<Evaluated<EvaluatedRows, EvaluatedColumns>, EvaluatedRows, EvaluatedColumns> {
+public:
+    typedef Kernel<EvaluatedRows, EvaluatedColumns> Dense;
+
+    template<typename Derived>
+    explicit Evaluated(const Expression<Derived, EvaluatedRows, EvaluatedColumns>& expression) {
+        for (int i = 0; i < EvaluatedRows; i++) {
+            expression.self().row(i, this->data + i * EvaluatedColumns);
+        }
+    }
+
+    void row(int row, float* result) const {
+        Dense::row(this->data, row, result);
+    }
+
+    void column(int column, float* result) const {
+        Dense::column(this->data, column, result);
+    }
+
+    void leftMultiply(const float* source, float* result) const {
+        Dense::leftMultiply(this->data, source, result);
+    }
+
+    void rightMultiply(const float* source, float* result) const {
+        Dense::rightMultiply(this->data, source, result);
+    }
+
+private:
+    alignas(16) float data[EvaluatedRows * EvaluatedColumns];
+};
+
+template<typename Left, typename Right>
+class Product;
+
+/*!
+ * \brief Product operand storage.
+ * \details Leaves and products are kept as is, other nodes are evaluated.
+ */
+template<typename T>
+struct Operand {
+    typedef Evaluated<T::Rows, T::Columns> Type;
+};
+
+template<typename T>
+struct Operand<Terminal<T>> {
+    typedef Terminal<T> Type;
+};
+
+template<typename Left, typename Right>
+struct Operand<Product<Left, Right>> {
+    typedef Product<Left, Right> Type;
+};
+
+/*!
+ * \brief Matrices product node.
+ */
+template<typename Left, typename Right>
+class Product: public Expression<Product<Left, Right>, Left::Rows, Right::Columns> {
+public:
+    static_assert(static_cast<int>(Left::Columns) == static_cast<int>(Right::Rows),
+            "Product operands dimensions mismatch");
+
+    Product(const Left& left, const Right& right):
+            left(left),
+            right(right) {
+    }
+
+    void row(int row, float* result) const {
+        float intermediate[Left::Columns];
+        this->left.row(row, intermediate);
+        this->right.leftMultiply(intermediate, result);
+    }
+
+    void column(int column, float* result) const {
+        float intermediate[Right::Rows];
+        this->right.column(column, intermediate);
+        this->left.rightMultiply(intermediate, result);
+    }
+
+    void leftMultiply(const float* source, float* result) const {
+        float intermediate[Left::Columns];
+        this->left.leftMultiply(source, intermediate);
+        this->right.leftMultiply(intermediate, result);
+    }
+
+    void rightMultiply(const float* source, float* result) const {
+        float intermediate[Right::Rows];
+        this->right.rightMultiply(source, intermediate);
+        this->left.rightMultiply(intermediate, result);
+    }
+
+private:
+    typename Operand<Left>::Type left;
+    typename Operand<Right>::Type right;
+};
+
+/*!
+ * \brief Elementwise sum (Sign is 1) or difference (Sign is -1) node.
+ */
+template<typename Left, typename Right, int Sign>
+class Sum: public Expression<Sum<Left, Right, Sign>, Left::Rows, Left::Columns> {
+public:
+    static_assert(static_cast<int>(Left::Rows) == static_cast<int>(Right::Rows) &&
+                  static_cast<int>(Left::Columns) == static_cast<int>(Right::Columns),
+            "Sum operands dimensions mismatch");
+
+    Sum(const Left& left, const Right& right):
+            left(left),
+            right(right) {
+    }
+
+    void row(int row, float* result) const {
+        float summand[Left::Columns];
+        this->left.row(row, result);
+        this->right.row(row, summand);
+        this->combine(result, summand, Left::Columns);
+    }
+
+    void column(int column, float* result) const {
+        float summand[Left::Rows];
+        this->left.column(column, result);
+        this->right.column(column, summand);
+        this->combine(result, summand, Left::Rows);
+    }
+
+    void leftMultiply(const float* source, float* result) const {
+        float summand[Left::Columns];
+        this->left.leftMultiply(source, result);
+        this->right.leftMultiply(source, summand);
+        this->combine(result, summand, Left::Columns);
+    }
+
+    void rightMultiply(const float* source, float* result) const {
+        float summand[Left::Rows];
+        this->left.rightMultiply(source, result);
+        this->right.rightMultiply(source, summand);
+        this->combine(result, summand, Left::Rows);
+    }
+
+private:
+    static void combine(float* result, const float* summand, int size) {
+        for (int i = 0; i < size; i++) {
+            result[i] += static_cast<float>(Sign) * summand[i];
+        }
+    }
+
+    Left left;
+    Right right;
+};
+
+/*!
+ * \brief Scalar multiplication node.
+ */
+template<typename T>
+class Scale: public Expression<Scale<T>, T::Rows, T::Columns> {
+public:
+    Scale(const T& expression, float scalar):
+            expression(expression),
+            scalar(scalar) {
+    }
+
+    void row(int row, float* result) const {
+        this->expression.row(row, result);
+        this->scale(result, T::Columns);
+    }
+
+    void column(int column, float* result) const {
+        this->expression.column(column, result);
+        this->scale(result, T::Rows);
+    }
+
+    void leftMultiply(const float* source, float* result) const {
+        this->expression.leftMultiply(source, result);
+        this->scale(result, T::Columns);
+    }
+
+    void rightMultiply(const float* source, float* result) const {
+        this->expression.rightMultiply(source, result);
+        this->scale(result, T::Rows);
+    }
+
+private:
+    void scale(float* result, int size) const {
+        for (int i = 0; i < size; i++) {
+            result[i] *= this->scalar;
+        }
+    }
+
+    T expression;
+    float scalar;
+};
+
+/*
+ * Operators take at least one expression operand, the other one is either an
+ * expression or a type having Traits (wrapped into Terminal).
+ */
+template<typename T>
+using Leaf = typename std::enable_if<(Traits<T>::Rows > 0), Terminal<T>>::type;
+
+template<typename Left, int LeftRows, int LeftColumns, typename Right, int RightRows, int RightColumns>
+Product<Left, Right> operator *(const Expression<Left, LeftRows, LeftColumns>& left,
+                                const Expression<Right, RightRows, RightColumns>& right) {
+    return Product<Left, Right>(left.self(), right.self());
+}
+
+template<typename Left, int Rows, int Columns, typename T>
+Product<Left, Leaf<T>> operator *(const Expression<Left, Rows, Columns>& left, const T& right) {
+    return Product<Left, Leaf<T>>(left.self(), Leaf<T>(right));
+}
+
+template<typename T, typename Right, int Rows, int Columns>
+Product<Leaf<T>, Right> operator *(const T& left, const Expression<Right, Rows, Columns>& right) {
+    return Product<Leaf<T>, Right>(Leaf<T>(left), right.self());
+}
+
+template<typename Left, int LeftRows, int LeftColumns, typename Right, int RightRows, int RightColumns>
+Sum<Left, Right, 1> operator +(const Expression<Left, LeftRows, LeftColumns>& left,
+                               const Expression<Right, RightRows, RightColumns>& right) {
+    return Sum<Left, Right, 1>(left.self(), right.self());
+}
+
+template<typename Left, int Rows, int Columns, typename T>
+Sum<Left, Leaf<T>, 1> operator +(const Expression<Left, Rows, Columns>& left, const T& right) {
+    return Sum<Left, Leaf<T>, 1>(left.self(), Leaf<T>(right));
+}
+
+template<typename T, typename Right, int Rows, int Columns>
+Sum<Leaf<T>, Right, 1> operator +(const T& left, const Expression<Right, Rows, Columns>& right) {
+    return Sum<Leaf<T>, Right, 1>(Leaf<T>(left), right.self());
+}
+
+template<typename Left, int LeftRows, int LeftColumns, typename Right, int RightRows, int RightColumns>
+Sum<Left, Right, -1> operator -(const Expression<Left, LeftRows, LeftColumns>& left,
+                                const Expression<Right, RightRows, RightColumns>& right) {
+    return Sum<Left, Right, -1>(left.self(), right.self());
+}
+
+template<typename Left, int Rows, int Columns, typename T>
+Sum<Left, Leaf<T>, -1> operator -(const Expression<Left, Rows, Columns>& left, const T& right) {
+    return Sum<Left, Leaf<T>, -1>(left.self(), Leaf<T>(right));
+}
+
+template<typename T, typename Right, int Rows, int Columns>
+Sum<Leaf<T>, Right, -1> operator -(const T& left, const Expression<Right, Rows, Columns>& right) {
+    return Sum<Leaf<T>, Right, -1>(Leaf<T>(left), right.self());
+}
+
+template<typename T, int Rows, int Columns>
+Scale<T> operator *(const Expression<T, Rows, Columns>& expression, float scalar) {
+    return Scale<T>(expression.self(), scalar);
+}
+
+template<typename T, int Rows, int Columns>
+Scale<T> operator *(float scalar, const Expression<T, Rows, Columns>& expression) {
+    return Scale<T>(expression.self(), scalar);
+}
+
+}  // namespace Lazy
+
+/*!
+ * \brief Lazy expression entry point.
+ * \param value Mat3, Mat4, Vec3 or Vec4 operand.
+ * \return Expression leaf referring to value.
+ */
+template<typename T>
+Lazy::Terminal<T> lazy(const T& value) {
+    return Lazy::Terminal<T>(value);
+}
+
+}  // namespace Math
+
+#endif  // LAZY_H
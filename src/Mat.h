@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MAT_H
+#define MAT_H
+
+#include <Vec.h>
+
+namespace Math {
+
+/*!
+ * \brief Compile time sized square matrix template.
+ * \details Mat<N, T> is the templated core shared by all precisions, it keeps N x N
+ *          row-major components. Every loop is unrolled at compile time, there are no
+ *          runtime dimension checks. It implements basic operations that are:
+ *          * matrix-matrix multiplication, addition, difference;
+ *          * matrix-scalar multiplication;
+ *          * matrix-vector multiplication;
+ *          * transposition;
+ *          * conversion between precisions.
+ *
+ *          Static kernels operate on arrays of N rows, Mat3 and Mat4 delegate
+ *          their scalar code to Mat<3, float> and Mat<4, float> kernels.
+ */
+template<int N, typename T>
+class Mat {
+public:
+    static_assert(N > 0, "Matrix dimension must be positive");
+
+    typedef T Type;                              /*!< Component type. */
+    typedef typename Vec<N, T>::Scalar Scalar;   /*!< Arithmetic type. */
+
+    enum {
+        Size = N  /*!< Number of rows and columns. */
+    };
+
+    /*!
+     * \brief Default constructor.
+     * \details Constructs the identity matrix.
+     */
+    constexpr Mat();
+
+    /*!
+     * \brief Array based constructor.
+     * \param data N x N row-major components.
+     */
+    explicit constexpr Mat(const T* data);
+
+    /*!
+     * \brief Precision conversion constructor.
+     * \param matrix Converted matrix.
+     */
+    template<typename U>
+    explicit constexpr Mat(const Mat<N, U>& matrix);
+
+    /*!
+     * \brief Matrices multiplication.
+     * \param matrix Matrix multiplier.
+     * \return Product matrix.
+     */
+    constexpr Mat operator *(const Mat& matrix) const;
+
+    /*!
+     * \brief Matrix by vector multiplication.
+     * \param vector Vector multiplier.
+     * \return Product vector.
+     */
+    constexpr Vec<N, T> operator *(const Vec<N, T>& vector) const;
+
+    /*!
+     * \brief Matrix by scalar multiplication.
+     * \param scalar Scalar multiplier.
+     * \return Product matrix.
+     */
+    constexpr Mat operator *(Scalar scalar) const;
+
+    /*!
+     * \brief Matrices addition.
+     * \param matrix Summand matrix.
+     * \return Sum matrix.
+     */
+    constexpr Mat operator +(const Mat& matrix) const;
+
+    /*!
+     * \brief Matrices substraction.
+     * \param matrix Substracted matrix.
+     * \return Difference matrix.
+     */
+    constexpr Mat operator -(const Mat& matrix) const;
+
+    /*!
+     * \brief Matrices equalty check.
+     * \param matrix Compared matrix.
+     * \return true if matrices are equal, false otherwise.
+     */
+    constexpr bool operator ==(const Mat& matrix) const;
+
+    /*!
+     * \brief Matrices inequalty check.
+     * \param matrix Compared matrix.
+     * \return false if matrices are equal, true otherwise.
+     */
+    constexpr bool operator !=(const Mat& matrix) const;
+
+    /*!
+     * \brief Matrix transposition.
+     * \return Transposed matrix.
+     * \note Method has a side-effect.
+     */
+    constexpr Mat& transpose();
+
+    /*!
+     * \brief Matrix's component selector.
+     * \param row Component's row.
+     * \param column Component's column.
+     * \return Component's value.
+     */
+    constexpr T get(int row, int column) const;
+
+    /*!
+     * \brief Matrix's component mutator.
+     * \param row Component's row.
+     * \param column Component's column.
+     * \param value Component's new value.
+     */
+    constexpr void set(int row, int column, T value);
+
+    /*!
+     * \brief Matrix's data accessor.
+     * \return Matrix's data pointer.
+     */
+    constexpr const T* data() const;
+
+    /*!
+     * \brief Multiplication kernel.
+     * \details Computes result = left * right on arrays of N rows.
+     * \note result should not alias any operand, no check is performed.
+     */
+    static constexpr void multiply(const T (*left)[N], const T (*right)[N], T (*result)[N]);
+
+    /*!
+     * \brief Matrix by vector multiplication kernel.
+     * \details Computes result = matrix * vector, matrix is an array of N rows.
+     * \note result should not alias vector, no check is performed.
+     */
+    static constexpr void transform(const T (*matrix)[N], const T* vector, T* result);
+
+    /*!
+     * \brief Scaling kernel.
+     * \details Computes result = matrix * scalar on arrays of N rows.
+     */
+    static constexpr void scale(const T (*matrix)[N], Scalar scalar, T (*result)[N]);
+
+    /*!
+     * \brief Addition kernel.
+     * \details Computes result = left + right on arrays of N rows.
+     */
+    static constexpr void add(const T (*left)[N], const T (*right)[N], T (*result)[N]);
+
+    /*!
+     * \brief Substraction kernel.
+     * \details Computes result = left - right on arrays of N rows.
+     */
+    static constexpr void subtract(const T (*left)[N], const T (*right)[N], T (*result)[N]);
+
+    /*!
+     * \brief Equalty check kernel.
+     * \return true if arrays of N rows are equal, false otherwise.
+     */
+    static constexpr bool equal(const T (*left)[N], const T (*right)[N]);
+
+    /*!
+     * \brief Transposition kernel.
+     * \details Transposes array of N rows in place.
+     */
+    static constexpr void transpose(T (*matrix)[N]);
+
+private:
+    T matrix[N][N];
+};
+
+typedef Mat<3, double> Mat3d;  /*!< 3x3 double precision matrix. */
+typedef Mat<4, double> Mat4d;  /*!< 4x4 double precision matrix. */
+
+}  // namespace Math
+
+// Templates are always defined in headers, MATH_HEADER_ONLY makes no difference here
+#include <Mat.inl>
+
+#endif  // MAT_H
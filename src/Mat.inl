@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MAT_INL
+#define MAT_INL
+
+#include <Mat.h>
+#include <Unroll.h>
+#include <cassert>
+
+namespace Math {
+
+template<int N, typename T>
+constexpr Mat<N, T>::Mat():
+        matrix() {
+    unroll<N>([&](int i) { this->matrix[i][i] = static_cast<T>(1); });
+}
+
+template<int N, typename T>
+constexpr Mat<N, T>::Mat(const T* data):
+        matrix() {
+    unroll<N>([&](int i) {
+        unroll<N>([&](int j) { this->matrix[i][j] = data[i * N + j]; });
+    });
+}
+
+template<int N, typename T>
+template<typename U>
+constexpr Mat<N, T>::Mat(const Mat<N, U>& matrix):
+        matrix() {
+    unroll<N>([&](int i) {
+        unroll<N>([&](int j) { this->matrix[i][j] = static_cast<T>(matrix.get(i, j)); });
+    });
+}
+
+template<int N, typename T>
+constexpr Mat<N, T> Mat<N, T>::operator *(const Mat& matrix) const {
+    Mat result;
+    Mat::multiply(this->matrix, matrix.matrix, result.matrix);
+    return result;
+}
+
+template<int N, typename T>
+constexpr Vec<N, T> Mat<N, T>::operator *(const Vec<N, T>& vector) const {
+    T result[N] = {};
+    Mat::transform(this->matrix, vector.data(), result);
+    return Vec<N, T>(result);
+}
+
+template<int N, typename T>
+constexpr Mat<N, T> Mat<N, T>::operator *(Scalar scalar) const {
+    Mat result;
+    Mat::scale(this->matrix, scalar, result.matrix);
+    return result;
+}
+
+template<int N, typename T>
+constexpr Mat<N, T> Mat<N, T>::operator +(const Mat& matrix) const {
+    Mat result;
+    Mat::add(this->matrix, matrix.matrix, result.matrix);
+    return result;
+}
+
+template<int N, typename T>
+constexpr Mat<N, T> Mat<N, T>::operator -(const Mat& matrix) const {
+    Mat result;
+    Mat::subtract(this->matrix, matrix.matrix, result.matrix);
+    return result;
+}
+
+template<int N, typename T>
+constexpr bool Mat<N, T>::operator ==(const Mat& matrix) const {
+    return Mat::equal(this->matrix, matrix.matrix);
+}
+
+template<int N, typename T>
+constexpr bool Mat<N, T>::operator !=(const Mat& matrix) const {
+    return !(*this == matrix);
+}
+
+template<int N, typename T>
+constexpr Mat<N, T>& Mat<N, T>::transpose() {
+    Mat::transpose(this->matrix);
+    return *this;
+}
+
+template<int N, typename T>
+constexpr T Mat<N, T>::get(int row, int column) const {
+    assert(row >= 0 && row < N);
+    assert(column >= 0 && column < N);
+    return this->matrix[row][column];
+}
+
+template<int N, typename T>
+constexpr void Mat<N, T>::set(int row, int column, T value) {
+    assert(row >= 0 && row < N);
+    assert(column >= 0 && column < N);
+    this->matrix[row][column] = value;
+}
+
+template<int N, typename T>
+constexpr const T* Mat<N, T>::data() const {
+    return this->matrix[0];
+}
+
+template<int N, typename T>
+constexpr void Mat<N, T>::multiply(const T (*left)[N], const T (*right)[N], T (*result)[N]) {
+    unroll<N>([&](int i) {
+        unroll<N>([&](int j) {
+            Scalar product = Scalar();
+            unroll<N>([&](int k) { product += static_cast<Scalar>(left[i][k]) * static_cast<Scalar>(right[k][j]); });
+            result[i][j] = static_cast<T>(product);
+        });
+    });
+}
+
+template<int N, typename T>
+constexpr void Mat<N, T>::transform(const T (*matrix)[N], const T* vector, T* result) {
+    unroll<N>([&](int i) { result[i] = static_cast<T>(Vec<N, T>::dot(matrix[i], vector)); });
+}
+
+template<int N, typename T>
+constexpr void Mat<N, T>::scale(const T (*matrix)[N], Scalar scalar, T (*result)[N]) {
+    unroll<N>([&](int i) {
+        unroll<N>([&](int j) { result[i][j] = static_cast<T>(matrix[i][j] * scalar); });
+    });
+}
+
+template<int N, typename T>
+constexpr void Mat<N, T>::add(const T (*left)[N], const T (*right)[N], T (*result)[N]) {
+    unroll<N>([&](int i) { Vec<N, T>::add(left[i], right[i], result[i]); });
+}
+
+template<int N, typename T>
+constexpr void Mat<N, T>::subtract(const T (*left)[N], const T (*right)[N], T (*result)[N]) {
+    unroll<N>([&](int i) { Vec<N, T>::subtract(left[i], right[i], result[i]); });
+}
+
+template<int N, typename T>
+constexpr bool Mat<N, T>::equal(const T (*left)[N], const T (*right)[N]) {
+    bool equal = true;
+    unroll<N>([&](int i) {
+        unroll<N>([&](int j) { equal = equal && (left[i][j] == right[i][j]); });
+    });
+    return equal;
+}
+
+template<int N, typename T>
+constexpr void Mat<N, T>::transpose(T (*matrix)[N]) {
+    unroll<N>([&](int i) {
+        unroll<N>([&](int j) {
+            if (i < j) {
+                T value = matrix[i][j];
+                matrix[i][j] = matrix[j][i];
+                matrix[j][i] = value;
+            }
+        });
+    });
+}
+
+}  // namespace Math
+
+#endif  // MAT_INL
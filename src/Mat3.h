@@ -24,11 +24,14 @@
 #define MAT3_H
 
 #include <MathApi.h>
+#include <Uninitialized.h>
+#include <Vec3.h>
+#include <Mat.h>
+#include <cassert>
+#include <type_traits>
 
 namespace Math {
 
-class Vec3;
-
 /*!
  * \brief 3x3 two dimentional matrix.
  * \details Mat3 implements basic operations that are:
@@ -42,63 +45,77 @@ public:
      * \brief Default constructor.
      * \details Constructs the identity matrix.
      */
-    MATH_API Mat3();
+    constexpr Mat3() noexcept;
+
+    /*!
+     * \brief Uninitialized constructor.
+     * \details Leaves elements indeterminate, for results written completely right after.
+     * \note Reading elements before writing them is undefined behaviour.
+     */
+    explicit Mat3(Uninitialized) noexcept;
+
+    /*!
+     * \brief Array based constructor.
+     * \details Constructs the matrix from 9 row-major elements.
+     * \param data Matrix elements.
+     */
+    explicit constexpr Mat3(const float* data) noexcept;
 
     /*!
      * \brief Matrices multiplication.
      * \param matrix Matrix multiplier.
      * \return Product matrix.
      */
-    MATH_API Mat3 operator *(const Mat3& matrix) const;
+    constexpr Mat3 operator *(const Mat3& matrix) const noexcept;
 
     /*!
      * \brief Matrix by vector multiplication.
      * \param vector Vector multiplier.
      * \return Product vector.
      */
-    MATH_API Vec3 operator *(const Vec3& vector) const;
+    constexpr Vec3 operator *(const Vec3& vector) const noexcept;
 
     /*!
      * \brief Matrix by scalar multiplication.
      * \param scalar Scalar multiplier.
      * \return Product matrix.
      */
-    MATH_API Mat3 operator *(float scalar) const;
+    constexpr Mat3 operator *(float scalar) const noexcept;
 
     /*!
      * \brief Matrices addition.
      * \param matrix Summand matrix.
      * \return Sum matrix.
      */
-    MATH_API Mat3 operator +(const Mat3& matrix) const;
+    constexpr Mat3 operator +(const Mat3& matrix) const noexcept;
 
     /*!
      * \brief Matrices substraction.
      * \param matrix Substracted matrix.
      * \return Difference matrix.
      */
-    MATH_API Mat3 operator -(const Mat3& matrix) const;
+    constexpr Mat3 operator -(const Mat3& matrix) const noexcept;
 
     /*!
      * \brief Matrices equalty check.
      * \param matrix Compared matrix.
      * \return true if matrices are equal, false otherwise.
      */
-    MATH_API bool operator ==(const Mat3& matrix) const;
+    constexpr bool operator ==(const Mat3& matrix) const noexcept;
 
     /*!
      * \brief Matrices inequalty check.
      * \param matrix Compared matrix.
      * \return false if matrices are equal, true otherwise.
      */
-    MATH_API bool operator !=(const Mat3& matrix) const;
+    constexpr bool operator !=(const Mat3& matrix) const noexcept;
 
     /*!
      * \brief Matrix transposition.
      * \return Transposed matrix.
      * \note Method has a side-effect.
      */
-    MATH_API Mat3& transpose();
+    constexpr Mat3& transpose() noexcept;
 
     /*!
      * \brief Matrix LU decomposition.
@@ -109,23 +126,38 @@ public:
      *
      * \param lower Lower triangular matrix.
      * \param upper Upper triangular matrix.
+     * \note No pivoting is performed, LU3 factorizes with partial pivoting and
+     *       reports singular matrices.
      */
-    MATH_API void decompose(Mat3& lower, Mat3& upper) const;
+    MATH_API void decompose(Mat3& lower, Mat3& upper) const noexcept;
+
+    /*!
+     * \brief Matrix determinant calculation.
+     * \return Determinant expanded along the first row.
+     */
+    constexpr float determinant() const noexcept;
 
     /*!
      * \brief Matrix inversion.
-     * \details This methos finds inverse matrix by LU-decomposition and further equation solving:
-     *           -# L * Z = I
-     *           -# U * X = Z
-     *           -# L * U * X = I
-     *
-     *           Where:
-     *            * L and U are lower and upper triangular matrices got by decompose(),
-     *            * X and I are respective columns of inverse and identity matrices.
+     * \details This method finds inverse matrix as the transposed cofactor matrix divided
+     *          by determinant. The result equals the one got by decompose() and solving
+     *          L * U * X = I column by column, at a fraction of the cost.
      *
      * \return Inverted matrix.
+     * \note Matrix is assumed to be non-singular, no check is performed.
+     * \note Method has a side-effect.
+     */
+    MATH_API Mat3& invert() noexcept;
+
+    /*!
+     * \brief Solve matrix equation.
+     * \details Finds X of M * X = absolute by Cramer's rule, neither inverse nor L and U
+     *          matrices are built.
+     * \param absolute Vector of absolute values.
+     * \return Vector of unknown values.
+     * \note Matrix is assumed to be non-singular, no check is performed.
      */
-    MATH_API Mat3& invert();
+    MATH_API Vec3 solve(const Vec3& absolute) const noexcept;
 
     /*!
      * \brief Solve matrix equation with a lower triangular matrix.
@@ -136,7 +168,7 @@ public:
      * \return Vector of unknown values.
      * \note Matrix is assumed to be triangular, no check is performed.
      */
-    MATH_API Vec3 solveL(const Vec3& absolute) const;
+    MATH_API Vec3 solveL(const Vec3& absolute) const noexcept;
 
     /*!
      * \brief Solve matrix equation with an upper triangular matrix.
@@ -147,7 +179,7 @@ public:
      * \return Vector of unknown values.
      * \note Matrix is assumed to be triangular, no check is performed.
      */
-    MATH_API Vec3 solveU(const Vec3& absolute) const;
+    MATH_API Vec3 solveU(const Vec3& absolute) const noexcept;
 
     /*!
      * \brief Matrix's element selector.
@@ -155,7 +187,7 @@ public:
      * \param column Element's column.
      * \return Element's value.
      */
-    MATH_API float get(int row, int column) const;
+    constexpr float get(int row, int column) const noexcept;
 
     /*!
      * \brief Matrix's element mutator.
@@ -163,18 +195,109 @@ public:
      * \param column Element's column.
      * \param value Element's new value.
      */
-    MATH_API void set(int row, int column, float value);
+    constexpr void set(int row, int column, float value) noexcept;
 
     /*!
      * \brief Matrix's data accessor.
      * \return Matrix's data pointer.
      */
-    MATH_API const float* data() const;
+    constexpr const float* data() const noexcept;
 
 private:
     float matrix[3][3];
 };
 
+static_assert(std::is_trivially_copyable<Mat3>::value, "Mat3 should be copied with memcpy");
+static_assert(std::is_nothrow_move_constructible<Mat3>::value && std::is_nothrow_move_assignable<Mat3>::value,
+        "Mat3 should be moved without exceptions");
+
+constexpr Mat3::Mat3() noexcept:
+        matrix{{1.0f, 0.0f, 0.0f},
+               {0.0f, 1.0f, 0.0f},
+               {0.0f, 0.0f, 1.0f}} {
+}
+
+inline Mat3::Mat3(Uninitialized) noexcept {
+}
+
+constexpr Mat3::Mat3(const float* data) noexcept:
+        matrix() {
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            this->matrix[i][j] = data[i * 3 + j];
+        }
+    }
+}
+
+constexpr Mat3 Mat3::operator *(const Mat3& matrix) const noexcept {
+    Mat3 result;
+    Mat<3, float>::multiply(this->matrix, matrix.matrix, result.matrix);
+    return result;
+}
+
+constexpr Vec3 Mat3::operator *(const Vec3& vector) const noexcept {
+    float result[3] = {};
+    Mat<3, float>::transform(this->matrix, vector.data(), result);
+    return Vec3(result[0], result[1], result[2]);
+}
+
+constexpr Mat3 Mat3::operator *(float scalar) const noexcept {
+    Mat3 result;
+    Mat<3, float>::scale(this->matrix, scalar, result.matrix);
+    return result;
+}
+
+constexpr Mat3 Mat3::operator +(const Mat3& matrix) const noexcept {
+    Mat3 result;
+    Mat<3, float>::add(this->matrix, matrix.matrix, result.matrix);
+    return result;
+}
+
+constexpr Mat3 Mat3::operator -(const Mat3& matrix) const noexcept {
+    Mat3 result;
+    Mat<3, float>::subtract(this->matrix, matrix.matrix, result.matrix);
+    return result;
+}
+
+constexpr bool Mat3::operator ==(const Mat3& matrix) const noexcept {
+    return Mat<3, float>::equal(this->matrix, matrix.matrix);
+}
+
+constexpr bool Mat3::operator !=(const Mat3& matrix) const noexcept {
+    return !(*this == matrix);
+}
+
+constexpr float Mat3::determinant() const noexcept {
+    return this->matrix[0][0] * (this->matrix[1][1] * this->matrix[2][2] - this->matrix[1][2] * this->matrix[2][1]) +
+           this->matrix[0][1] * (this->matrix[1][2] * this->matrix[2][0] - this->matrix[1][0] * this->matrix[2][2]) +
+           this->matrix[0][2] * (this->matrix[1][0] * this->matrix[2][1] - this->matrix[1][1] * this->matrix[2][0]);
+}
+
+constexpr Mat3& Mat3::transpose() noexcept {
+    Mat<3, float>::transpose(this->matrix);
+    return *this;
+}
+
+constexpr float Mat3::get(int row, int column) const noexcept {
+    assert(row >= 0 && row <= 2);
+    assert(column >= 0 && column <= 2);
+    return this->matrix[row][column];
+}
+
+constexpr void Mat3::set(int row, int column, float value) noexcept {
+    assert(row >= 0 && row <= 2);
+    assert(column >= 0 && column <= 2);
+    this->matrix[row][column] = value;
+}
+
+constexpr const float* Mat3::data() const noexcept {
+    return this->matrix[0];
+}
+
 }  // namespace Math
 
+#ifdef MATH_HEADER_ONLY
+#include <Mat3.inl>
+#endif
+
 #endif  // MAT3_H
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MAT3_INL
+#define MAT3_INL
+
+#include <Mat3.h>
+#include <Vec3.h>
+#include <cmath>
+
+namespace Math {
+
+MATH_INLINE void Mat3::decompose(Mat3& lower, Mat3& upper) const noexcept {
+    for (int i = 0; i < 3; i++) {
+        for (int j = i; j < 3; j++) {
+            lower.set(i, j, (i == j) ? 1.0f : 0.0f);
+            upper.set(i, j, 0.0f);
+        }
+    }
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = i; j < 3; j++) {
+            upper.set(i, j, this->matrix[i][j]);
+            for (int k = 0; k < i; k++) {
+                upper.set(i, j, upper.get(i, j) - lower.get(i, k) * upper.get(k, j));
+            }
+            upper.set(i, j, upper.get(i, j) / lower.get(i, i));
+        }
+
+        for (int j = i + 1; j < 3; j++) {
+            lower.set(j, i, this->matrix[j][i]);
+            for (int k = 0; k < i; k++) {
+                lower.set(j, i, lower.get(j, i) - lower.get(j, k) * upper.get(k, i));
+            }
+            lower.set(j, i, lower.get(j, i) / upper.get(i, i));
+        }
+    }
+}
+
+MATH_INLINE Mat3& Mat3::invert() noexcept {
+    float (&m)[3][3] = this->matrix;
+
+    // Cofactors are kept in registers, staging them in an array stalls store forwarding
+    float c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+    float c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+    float c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+    float c10 = m[2][1] * m[0][2] - m[2][2] * m[0][1];
+    float c11 = m[2][2] * m[0][0] - m[2][0] * m[0][2];
+    float c12 = m[2][0] * m[0][1] - m[2][1] * m[0][0];
+    float c20 = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+    float c21 = m[0][2] * m[1][0] - m[0][0] * m[1][2];
+    float c22 = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+    float inverseDeterminant = 1.0f / (m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02);
+
+    m[0][0] = c00 * inverseDeterminant;
+    m[0][1] = c10 * inverseDeterminant;
+    m[0][2] = c20 * inverseDeterminant;
+    m[1][0] = c01 * inverseDeterminant;
+    m[1][1] = c11 * inverseDeterminant;
+    m[1][2] = c21 * inverseDeterminant;
+    m[2][0] = c02 * inverseDeterminant;
+    m[2][1] = c12 * inverseDeterminant;
+    m[2][2] = c22 * inverseDeterminant;
+
+    return *this;
+}
+
+MATH_INLINE Vec3 Mat3::solve(const Vec3& absolute) const noexcept {
+    const float (&m)[3][3] = this->matrix;
+    float b0 = absolute.get(Vec3::X);
+    float b1 = absolute.get(Vec3::Y);
+    float b2 = absolute.get(Vec3::Z);
+
+    // Cofactor rows are cross products of the other two rows, X = transposed cofactors * B / det
+    float c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+    float c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+    float c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+    float inverseDeterminant = 1.0f / (m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02);
+
+    float c10 = m[2][1] * m[0][2] - m[2][2] * m[0][1];
+    float c11 = m[2][2] * m[0][0] - m[2][0] * m[0][2];
+    float c12 = m[2][0] * m[0][1] - m[2][1] * m[0][0];
+
+    float c20 = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+    float c21 = m[0][2] * m[1][0] - m[0][0] * m[1][2];
+    float c22 = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+
+    return Vec3((c00 * b0 + c10 * b1 + c20 * b2) * inverseDeterminant,
+                (c01 * b0 + c11 * b1 + c21 * b2) * inverseDeterminant,
+                (c02 * b0 + c12 * b1 + c22 * b2) * inverseDeterminant);
+}
+
+MATH_INLINE Vec3 Mat3::solveL(const Vec3& absolute) const noexcept {
+    Vec3 solution(UNINITIALIZED);
+
+    for (int i = 0; i < 3; i++) {
+        solution.set(i, absolute.get(i));
+        for (int j = 0; j < i; j++) {
+            solution.set(i, solution.get(i) - this->matrix[i][j] * solution.get(j));
+        }
+        solution.set(i, solution.get(i) / this->matrix[i][i]);
+    }
+
+    return solution;
+}
+
+MATH_INLINE Vec3 Mat3::solveU(const Vec3& absolute) const noexcept {
+    Vec3 solution(UNINITIALIZED);
+
+    for (int i = 2; i > -1; i--) {
+        solution.set(i, absolute.get(i));
+        for (int j = 2; j > i; j--) {
+            solution.set(i, solution.get(i) - this->matrix[i][j] * solution.get(j));
+        }
+        solution.set(i, solution.get(i) / this->matrix[i][i]);
+    }
+
+    return solution;
+}
+
+}  // namespace Math
+
+#endif  // MAT3_INL
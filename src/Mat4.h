@@ -24,81 +24,111 @@
 #define MAT4_H
 
 #include <MathApi.h>
+#include <Uninitialized.h>
+#include <Vec4.h>
+#include <Mat.h>
+#include <MathSimd.h>
+#include <View.h>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
 
 namespace Math {
 
 class Mat3;
-class Vec4;
+class Quaternion;
 
 /*!
  * \brief 4x4 two dimentional matrix.
  * \details Mat4 implements basic operations that are:
  *          * matrix-matrix addition, difference, multiplication;
- *          * matrix-vector multiplication;
- *          * transposition, LU decomposition, inversion.
+ *          * matrix-vector multiplication, batch transformation of vector arrays;
+ *          * transposition, LU decomposition, inversion;
+ *          * translation, scale, TRS, projection and view matrix builders.
  */
 class Mat4 {
 public:
+    enum Layout {
+        ROW_MAJOR = 0,    /*!< Rows are stored contiguously, the native layout. */
+        COLUMN_MAJOR = 1  /*!< Columns are stored contiguously, e.g. for GPU uploads. */
+    };
+
     /*!
      * \brief Default constructor.
      * \details Constructs the identity matrix.
      */
-    MATH_API Mat4();
+    constexpr Mat4() noexcept;
+
+    /*!
+     * \brief Uninitialized constructor.
+     * \details Leaves elements indeterminate, for results written completely right after.
+     * \note Reading elements before writing them is undefined behaviour.
+     */
+    explicit Mat4(Uninitialized) noexcept;
+
+    /*!
+     * \brief Array based constructor.
+     * \details Constructs the matrix from 16 row-major elements.
+     * \param data Matrix elements.
+     */
+    explicit MATH_SIMD_CONSTEXPR Mat4(const float* data) noexcept;
 
     /*!
      * \brief Matrices multiplication.
      * \param matrix Matrix multiplier.
      * \return Product matrix.
+     * \note SSE2, AVX/FMA or NEON kernel is used when available, see MathSimd.h.
      */
-    MATH_API Mat4 operator *(const Mat4& matrix) const;
+    MATH_SIMD_CONSTEXPR Mat4 operator *(const Mat4& matrix) const noexcept;
 
     /*!
      * \brief Matrix by vector multiplication.
      * \param vector Vector multiplier.
      * \return Product vector.
+     * \note SSE2, AVX/FMA or NEON kernel is used when available, see MathSimd.h.
      */
-    MATH_API Vec4 operator *(const Vec4& vector) const;
+    MATH_SIMD_CONSTEXPR Vec4 operator *(const Vec4& vector) const noexcept;
 
     /*!
      * \brief Matrix by scalar multiplication.
      * \param scalar Scalar multiplier.
      * \return Product matrix.
      */
-    MATH_API Mat4 operator *(float scalar) const;
+    constexpr Mat4 operator *(float scalar) const noexcept;
 
     /*!
      * \brief Matrices addition.
      * \param matrix Summand matrix.
      * \return Sum matrix.
      */
-    MATH_API Mat4 operator +(const Mat4& matrix) const;
+    constexpr Mat4 operator +(const Mat4& matrix) const noexcept;
     /*!
      * \brief Matrices substraction.
      * \param matrix Substracted matrix.
      * \return Difference matrix.
      */
-    MATH_API Mat4 operator -(const Mat4& matrix) const;
+    constexpr Mat4 operator -(const Mat4& matrix) const noexcept;
 
     /*!
      * \brief Matrices equalty check.
      * \param matrix Compared matrix.
      * \return true if matrices are equal, false otherwise.
      */
-    MATH_API bool operator ==(const Mat4& matrix) const;
+    constexpr bool operator ==(const Mat4& matrix) const noexcept;
 
     /*!
      * \brief Matrices inequalty check.
      * \param matrix Compared matrix.
      * \return false if matrices are equal, true otherwise.
      */
-    MATH_API bool operator !=(const Mat4& matrix) const;
+    constexpr bool operator !=(const Mat4& matrix) const noexcept;
 
     /*!
      * \brief Matrix transposition.
      * \return Transposed matrix.
      * \note Method has a side-effect.
      */
-    MATH_API Mat4& transpose();
+    constexpr Mat4& transpose() noexcept;
 
     /*!
      * \brief Matrix LU decomposition.
@@ -109,23 +139,46 @@ public:
      *
      * \param lower Lower triangular matrix.
      * \param upper Upper triangular matrix.
+     * \note No pivoting is performed, LU4 factorizes with partial pivoting and
+     *       reports singular matrices.
      */
-    MATH_API void decompose(Mat4& lower, Mat4& upper) const;
+    MATH_API void decompose(Mat4& lower, Mat4& upper) const noexcept;
 
     /*!
      * \brief Matrix inversion.
-     * \details This methos finds inverse matrix by LU-decomposition and further equation solving:
-     *           -# L * Z = I
-     *           -# U * X = Z
-     *           -# L * U * X = I
+     * \details This method finds inverse matrix as the adjugate matrix divided by determinant.
+     *          Cofactors are expanded from twelve 2x2 subdeterminants of the upper and lower
+     *          row pairs. References:
+     *           * https://www.geometrictools.com/Documentation/LaplaceExpansionTheorem.pdf
      *
-     *           Where:
-     *            * L and U are lower and upper triangular matrices got by decompose(),
-     *            * X and I are respective columns of inverse and identity matrices.
+     *          The result equals the one got by decompose() and solving L * U * X = I
+     *          column by column, at a fraction of the cost.
      *
      * \return Inverted matrix.
+     * \note Method has a side-effect.
+     */
+    MATH_API Mat4& invert() noexcept;
+
+    /*!
+     * \brief Affine matrix inversion.
+     * \details Inverts upper 3x3 block A by cofactors and translation T as -A^-1 * T.
+     * \return Inverted matrix.
+     * \note Matrix is assumed to be affine (last row is 0, 0, 0, 1), no check is performed.
+     * \note Method has a side-effect.
+     */
+    MATH_API Mat4& invertAffine() noexcept;
+
+    /*!
+     * \brief Rigid transformation inversion.
+     * \details Inverts rotation, translation and uniform scale transformation. Inverse of
+     *          the extractMat3() block is its transpose divided by the square scale,
+     *          translation T becomes -A^-1 * T.
+     * \return Inverted matrix.
+     * \note Matrix is assumed to be a rigid transformation with optional uniform scale,
+     *       no check is performed.
+     * \note Method has a side-effect.
      */
-    MATH_API Mat4& invert();
+    MATH_API Mat4& invertRigid() noexcept;
 
     /*!
      * \brief Solve matrix equation with a lower triangular matrix.
@@ -136,7 +189,7 @@ public:
      * \return Vector of unknown values.
      * \note Matrix is assumed to be triangular, no check is performed.
      */
-    MATH_API Vec4 solveL(const Vec4& absolute) const;
+    MATH_API Vec4 solveL(const Vec4& absolute) const noexcept;
 
     /*!
      * \brief Solve matrix equation with an upper triangular matrix.
@@ -147,7 +200,7 @@ public:
      * \return Vector of unknown values.
      * \note Matrix is assumed to be triangular, no check is performed.
      */
-    MATH_API Vec4 solveU(const Vec4& absolute) const;
+    MATH_API Vec4 solveU(const Vec4& absolute) const noexcept;
 
     /*!
      * \brief Matrix's element selector.
@@ -155,7 +208,7 @@ public:
      * \param column Element's column.
      * \return Element's value.
      */
-    MATH_API float get(int row, int column) const;
+    constexpr float get(int row, int column) const noexcept;
 
     /*!
      * \brief Matrix's element mutator.
@@ -163,25 +216,461 @@ public:
      * \param column Element's column.
      * \param value Element's new value.
      */
-    MATH_API void set(int row, int column, float value);
+    constexpr void set(int row, int column, float value) noexcept;
 
     /*!
      * \brief Matrix's data accessor.
      * \return Matrix's data pointer.
      */
-    MATH_API const float* data() const;
+    constexpr const float* data() const noexcept;
+
+    /*!
+     * \brief Column-major copy.
+     * \details Writes 16 elements column by column, the layout OpenGL and Vulkan expect
+     *          for uniform and storage buffers. Replaces a transpose() and a copy.
+     * \param destination Destination buffer, no alignment is required.
+     */
+    MATH_API void copyTransposed(float* destination) const noexcept;
+
+    /*!
+     * \brief Batch column-major copy.
+     * \details Same as copyTransposed(float*) const for every matrix, e.g. for filling
+     *          an instance buffer directly.
+     * \param matrices Source matrices.
+     * \param destination Destination buffer, no alignment is required.
+     * \param count Number of matrices.
+     * \param destinationStride Distance between consecutive matrices in destination,
+     *        in floats.
+     * \note There is an assert for destinationStride to be at least 16.
+     */
+    MATH_API static void copyTransposed(const Mat4* matrices, float* destination, std::size_t count,
+            std::size_t destinationStride = 16) noexcept;
 
     /*!
      * \brief Mat3 matrix extraction.
      * \details Composes Mat3 from first three rows and columns.
      * \return 3x3 two dimetional matrix.
      */
-    MATH_API Mat3 extractMat3() const;
+    MATH_API Mat3 extractMat3() const noexcept;
+
+    /*!
+     * \brief Normal matrix calculation.
+     * \details Computes inverse-transpose of the extractMat3() block directly as its
+     *          cofactor matrix divided by determinant, no inverse is transposed.
+     * \return Matrix transforming normals.
+     * \note Upper 3x3 block is assumed to be non-singular, no check is performed.
+     */
+    MATH_API Mat3 normalMatrix() const noexcept;
+
+    /*!
+     * \brief Rigid transformation normal matrix calculation.
+     * \details Orthogonal block with uniform scale is its own inverse-transpose up to
+     *          the square scale, so extractMat3() is divided by it and neither cofactors
+     *          nor transposition are needed.
+     * \return Matrix transforming normals.
+     * \note Matrix is assumed to be a rigid transformation with optional uniform scale,
+     *       no check is performed.
+     */
+    MATH_API Mat3 normalMatrixRigid() const noexcept;
+
+    /*!
+     * \brief Batch points transformation.
+     * \details Transforms every point as Vec4 with W component equal to 1, the resulting
+     *          W component is dropped. The matrix is loaded once for the whole batch.
+     * \param points Source points.
+     * \param result Transformed points, may be the same array as points.
+     * \param count Number of points.
+     */
+    MATH_API void transformPoints(const Vec3* points, Vec3* result, std::size_t count) const noexcept;
+
+    /*!
+     * \brief Batch directions transformation.
+     * \details Transforms every direction as Vec4 with W component equal to 0, thus
+     *          translation part of the matrix is ignored.
+     * \param directions Source directions.
+     * \param result Transformed directions, may be the same array as directions.
+     * \param count Number of directions.
+     */
+    MATH_API void transformDirections(const Vec3* directions, Vec3* result, std::size_t count) const noexcept;
+
+    /*!
+     * \brief Batch vectors transformation.
+     * \details Batch equivalent of operator *(const Vec4&) const.
+     * \param vectors Source vectors.
+     * \param result Transformed vectors, may be the same array as vectors.
+     * \param count Number of vectors.
+     */
+    MATH_API void transform(const Vec4* vectors, Vec4* result, std::size_t count) const noexcept;
+
+    /*!
+     * \brief Strided batch points transformation.
+     * \details Same as transformPoints(const Vec3*, Vec3*, std::size_t) const for
+     *          interleaved buffers, each point being three consecutive floats.
+     * \param points First source point.
+     * \param pointsStride Distance between consecutive source points in floats.
+     * \param result First transformed point.
+     * \param resultStride Distance between consecutive transformed points in floats.
+     * \param count Number of points.
+     */
+    MATH_API void transformPoints(const float* points, std::size_t pointsStride,
+            float* result, std::size_t resultStride, std::size_t count) const noexcept;
+
+    /*!
+     * \brief Strided batch directions transformation.
+     * \details Same as transformDirections(const Vec3*, Vec3*, std::size_t) const for
+     *          interleaved buffers, each direction being three consecutive floats.
+     * \param directions First source direction.
+     * \param directionsStride Distance between consecutive source directions in floats.
+     * \param result First transformed direction.
+     * \param resultStride Distance between consecutive transformed directions in floats.
+     * \param count Number of directions.
+     */
+    MATH_API void transformDirections(const float* directions, std::size_t directionsStride,
+            float* result, std::size_t resultStride, std::size_t count) const noexcept;
+
+    /*!
+     * \brief Strided batch vectors transformation.
+     * \details Same as transform(const Vec4*, Vec4*, std::size_t) const for interleaved
+     *          buffers, each vector being four consecutive floats.
+     * \param vectors First source vector.
+     * \param vectorsStride Distance between consecutive source vectors in floats.
+     * \param result First transformed vector.
+     * \param resultStride Distance between consecutive transformed vectors in floats.
+     * \param count Number of vectors.
+     */
+    MATH_API void transform(const float* vectors, std::size_t vectorsStride,
+            float* result, std::size_t resultStride, std::size_t count) const noexcept;
+
+    /*!
+     * \brief Points view transformation.
+     * \details Same as transformPoints(const Vec3*, Vec3*, std::size_t) const working
+     *          in place on external buffers.
+     * \param points Source points.
+     * \param result Transformed points, may view the same buffer as points.
+     * \note Views should be of the same size, there is an assert for that.
+     */
+    MATH_API void transformPoints(const ConstVec3View& points, const Vec3View& result) const noexcept;
+
+    /*!
+     * \brief Directions view transformation.
+     * \details Same as transformDirections(const Vec3*, Vec3*, std::size_t) const working
+     *          in place on external buffers.
+     * \param directions Source directions.
+     * \param result Transformed directions, may view the same buffer as directions.
+     * \note Views should be of the same size, there is an assert for that.
+     */
+    MATH_API void transformDirections(const ConstVec3View& directions, const Vec3View& result) const noexcept;
+
+    /*!
+     * \brief Vectors view transformation.
+     * \details Same as transform(const Vec4*, Vec4*, std::size_t) const working in place
+     *          on external buffers.
+     * \param vectors Source vectors.
+     * \param result Transformed vectors, may view the same buffer as vectors.
+     * \note Views should be of the same size, there is an assert for that.
+     */
+    MATH_API void transform(const ConstVec4View& vectors, const Vec4View& result) const noexcept;
+
+    /*!
+     * \brief Batch matrices multiplication.
+     * \details Computes result[i] = *this * matrices[i]. Broadcast elements of this matrix
+     *          are loaded once for the whole batch.
+     * \param matrices Right hand side matrices.
+     * \param result Product matrices, may be the same array as matrices.
+     * \param count Number of matrices.
+     * \param layout Layout of the result, COLUMN_MAJOR stores every product transposed.
+     */
+    MATH_API void multiply(const Mat4* matrices, Mat4* result, std::size_t count,
+            Layout layout = ROW_MAJOR) const noexcept;
+
+    /*!
+     * \brief Batch matrices inversion.
+     * \details Computes result[i] as matrices[i] inverted by invert() using the same
+     *          cofactor expansion. With SIMD four matrices are processed at once, every
+     *          register holds the same element of four matrices.
+     * \param matrices Source matrices.
+     * \param result Inverted matrices, may be the same array as matrices.
+     * \param count Number of matrices.
+     * \param layout Layout of the result, COLUMN_MAJOR stores every inverse transposed.
+     * \note Matrices are assumed to be invertible, no check is performed.
+     */
+    MATH_API static void invert(const Mat4* matrices, Mat4* result, std::size_t count,
+            Layout layout = ROW_MAJOR) noexcept;
+
+    /*!
+     * \brief Translation matrix builder.
+     * \param translation Translation vector.
+     * \return Translation matrix.
+     */
+    static constexpr Mat4 translate(const Vec3& translation) noexcept;
+
+    /*!
+     * \brief Scale matrix builder.
+     * \param scale Per-axis scale factors.
+     * \return Scale matrix.
+     */
+    static constexpr Mat4 scale(const Vec3& scale) noexcept;
+
+    /*!
+     * \brief Translation-rotation-scale matrix builder.
+     * \details Writes translate(translation) * rotation.extractMat4() * scale(scale)
+     *          in one pass without intermediate matrices.
+     * \param translation Translation vector.
+     * \param rotation Unit rotation quaternion.
+     * \param scale Per-axis scale factors.
+     * \return Transformation matrix.
+     * \note Rotation is expected to be normalized, no check is performed.
+     */
+    MATH_API static Mat4 fromTRS(const Vec3& translation, const Quaternion& rotation, const Vec3& scale) noexcept;
+
+    /*!
+     * \brief Perspective projection builder.
+     * \details Right-handed projection looking down -Z axis, view depth range
+     *          is mapped to -1..1 (see Frustum).
+     * \param fieldOfView Vertical field of view in radians.
+     * \param aspectRatio Viewport width to height ratio.
+     * \param nearPlane Distance to the near plane.
+     * \param farPlane Distance to the far plane.
+     * \return Projection matrix.
+     */
+    MATH_API static Mat4 perspective(float fieldOfView, float aspectRatio, float nearPlane, float farPlane) noexcept;
+
+    /*!
+     * \brief Orthographic projection builder.
+     * \details Right-handed projection looking down -Z axis, the view box is
+     *          mapped to -1..1 cube.
+     * \param left Left plane X coordinate.
+     * \param right Right plane X coordinate.
+     * \param bottom Bottom plane Y coordinate.
+     * \param top Top plane Y coordinate.
+     * \param nearPlane Distance to the near plane.
+     * \param farPlane Distance to the far plane.
+     * \return Projection matrix.
+     */
+    static constexpr Mat4 orthographic(float left, float right, float bottom, float top,
+            float nearPlane, float farPlane) noexcept;
+
+    /*!
+     * \brief View matrix builder.
+     * \details Right-handed view looking from eye to target, the camera looks
+     *          down -Z axis with Y axis pointing up.
+     * \param eye Camera position.
+     * \param target Point the camera looks at.
+     * \param up Up direction, not necessarily orthogonal to the view direction.
+     * \return View matrix.
+     */
+    MATH_API static Mat4 lookAt(const Vec3& eye, const Vec3& target, const Vec3& up) noexcept;
 
 private:
-    float matrix[4][4];
+    void transformVec3(const float* source, std::size_t sourceStride,
+            float* destination, std::size_t destinationStride, std::size_t count, float w) const noexcept;
+
+    alignas(16) float matrix[4][4];
 };
 
+static_assert(std::is_trivially_copyable<Mat4>::value, "Mat4 should be copied with memcpy");
+static_assert(std::is_nothrow_move_constructible<Mat4>::value && std::is_nothrow_move_assignable<Mat4>::value,
+        "Mat4 should be moved without exceptions");
+
+constexpr Mat4::Mat4() noexcept:
+        matrix{{1.0f, 0.0f, 0.0f, 0.0f},
+               {0.0f, 1.0f, 0.0f, 0.0f},
+               {0.0f, 0.0f, 1.0f, 0.0f},
+               {0.0f, 0.0f, 0.0f, 1.0f}} {
+}
+
+inline Mat4::Mat4(Uninitialized) noexcept {
+}
+
+#if defined(MATH_SIMD_UNINITIALIZED)
+MATH_SIMD_CONSTEXPR Mat4::Mat4(const float* data) noexcept {
+#else
+MATH_SIMD_CONSTEXPR Mat4::Mat4(const float* data) noexcept:
+        matrix() {
+#endif
+    if (MATH_CONSTANT_EVALUATED()) {
+        for (int i = 0; i < 4; i++) {
+            for (int j = 0; j < 4; j++) {
+                this->matrix[i][j] = data[i * 4 + j];
+            }
+        }
+
+        return;
+    }
+
+#if defined(MATH_SIMD)
+    Simd::store(this->matrix[0], Simd::loadu(data));
+    Simd::store(this->matrix[1], Simd::loadu(data + 4));
+    Simd::store(this->matrix[2], Simd::loadu(data + 8));
+    Simd::store(this->matrix[3], Simd::loadu(data + 12));
+#else
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            this->matrix[i][j] = data[i * 4 + j];
+        }
+    }
+#endif
+}
+
+MATH_SIMD_CONSTEXPR Mat4 Mat4::operator *(const Mat4& matrix) const noexcept {
+    if (MATH_CONSTANT_EVALUATED()) {
+        Mat4 result;
+        Mat<4, float>::multiply(this->matrix, matrix.matrix, result.matrix);
+        return result;
+    }
+
+    // Every element is stored below, constant evaluation is the only path needing initialization
+#if defined(MATH_SIMD)
+    Mat4 result(UNINITIALIZED);
+#else
+    Mat4 result;
+#endif
+
+#if defined(MATH_AVX)
+    Simd::Float8 row0 = Simd::duplicate(matrix.matrix[0]);
+    Simd::Float8 row1 = Simd::duplicate(matrix.matrix[1]);
+    Simd::Float8 row2 = Simd::duplicate(matrix.matrix[2]);
+    Simd::Float8 row3 = Simd::duplicate(matrix.matrix[3]);
+
+    // Two rows of the product per iteration, one per 128 bit lane
+    for (int i = 0; i < 4; i += 2) {
+        Simd::Float8 left = Simd::loadu8(this->matrix[i]);
+        Simd::Float8 product = Simd::mul(Simd::broadcast<0>(left), row0);
+        product = Simd::madd(Simd::broadcast<1>(left), row1, product);
+        product = Simd::madd(Simd::broadcast<2>(left), row2, product);
+        product = Simd::madd(Simd::broadcast<3>(left), row3, product);
+        Simd::storeu(result.matrix[i], product);
+    }
+#elif defined(MATH_SIMD)
+    Simd::Float4 row0 = Simd::load(matrix.matrix[0]);
+    Simd::Float4 row1 = Simd::load(matrix.matrix[1]);
+    Simd::Float4 row2 = Simd::load(matrix.matrix[2]);
+    Simd::Float4 row3 = Simd::load(matrix.matrix[3]);
+
+    for (int i = 0; i < 4; i++) {
+        Simd::Float4 left = Simd::load(this->matrix[i]);
+        Simd::Float4 product = Simd::mul(Simd::broadcast<0>(left), row0);
+        product = Simd::madd(Simd::broadcast<1>(left), row1, product);
+        product = Simd::madd(Simd::broadcast<2>(left), row2, product);
+        product = Simd::madd(Simd::broadcast<3>(left), row3, product);
+        Simd::store(result.matrix[i], product);
+    }
+#else
+    Mat<4, float>::multiply(this->matrix, matrix.matrix, result.matrix);
+#endif
+
+    return result;
+}
+
+MATH_SIMD_CONSTEXPR Vec4 Mat4::operator *(const Vec4& vector) const noexcept {
+    if (MATH_CONSTANT_EVALUATED()) {
+        float result[4] = {};
+        Mat<4, float>::transform(this->matrix, vector.data(), result);
+        return Vec4(result[0], result[1], result[2], result[3]);
+    }
+
+#if defined(MATH_SIMD)
+    Simd::Float4 column0 = Simd::load(this->matrix[0]);
+    Simd::Float4 column1 = Simd::load(this->matrix[1]);
+    Simd::Float4 column2 = Simd::load(this->matrix[2]);
+    Simd::Float4 column3 = Simd::load(this->matrix[3]);
+    Simd::transpose(column0, column1, column2, column3);
+
+    Simd::Float4 source = Simd::load(vector.data());
+    Simd::Float4 product = Simd::mul(column0, Simd::broadcast<0>(source));
+    product = Simd::madd(column1, Simd::broadcast<1>(source), product);
+    product = Simd::madd(column2, Simd::broadcast<2>(source), product);
+    product = Simd::madd(column3, Simd::broadcast<3>(source), product);
+
+    alignas(16) float result[4] = {};
+    Simd::store(result, product);
+    return Vec4(result[0], result[1], result[2], result[3]);
+#else
+    float result[4] = {};
+    Mat<4, float>::transform(this->matrix, vector.data(), result);
+    return Vec4(result[0], result[1], result[2], result[3]);
+#endif
+}
+
+constexpr Mat4 Mat4::operator *(float scalar) const noexcept {
+    Mat4 result;
+    Mat<4, float>::scale(this->matrix, scalar, result.matrix);
+    return result;
+}
+
+constexpr Mat4 Mat4::operator +(const Mat4& matrix) const noexcept {
+    Mat4 result;
+    Mat<4, float>::add(this->matrix, matrix.matrix, result.matrix);
+    return result;
+}
+
+constexpr Mat4 Mat4::operator -(const Mat4& matrix) const noexcept {
+    Mat4 result;
+    Mat<4, float>::subtract(this->matrix, matrix.matrix, result.matrix);
+    return result;
+}
+
+constexpr bool Mat4::operator ==(const Mat4& matrix) const noexcept {
+    return Mat<4, float>::equal(this->matrix, matrix.matrix);
+}
+
+constexpr bool Mat4::operator !=(const Mat4& matrix) const noexcept {
+    return !(*this == matrix);
+}
+
+constexpr Mat4& Mat4::transpose() noexcept {
+    Mat<4, float>::transpose(this->matrix);
+    return *this;
+}
+
+constexpr float Mat4::get(int row, int column) const noexcept {
+    assert(row >= 0 && row <= 3);
+    assert(column >= 0 && column <= 3);
+    return this->matrix[row][column];
+}
+
+constexpr void Mat4::set(int row, int column, float value) noexcept {
+    assert(row >= 0 && row <= 3);
+    assert(column >= 0 && column <= 3);
+    this->matrix[row][column] = value;
+}
+
+constexpr const float* Mat4::data() const noexcept {
+    return this->matrix[0];
+}
+
+constexpr Mat4 Mat4::translate(const Vec3& translation) noexcept {
+    Mat4 result;
+    result.matrix[0][3] = translation.get(Vec3::X);
+    result.matrix[1][3] = translation.get(Vec3::Y);
+    result.matrix[2][3] = translation.get(Vec3::Z);
+    return result;
+}
+
+constexpr Mat4 Mat4::scale(const Vec3& scale) noexcept {
+    Mat4 result;
+    result.matrix[0][0] = scale.get(Vec3::X);
+    result.matrix[1][1] = scale.get(Vec3::Y);
+    result.matrix[2][2] = scale.get(Vec3::Z);
+    return result;
+}
+
+constexpr Mat4 Mat4::orthographic(float left, float right, float bottom, float top,
+        float nearPlane, float farPlane) noexcept {
+    Mat4 result;
+    result.matrix[0][0] = 2.0f / (right - left);
+    result.matrix[0][3] = -(right + left) / (right - left);
+    result.matrix[1][1] = 2.0f / (top - bottom);
+    result.matrix[1][3] = -(top + bottom) / (top - bottom);
+    result.matrix[2][2] = -2.0f / (farPlane - nearPlane);
+    result.matrix[2][3] = -(farPlane + nearPlane) / (farPlane - nearPlane);
+    return result;
+}
+
 }  // namespace Math
 
+#ifdef MATH_HEADER_ONLY
+#include <Mat4.inl>
+#endif
+
 #endif  // MAT4_H
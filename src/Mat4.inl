@@ -0,0 +1,458 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MAT4_INL
+#define MAT4_INL
+
+#include <Mat4.h>
+#include <Mat3.h>
+#include <Vec3.h>
+#include <Vec4.h>
+#include <Quaternion.h>
+#include <MathSimd.h>
+#include <Mat.h>
+#include <Dispatch.h>
+#include <Instrumentation.h>
+#include <cmath>
+#include <cassert>
+
+namespace Math {
+
+MATH_INLINE void Mat4::decompose(Mat4& lower, Mat4& upper) const noexcept {
+    MATH_COUNT(MAT4_DECOMPOSE);
+
+    for (int i = 0; i < 4; i++) {
+        for (int j = i; j < 4; j++) {
+            lower.set(i, j, (i == j) ? 1.0f : 0.0f);
+            upper.set(i, j, 0.0f);
+        }
+    }
+
+    for (int i = 0; i < 4; i++) {
+        for (int j = i; j < 4; j++) {
+            upper.set(i, j, this->matrix[i][j]);
+            for (int k = 0; k < i; k++) {
+                upper.set(i, j, upper.get(i, j) - lower.get(i, k) * upper.get(k, j));
+            }
+            upper.set(i, j, upper.get(i, j) / lower.get(i, i));
+        }
+
+        for (int j = i + 1; j < 4; j++) {
+            lower.set(j, i, this->matrix[j][i]);
+            for (int k = 0; k < i; k++) {
+                lower.set(j, i, lower.get(j, i) - lower.get(j, k) * upper.get(k, i));
+            }
+            lower.set(j, i, lower.get(j, i) / upper.get(i, i));
+        }
+    }
+}
+
+MATH_INLINE Mat4& Mat4::invert() noexcept {
+    MATH_COUNT(MAT4_INVERT);
+
+    const float (&m)[4][4] = this->matrix;
+
+    // 2x2 subdeterminants of the upper (s) and lower (c) row pairs
+    float s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+    float s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+    float s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+    float s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+    float s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+    float s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+
+    float c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+    float c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+    float c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+    float c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+    float c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+    float c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+
+    float inverseDeterminant = 1.0f / (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+
+    float inverse[4][4] = {
+        {
+            ( m[1][1] * c5 - m[1][2] * c4 + m[1][3] * c3) * inverseDeterminant,
+            (-m[0][1] * c5 + m[0][2] * c4 - m[0][3] * c3) * inverseDeterminant,
+            ( m[3][1] * s5 - m[3][2] * s4 + m[3][3] * s3) * inverseDeterminant,
+            (-m[2][1] * s5 + m[2][2] * s4 - m[2][3] * s3) * inverseDeterminant
+        },
+        {
+            (-m[1][0] * c5 + m[1][2] * c2 - m[1][3] * c1) * inverseDeterminant,
+            ( m[0][0] * c5 - m[0][2] * c2 + m[0][3] * c1) * inverseDeterminant,
+            (-m[3][0] * s5 + m[3][2] * s2 - m[3][3] * s1) * inverseDeterminant,
+            ( m[2][0] * s5 - m[2][2] * s2 + m[2][3] * s1) * inverseDeterminant
+        },
+        {
+            ( m[1][0] * c4 - m[1][1] * c2 + m[1][3] * c0) * inverseDeterminant,
+            (-m[0][0] * c4 + m[0][1] * c2 - m[0][3] * c0) * inverseDeterminant,
+            ( m[3][0] * s4 - m[3][1] * s2 + m[3][3] * s0) * inverseDeterminant,
+            (-m[2][0] * s4 + m[2][1] * s2 - m[2][3] * s0) * inverseDeterminant
+        },
+        {
+            (-m[1][0] * c3 + m[1][1] * c1 - m[1][2] * c0) * inverseDeterminant,
+            ( m[0][0] * c3 - m[0][1] * c1 + m[0][2] * c0) * inverseDeterminant,
+            (-m[3][0] * s3 + m[3][1] * s1 - m[3][2] * s0) * inverseDeterminant,
+            ( m[2][0] * s3 - m[2][1] * s1 + m[2][2] * s0) * inverseDeterminant
+        }
+    };
+
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            this->matrix[i][j] = inverse[i][j];
+        }
+    }
+
+    return *this;
+}
+
+MATH_INLINE Mat4& Mat4::invertAffine() noexcept {
+    float (&m)[4][4] = this->matrix;
+
+    float c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+    float c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+    float c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+    float inverseDeterminant = 1.0f / (m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02);
+
+    float inverse[3][3] = {
+        {
+            c00 * inverseDeterminant,
+            (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * inverseDeterminant,
+            (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * inverseDeterminant
+        },
+        {
+            c01 * inverseDeterminant,
+            (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * inverseDeterminant,
+            (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * inverseDeterminant
+        },
+        {
+            c02 * inverseDeterminant,
+            (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * inverseDeterminant,
+            (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * inverseDeterminant
+        }
+    };
+
+    float translation[3] = { m[0][3], m[1][3], m[2][3] };
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            m[i][j] = inverse[i][j];
+        }
+
+        m[i][3] = -(inverse[i][0] * translation[0] +
+                    inverse[i][1] * translation[1] +
+                    inverse[i][2] * translation[2]);
+    }
+
+    return *this;
+}
+
+MATH_INLINE Mat4& Mat4::invertRigid() noexcept {
+    float (&m)[4][4] = this->matrix;
+
+    // Uniform scale makes every column of the upper 3x3 block equally long
+    float inverseSquareScale = 1.0f / (m[0][0] * m[0][0] + m[1][0] * m[1][0] + m[2][0] * m[2][0]);
+
+    float inverse[3][3] = {
+        { m[0][0] * inverseSquareScale, m[1][0] * inverseSquareScale, m[2][0] * inverseSquareScale },
+        { m[0][1] * inverseSquareScale, m[1][1] * inverseSquareScale, m[2][1] * inverseSquareScale },
+        { m[0][2] * inverseSquareScale, m[1][2] * inverseSquareScale, m[2][2] * inverseSquareScale }
+    };
+
+    float translation[3] = { m[0][3], m[1][3], m[2][3] };
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            m[i][j] = inverse[i][j];
+        }
+
+        m[i][3] = -(inverse[i][0] * translation[0] +
+                    inverse[i][1] * translation[1] +
+                    inverse[i][2] * translation[2]);
+    }
+
+    return *this;
+}
+
+MATH_INLINE Vec4 Mat4::solveL(const Vec4& absolute) const noexcept {
+    Vec4 solution(UNINITIALIZED);
+
+    for (int i = 0; i < 4; i++) {
+        solution.set(i, absolute.get(i));
+        for (int j = 0; j < i; j++) {
+            solution.set(i, solution.get(i) - this->matrix[i][j] * solution.get(j));
+        }
+        solution.set(i, solution.get(i) / this->matrix[i][i]);
+    }
+
+    return solution;
+}
+
+MATH_INLINE Vec4 Mat4::solveU(const Vec4& absolute) const noexcept {
+    Vec4 solution(UNINITIALIZED);
+
+    for (int i = 3; i > -1; i--) {
+        solution.set(i, absolute.get(i));
+        for (int j = 3; j > i; j--) {
+            solution.set(i, solution.get(i) - this->matrix[i][j] * solution.get(j));
+        }
+        solution.set(i, solution.get(i) / this->matrix[i][i]);
+    }
+
+    return solution;
+}
+
+MATH_INLINE void Mat4::copyTransposed(float* destination) const noexcept {
+#if defined(MATH_SIMD)
+    Simd::Float4 column0 = Simd::load(this->matrix[0]);
+    Simd::Float4 column1 = Simd::load(this->matrix[1]);
+    Simd::Float4 column2 = Simd::load(this->matrix[2]);
+    Simd::Float4 column3 = Simd::load(this->matrix[3]);
+    Simd::transpose(column0, column1, column2, column3);
+
+    Simd::storeu(destination, column0);
+    Simd::storeu(destination + 4, column1);
+    Simd::storeu(destination + 8, column2);
+    Simd::storeu(destination + 12, column3);
+#else
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            destination[j * 4 + i] = this->matrix[i][j];
+        }
+    }
+#endif
+}
+
+MATH_INLINE void Mat4::copyTransposed(const Mat4* matrices, float* destination, std::size_t count,
+        std::size_t destinationStride) noexcept {
+    assert(destinationStride >= 16);
+
+    for (std::size_t i = 0; i < count; i++) {
+        matrices[i].copyTransposed(destination);
+        destination += destinationStride;
+    }
+}
+
+MATH_INLINE Mat3 Mat4::extractMat3() const noexcept {
+    Mat3 result(UNINITIALIZED);
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            result.set(i, j, this->matrix[i][j]);
+        }
+    }
+
+    return result;
+}
+
+MATH_INLINE Mat3 Mat4::normalMatrix() const noexcept {
+    const float (&m)[4][4] = this->matrix;
+
+    float c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+    float c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+    float c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+    float inverseDeterminant = 1.0f / (m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02);
+
+    float cofactors[9] = {
+        c00 * inverseDeterminant,
+        c01 * inverseDeterminant,
+        c02 * inverseDeterminant,
+        (m[2][1] * m[0][2] - m[2][2] * m[0][1]) * inverseDeterminant,
+        (m[2][2] * m[0][0] - m[2][0] * m[0][2]) * inverseDeterminant,
+        (m[2][0] * m[0][1] - m[2][1] * m[0][0]) * inverseDeterminant,
+        (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * inverseDeterminant,
+        (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * inverseDeterminant,
+        (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * inverseDeterminant
+    };
+
+    return Mat3(cofactors);
+}
+
+MATH_INLINE Mat3 Mat4::normalMatrixRigid() const noexcept {
+    const float (&m)[4][4] = this->matrix;
+    float inverseSquareScale = 1.0f / (m[0][0] * m[0][0] + m[1][0] * m[1][0] + m[2][0] * m[2][0]);
+
+    float block[9] = {
+        m[0][0] * inverseSquareScale, m[0][1] * inverseSquareScale, m[0][2] * inverseSquareScale,
+        m[1][0] * inverseSquareScale, m[1][1] * inverseSquareScale, m[1][2] * inverseSquareScale,
+        m[2][0] * inverseSquareScale, m[2][1] * inverseSquareScale, m[2][2] * inverseSquareScale
+    };
+
+    return Mat3(block);
+}
+
+MATH_INLINE void Mat4::transformPoints(const Vec3* points, Vec3* result, std::size_t count) const noexcept {
+    static_assert(sizeof(Vec3) == sizeof(float) * 3, "Vec3 is expected to be tightly packed");
+    this->transformVec3(reinterpret_cast<const float*>(points), 3,
+            reinterpret_cast<float*>(result), 3, count, 1.0f);
+}
+
+MATH_INLINE void Mat4::transformDirections(const Vec3* directions, Vec3* result, std::size_t count) const noexcept {
+    static_assert(sizeof(Vec3) == sizeof(float) * 3, "Vec3 is expected to be tightly packed");
+    this->transformVec3(reinterpret_cast<const float*>(directions), 3,
+            reinterpret_cast<float*>(result), 3, count, 0.0f);
+}
+
+MATH_INLINE void Mat4::transform(const Vec4* vectors, Vec4* result, std::size_t count) const noexcept {
+    static_assert(sizeof(Vec4) == sizeof(float) * 4, "Vec4 is expected to be tightly packed");
+    this->transform(reinterpret_cast<const float*>(vectors), 4, reinterpret_cast<float*>(result), 4, count);
+}
+
+MATH_INLINE void Mat4::transformPoints(const ConstVec3View& points, const Vec3View& result) const noexcept {
+    assert(points.size() == result.size());
+    this->transformVec3(points.data(), points.getStride(), result.data(), result.getStride(), points.size(), 1.0f);
+}
+
+MATH_INLINE void Mat4::transformDirections(const ConstVec3View& directions, const Vec3View& result) const noexcept {
+    assert(directions.size() == result.size());
+    this->transformVec3(directions.data(), directions.getStride(),
+            result.data(), result.getStride(), directions.size(), 0.0f);
+}
+
+MATH_INLINE void Mat4::transform(const ConstVec4View& vectors, const Vec4View& result) const noexcept {
+    assert(vectors.size() == result.size());
+    this->transform(vectors.data(), vectors.getStride(), result.data(), result.getStride(), vectors.size());
+}
+
+MATH_INLINE void Mat4::multiply(const Mat4* matrices, Mat4* result, std::size_t count, Layout layout) const noexcept {
+    MATH_PROBE(MAT4_MULTIPLY_BATCH, count);
+
+    static_assert(sizeof(Mat4) == sizeof(float) * 16, "Mat4 is expected to be tightly packed");
+    Dispatch::getKernels().multiply(this->matrix[0], reinterpret_cast<const float*>(matrices),
+            reinterpret_cast<float*>(result), count, layout == COLUMN_MAJOR);
+}
+
+MATH_INLINE void Mat4::invert(const Mat4* matrices, Mat4* result, std::size_t count, Layout layout) noexcept {
+    MATH_PROBE(MAT4_INVERT_BATCH, count);
+
+    static_assert(sizeof(Mat4) == sizeof(float) * 16, "Mat4 is expected to be tightly packed");
+    std::size_t k = Dispatch::getKernels().invert(reinterpret_cast<const float*>(matrices),
+            reinterpret_cast<float*>(result), count, layout == COLUMN_MAJOR);
+
+    for (; k < count; k++) {
+        Mat4 inverse(matrices[k]);
+        inverse.invert();
+        if (layout == COLUMN_MAJOR) {
+            inverse.transpose();
+        }
+
+        result[k] = inverse;
+    }
+}
+
+MATH_INLINE void Mat4::transformPoints(const float* points, std::size_t pointsStride,
+        float* result, std::size_t resultStride, std::size_t count) const noexcept {
+    this->transformVec3(points, pointsStride, result, resultStride, count, 1.0f);
+}
+
+MATH_INLINE void Mat4::transformDirections(const float* directions, std::size_t directionsStride,
+        float* result, std::size_t resultStride, std::size_t count) const noexcept {
+    this->transformVec3(directions, directionsStride, result, resultStride, count, 0.0f);
+}
+
+MATH_INLINE void Mat4::transform(const float* vectors, std::size_t vectorsStride,
+        float* result, std::size_t resultStride, std::size_t count) const noexcept {
+    MATH_PROBE(MAT4_TRANSFORM_BATCH, count);
+
+    Dispatch::getKernels().transform(this->matrix[0], vectors, vectorsStride, result, resultStride, count);
+}
+
+MATH_INLINE void Mat4::transformVec3(const float* source, std::size_t sourceStride,
+        float* destination, std::size_t destinationStride, std::size_t count, float w) const noexcept {
+    MATH_PROBE(MAT4_TRANSFORM_BATCH, count);
+
+    Dispatch::getKernels().transformVec3(this->matrix[0], source, sourceStride,
+            destination, destinationStride, count, w);
+}
+
+MATH_INLINE Mat4 Mat4::fromTRS(const Vec3& translation, const Quaternion& rotation, const Vec3& scale) noexcept {
+    float x = rotation.get(Quaternion::X);
+    float y = rotation.get(Quaternion::Y);
+    float z = rotation.get(Quaternion::Z);
+    float w = rotation.get(Quaternion::W);
+
+    float scaleX = scale.get(Vec3::X);
+    float scaleY = scale.get(Vec3::Y);
+    float scaleZ = scale.get(Vec3::Z);
+
+    // Rotation columns scaled per axis, translation goes to the last column
+    Mat4 result(UNINITIALIZED);
+    result.matrix[0][0] = (1.0f - 2.0f * (y * y + z * z)) * scaleX;
+    result.matrix[0][1] = 2.0f * (x * y - z * w) * scaleY;
+    result.matrix[0][2] = 2.0f * (x * z + y * w) * scaleZ;
+    result.matrix[0][3] = translation.get(Vec3::X);
+
+    result.matrix[1][0] = 2.0f * (x * y + z * w) * scaleX;
+    result.matrix[1][1] = (1.0f - 2.0f * (x * x + z * z)) * scaleY;
+    result.matrix[1][2] = 2.0f * (y * z - x * w) * scaleZ;
+    result.matrix[1][3] = translation.get(Vec3::Y);
+
+    result.matrix[2][0] = 2.0f * (x * z - y * w) * scaleX;
+    result.matrix[2][1] = 2.0f * (y * z + x * w) * scaleY;
+    result.matrix[2][2] = (1.0f - 2.0f * (x * x + y * y)) * scaleZ;
+    result.matrix[2][3] = translation.get(Vec3::Z);
+
+    result.matrix[3][0] = 0.0f;
+    result.matrix[3][1] = 0.0f;
+    result.matrix[3][2] = 0.0f;
+    result.matrix[3][3] = 1.0f;
+
+    return result;
+}
+
+MATH_INLINE Mat4 Mat4::perspective(float fieldOfView, float aspectRatio, float nearPlane, float farPlane) noexcept {
+    float focalLength = 1.0f / tanf(fieldOfView / 2.0f);
+
+    Mat4 result;
+    result.matrix[0][0] = focalLength / aspectRatio;
+    result.matrix[1][1] = focalLength;
+    result.matrix[2][2] = (farPlane + nearPlane) / (nearPlane - farPlane);
+    result.matrix[2][3] = 2.0f * farPlane * nearPlane / (nearPlane - farPlane);
+    result.matrix[3][2] = -1.0f;
+    result.matrix[3][3] = 0.0f;
+    return result;
+}
+
+MATH_INLINE Mat4 Mat4::lookAt(const Vec3& eye, const Vec3& target, const Vec3& up) noexcept {
+    Vec3 forward(target - eye);
+    forward.normalize();
+
+    Vec3 right(forward.cross(up));
+    right.normalize();
+
+    Vec3 upward(right.cross(forward));
+
+    Mat4 result;
+    for (int i = 0; i < 3; i++) {
+        result.matrix[0][i] = right.get(i);
+        result.matrix[1][i] = upward.get(i);
+        result.matrix[2][i] = -forward.get(i);
+    }
+
+    result.matrix[0][3] = -right.dot(eye);
+    result.matrix[1][3] = -upward.dot(eye);
+    result.matrix[2][3] = forward.dot(eye);
+    return result;
+}
+
+}  // namespace Math
+
+#endif  // MAT4_INL
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MATLU_H
+#define MATLU_H
+
+#include <LU.h>
+#include <cstddef>
+#include <cassert>
+
+namespace Math {
+
+/*!
+ * \brief Square matrix LU factorization.
+ * \details MatLU<N, Matrix, Vector> keeps P * A = L * U with partial pivoting of a
+ *          Mat3 or Mat4, see LU<N, T>. Unlike decompose() of the matrix it factorizes
+ *          once and solves for any number of absolute vectors, vanished pivots are
+ *          reported by isSingular(). Use LU3 and LU4 aliases.
+ */
+template<int N, typename Matrix, typename Vector>
+class MatLU {
+public:
+    /*!
+     * \brief Default constructor.
+     * \details Constructs the identity matrix factorization.
+     */
+    constexpr MatLU();
+
+    /*!
+     * \brief Factorizing constructor.
+     * \param matrix Factorized matrix.
+     */
+    explicit constexpr MatLU(const Matrix& matrix);
+
+    /*!
+     * \brief Singularity check.
+     * \return true if a pivot has vanished during factorization, false otherwise.
+     */
+    constexpr bool isSingular() const;
+
+    /*!
+     * \brief Matrix determinant calculation.
+     * \return Product of U diagonal with the permutation sign, 0 if matrix is singular.
+     */
+    constexpr float determinant() const;
+
+    /*!
+     * \brief Solve matrix equation A * X = B.
+     * \param absolute Vector of absolute values.
+     * \param solution Vector of unknown values.
+     * \return false if matrix is singular and solution is left untouched, true otherwise.
+     */
+    constexpr bool solve(const Vector& absolute, Vector& solution) const;
+
+    /*!
+     * \brief Solve matrix equation A * X = B for a batch of absolute vectors.
+     * \param absolute Array of absolute vectors.
+     * \param solution Array of unknown vectors.
+     * \param count Number of vectors.
+     * \return false if matrix is singular and solution is left untouched, true otherwise.
+     * \note solution may alias absolute.
+     */
+    constexpr bool solve(const Vector* absolute, Vector* solution, std::size_t count) const;
+
+    /*!
+     * \brief Lower triangular matrix selector.
+     * \return L with the unit diagonal.
+     */
+    constexpr Matrix getLower() const;
+
+    /*!
+     * \brief Upper triangular matrix selector.
+     * \return U.
+     */
+    constexpr Matrix getUpper() const;
+
+    /*!
+     * \brief Row permutation selector.
+     * \param row Row of the factorized matrix.
+     * \return Row of the source matrix that was pivoted into row.
+     * \note There is an assert for row bounds.
+     */
+    constexpr int getPivot(int row) const;
+
+private:
+    LU<N, float> lu;
+};
+
+template<int N, typename Matrix, typename Vector>
+constexpr MatLU<N, Matrix, Vector>::MatLU():
+        lu() {
+}
+
+template<int N, typename Matrix, typename Vector>
+constexpr MatLU<N, Matrix, Vector>::MatLU(const Matrix& matrix):
+        lu() {
+    float values[N * N] = {};
+
+    // data() points to the first row only, constant evaluation rejects reading past it
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < N; j++) {
+            values[i * N + j] = matrix.get(i, j);
+        }
+    }
+
+    this->lu = LU<N, float>(values);
+}
+
+template<int N, typename Matrix, typename Vector>
+constexpr bool MatLU<N, Matrix, Vector>::isSingular() const {
+    return this->lu.isSingular();
+}
+
+template<int N, typename Matrix, typename Vector>
+constexpr float MatLU<N, Matrix, Vector>::determinant() const {
+    return this->lu.determinant();
+}
+
+template<int N, typename Matrix, typename Vector>
+constexpr bool MatLU<N, Matrix, Vector>::solve(const Vector& absolute, Vector& solution) const {
+    return this->solve(&absolute, &solution, 1);
+}
+
+template<int N, typename Matrix, typename Vector>
+constexpr bool MatLU<N, Matrix, Vector>::solve(const Vector* absolute, Vector* solution, std::size_t count) const {
+    if (this->lu.isSingular()) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < count; i++) {
+        float values[N] = {};
+        this->lu.solve(absolute[i].data(), values);
+        for (int j = 0; j < N; j++) {
+            solution[i].set(j, values[j]);
+        }
+    }
+
+    return true;
+}
+
+template<int N, typename Matrix, typename Vector>
+constexpr Matrix MatLU<N, Matrix, Vector>::getLower() const {
+    Matrix lower;
+
+    for (int i = 1; i < N; i++) {
+        for (int j = 0; j < i; j++) {
+            lower.set(i, j, this->lu.get(i, j));
+        }
+    }
+
+    return lower;
+}
+
+template<int N, typename Matrix, typename Vector>
+constexpr Matrix MatLU<N, Matrix, Vector>::getUpper() const {
+    Matrix upper;
+
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < N; j++) {
+            upper.set(i, j, (j < i) ? 0.0f : this->lu.get(i, j));
+        }
+    }
+
+    return upper;
+}
+
+template<int N, typename Matrix, typename Vector>
+constexpr int MatLU<N, Matrix, Vector>::getPivot(int row) const {
+    assert(row >= 0 && row < N);
+    return this->lu.getPivot(row);
+}
+
+}  // namespace Math
+
+#endif  // MATLU_H
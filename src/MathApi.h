@@ -23,7 +23,9 @@
 #ifndef MATHAPI_H
 #define MATHAPI_H
 
-#if defined(_WIN32)
+#if defined(MATH_HEADER_ONLY)
+#define MATH_API
+#elif defined(_WIN32)
 #ifdef MATH_EXPORT
 #define MATH_API __declspec(dllexport)
 #else
@@ -33,4 +35,14 @@
 #define MATH_API
 #endif
 
+/*
+ * Definitions live in *.inl files which are either compiled into the library
+ * or included by the headers when MATH_HEADER_ONLY is defined.
+ */
+#ifdef MATH_HEADER_ONLY
+#define MATH_INLINE inline
+#else
+#define MATH_INLINE
+#endif
+
 #endif  // MATHAPI_H
@@ -0,0 +1,551 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MATHSIMD_H
+#define MATHSIMD_H
+
+/*
+ * Compile time SIMD selection. Kernels check MATH_SIMD (and MATH_AVX for 256 bit
+ * paths, MATH_F16C for half conversions) and fall back to the scalar reference
+ * code otherwise. Define MATH_SCALAR to force the scalar code regardless of the
+ * target instruction set.
+ */
+#if !defined(MATH_SCALAR)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATH_SSE2
+#if defined(__AVX__)
+#define MATH_AVX
+#if defined(__F16C__)
+#define MATH_F16C
+#endif
+#endif
+// GCC and Clang keep FMA apart from AVX2, MSVC /arch:AVX2 enables both
+#if defined(__FMA__) || (defined(_MSC_VER) && !defined(__clang__) && defined(__AVX2__))
+#define MATH_FMA
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define MATH_NEON
+#endif
+#endif
+
+#if defined(MATH_SSE2) || defined(MATH_NEON)
+#define MATH_SIMD
+#endif
+
+/*
+ * Wrappers live in an inline namespace named after the instruction set, the library
+ * compiles kernels with several flag sets (see Dispatch) and the linker must not merge
+ * out of line copies built for different targets.
+ */
+#if defined(__AVX2__) && defined(MATH_FMA)
+#define MATH_SIMD_ISA Avx2
+#elif defined(MATH_AVX)
+#define MATH_SIMD_ISA Avx
+#elif defined(MATH_SSE2)
+#define MATH_SIMD_ISA Sse2
+#elif defined(MATH_NEON)
+#define MATH_SIMD_ISA Neon
+#else
+#define MATH_SIMD_ISA Scalar
+#endif
+
+/*
+ * Intrinsics cannot be evaluated at compile time. Members having SIMD paths are
+ * declared MATH_SIMD_CONSTEXPR and take the scalar path when MATH_CONSTANT_EVALUATED()
+ * holds. Without the compiler builtin they stay plain inline functions.
+ */
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define MATH_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#elif defined(_MSC_VER) && _MSC_VER >= 1925
+#define MATH_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+
+#if defined(MATH_CONSTANT_EVALUATED) || !defined(MATH_SIMD)
+#define MATH_SIMD_CONSTEXPR constexpr
+#else
+#define MATH_SIMD_CONSTEXPR inline
+#endif
+
+/*
+ * C++17 constexpr constructors have to initialize every member even if the runtime
+ * path overwrites it. MATH_SIMD_CONSTEXPR constructors skip that initialization
+ * where MATH_SIMD_UNINITIALIZED is defined: when they are not constexpr at all or
+ * C++20 lifts the requirement.
+ */
+#if (defined(MATH_SIMD) && !defined(MATH_CONSTANT_EVALUATED)) || \
+        (defined(__cpp_constexpr) && __cpp_constexpr >= 201907L)
+#define MATH_SIMD_UNINITIALIZED
+#endif
+
+#if !defined(MATH_CONSTANT_EVALUATED)
+#define MATH_CONSTANT_EVALUATED() false
+#endif
+
+#if defined(MATH_AVX)
+#include <immintrin.h>
+#elif defined(MATH_SSE2)
+#include <emmintrin.h>
+#elif defined(MATH_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace Math {
+
+namespace Simd {
+
+inline namespace MATH_SIMD_ISA {
+
+#if defined(MATH_SSE2)
+
+typedef __m128 Float4;
+
+inline Float4 load(const float* data) {
+    return _mm_load_ps(data);
+}
+
+inline Float4 loadu(const float* data) {
+    return _mm_loadu_ps(data);
+}
+
+inline void store(float* data, Float4 value) {
+    _mm_store_ps(data, value);
+}
+
+inline void storeu(float* data, Float4 value) {
+    _mm_storeu_ps(data, value);
+}
+
+inline void store3(float* data, Float4 value) {
+    _mm_storel_pi(reinterpret_cast<__m64*>(data), value);
+    _mm_store_ss(data + 2, _mm_movehl_ps(value, value));
+}
+
+inline Float4 set(float x, float y, float z, float w) {
+    return _mm_setr_ps(x, y, z, w);
+}
+
+inline Float4 splat(float value) {
+    return _mm_set1_ps(value);
+}
+
+template<int lane>
+inline Float4 broadcast(Float4 value) {
+    return _mm_shuffle_ps(value, value, _MM_SHUFFLE(lane, lane, lane, lane));
+}
+
+inline Float4 add(Float4 a, Float4 b) {
+    return _mm_add_ps(a, b);
+}
+
+inline Float4 sub(Float4 a, Float4 b) {
+    return _mm_sub_ps(a, b);
+}
+
+inline Float4 mul(Float4 a, Float4 b) {
+    return _mm_mul_ps(a, b);
+}
+
+inline Float4 div(Float4 a, Float4 b) {
+    return _mm_div_ps(a, b);
+}
+
+inline Float4 sqrt(Float4 value) {
+    return _mm_sqrt_ps(value);
+}
+
+inline Float4 rsqrt(Float4 value) {
+    // 12 bit estimate refined by one Newton-Raphson step y * (1.5 - 0.5 * x * y * y)
+    Float4 estimate = _mm_rsqrt_ps(value);
+    Float4 half = _mm_mul_ps(value, _mm_set1_ps(0.5f));
+    Float4 step = _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(half, _mm_mul_ps(estimate, estimate)));
+    return _mm_mul_ps(estimate, step);
+}
+
+inline float rsqrt(float value) {
+    float estimate = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(value)));
+    return estimate * (1.5f - 0.5f * value * estimate * estimate);
+}
+
+inline Float4 madd(Float4 a, Float4 b, Float4 c) {
+#if defined(MATH_FMA)
+    return _mm_fmadd_ps(a, b, c);
+#else
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+inline Float4 abs(Float4 value) {
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), value);
+}
+
+inline Float4 reverse(Float4 value) {
+    return _mm_shuffle_ps(value, value, _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+inline Float4 swapPairs(Float4 value) {
+    return _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+inline Float4 swapHalves(Float4 value) {
+    return _mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 0, 3, 2));
+}
+
+inline Float4 xorSign(Float4 value, Float4 sign) {
+    return _mm_xor_ps(value, _mm_and_ps(sign, _mm_set1_ps(-0.0f)));
+}
+
+inline void transpose(Float4& row0, Float4& row1, Float4& row2, Float4& row3) {
+    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+}
+
+inline Float4 compareLess(Float4 a, Float4 b) {
+    return _mm_cmplt_ps(a, b);
+}
+
+inline Float4 maskOr(Float4 a, Float4 b) {
+    return _mm_or_ps(a, b);
+}
+
+inline int maskBits(Float4 mask) {
+    return _mm_movemask_ps(mask);
+}
+
+inline Float4 min(Float4 a, Float4 b) {
+    return _mm_min_ps(a, b);
+}
+
+inline Float4 max(Float4 a, Float4 b) {
+    return _mm_max_ps(a, b);
+}
+
+inline Float4 select(Float4 mask, Float4 a, Float4 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+/*
+ * Unsigned 32 bit lanes for bit packing, loadShorts() and storeShorts() widen and
+ * narrow four 16 bit values. Lanes converted from and to Float4 are expected to
+ * fit 31 bits.
+ */
+typedef __m128i Int4;
+
+inline Int4 loadu(const unsigned int* data) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+}
+
+inline void storeu(unsigned int* data, Int4 value) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(data), value);
+}
+
+inline Int4 loadShorts(const unsigned short* data) {
+    __m128i shorts = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(data));
+    return _mm_unpacklo_epi16(shorts, _mm_setzero_si128());
+}
+
+inline void storeShorts(unsigned short* data, Int4 value) {
+    // Signed saturation only, the bias keeps 16 bit values intact
+    __m128i bias = _mm_set1_epi32(0x8000);
+    __m128i shorts = _mm_packs_epi32(_mm_sub_epi32(value, bias), _mm_sub_epi32(value, bias));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(data), _mm_xor_si128(shorts, _mm_set1_epi16(-0x8000)));
+}
+
+inline Int4 splatBits(unsigned int value) {
+    return _mm_set1_epi32(static_cast<int>(value));
+}
+
+inline Int4 truncate(Float4 value) {
+    return _mm_cvttps_epi32(value);
+}
+
+inline Float4 toFloat(Int4 value) {
+    return _mm_cvtepi32_ps(value);
+}
+
+template<int bits>
+inline Int4 shiftLeft(Int4 value) {
+    return _mm_slli_epi32(value, bits);
+}
+
+template<int bits>
+inline Int4 shiftRight(Int4 value) {
+    return _mm_srli_epi32(value, bits);
+}
+
+inline Int4 bitOr(Int4 a, Int4 b) {
+    return _mm_or_si128(a, b);
+}
+
+inline Int4 bitAnd(Int4 a, Int4 b) {
+    return _mm_and_si128(a, b);
+}
+
+#elif defined(MATH_NEON)
+
+typedef float32x4_t Float4;
+
+inline Float4 load(const float* data) {
+    return vld1q_f32(data);
+}
+
+inline Float4 loadu(const float* data) {
+    return vld1q_f32(data);
+}
+
+inline void store(float* data, Float4 value) {
+    vst1q_f32(data, value);
+}
+
+inline void storeu(float* data, Float4 value) {
+    vst1q_f32(data, value);
+}
+
+inline void store3(float* data, Float4 value) {
+    vst1_f32(data, vget_low_f32(value));
+    vst1q_lane_f32(data + 2, value, 2);
+}
+
+inline Float4 set(float x, float y, float z, float w) {
+    float data[4] = { x, y, z, w };
+    return vld1q_f32(data);
+}
+
+inline Float4 splat(float value) {
+    return vdupq_n_f32(value);
+}
+
+template<int lane>
+inline Float4 broadcast(Float4 value) {
+#if defined(__aarch64__) || defined(_M_ARM64)
+    return vdupq_laneq_f32(value, lane);
+#else
+    return vdupq_n_f32(vgetq_lane_f32(value, lane));
+#endif
+}
+
+inline Float4 add(Float4 a, Float4 b) {
+    return vaddq_f32(a, b);
+}
+
+inline Float4 sub(Float4 a, Float4 b) {
+    return vsubq_f32(a, b);
+}
+
+inline Float4 mul(Float4 a, Float4 b) {
+    return vmulq_f32(a, b);
+}
+
+inline Float4 div(Float4 a, Float4 b) {
+#if defined(__aarch64__) || defined(_M_ARM64)
+    return vdivq_f32(a, b);
+#else
+    Float4 reciprocal = vrecpeq_f32(b);
+    reciprocal = vmulq_f32(vrecpsq_f32(b, reciprocal), reciprocal);
+    reciprocal = vmulq_f32(vrecpsq_f32(b, reciprocal), reciprocal);
+    return vmulq_f32(a, reciprocal);
+#endif
+}
+
+inline Float4 sqrt(Float4 value) {
+#if defined(__aarch64__) || defined(_M_ARM64)
+    return vsqrtq_f32(value);
+#else
+    Float4 estimate = vrsqrteq_f32(value);
+    estimate = vmulq_f32(vrsqrtsq_f32(vmulq_f32(value, estimate), estimate), estimate);
+    estimate = vmulq_f32(vrsqrtsq_f32(vmulq_f32(value, estimate), estimate), estimate);
+    return vbslq_f32(vceqq_f32(value, vdupq_n_f32(0.0f)), value, vmulq_f32(value, estimate));
+#endif
+}
+
+inline Float4 rsqrt(Float4 value) {
+    // 8 bit estimate refined by one Newton-Raphson step
+    Float4 estimate = vrsqrteq_f32(value);
+    return vmulq_f32(vrsqrtsq_f32(vmulq_f32(value, estimate), estimate), estimate);
+}
+
+inline float rsqrt(float value) {
+    return vgetq_lane_f32(rsqrt(vdupq_n_f32(value)), 0);
+}
+
+inline Float4 madd(Float4 a, Float4 b, Float4 c) {
+#if defined(__aarch64__) || defined(_M_ARM64)
+    return vfmaq_f32(c, a, b);
+#else
+    return vmlaq_f32(c, a, b);
+#endif
+}
+
+inline Float4 abs(Float4 value) {
+    return vabsq_f32(value);
+}
+
+inline Float4 reverse(Float4 value) {
+    Float4 pairs = vrev64q_f32(value);
+    return vcombine_f32(vget_high_f32(pairs), vget_low_f32(pairs));
+}
+
+inline Float4 swapPairs(Float4 value) {
+    return vrev64q_f32(value);
+}
+
+inline Float4 swapHalves(Float4 value) {
+    return vcombine_f32(vget_high_f32(value), vget_low_f32(value));
+}
+
+inline Float4 xorSign(Float4 value, Float4 sign) {
+    uint32x4_t signBit = vandq_u32(vreinterpretq_u32_f32(sign), vdupq_n_u32(0x80000000u));
+    return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(value), signBit));
+}
+
+inline void transpose(Float4& row0, Float4& row1, Float4& row2, Float4& row3) {
+    float32x4x2_t rows01 = vtrnq_f32(row0, row1);
+    float32x4x2_t rows23 = vtrnq_f32(row2, row3);
+    row0 = vcombine_f32(vget_low_f32(rows01.val[0]), vget_low_f32(rows23.val[0]));
+    row1 = vcombine_f32(vget_low_f32(rows01.val[1]), vget_low_f32(rows23.val[1]));
+    row2 = vcombine_f32(vget_high_f32(rows01.val[0]), vget_high_f32(rows23.val[0]));
+    row3 = vcombine_f32(vget_high_f32(rows01.val[1]), vget_high_f32(rows23.val[1]));
+}
+
+inline Float4 compareLess(Float4 a, Float4 b) {
+    return vreinterpretq_f32_u32(vcltq_f32(a, b));
+}
+
+inline Float4 maskOr(Float4 a, Float4 b) {
+    return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+}
+
+inline int maskBits(Float4 mask) {
+    const uint32_t weights[4] = { 1u, 2u, 4u, 8u };
+    uint32x4_t bits = vandq_u32(vreinterpretq_u32_f32(mask), vld1q_u32(weights));
+#if defined(__aarch64__) || defined(_M_ARM64)
+    return static_cast<int>(vaddvq_u32(bits));
+#else
+    uint32x2_t sum = vadd_u32(vget_low_u32(bits), vget_high_u32(bits));
+    return static_cast<int>(vget_lane_u32(vpadd_u32(sum, sum), 0));
+#endif
+}
+
+inline Float4 min(Float4 a, Float4 b) {
+    return vminq_f32(a, b);
+}
+
+inline Float4 max(Float4 a, Float4 b) {
+    return vmaxq_f32(a, b);
+}
+
+inline Float4 select(Float4 mask, Float4 a, Float4 b) {
+    return vbslq_f32(vreinterpretq_u32_f32(mask), a, b);
+}
+
+typedef uint32x4_t Int4;
+
+inline Int4 loadu(const unsigned int* data) {
+    return vld1q_u32(data);
+}
+
+inline void storeu(unsigned int* data, Int4 value) {
+    vst1q_u32(data, value);
+}
+
+inline Int4 loadShorts(const unsigned short* data) {
+    return vmovl_u16(vld1_u16(data));
+}
+
+inline void storeShorts(unsigned short* data, Int4 value) {
+    vst1_u16(data, vmovn_u32(value));
+}
+
+inline Int4 splatBits(unsigned int value) {
+    return vdupq_n_u32(value);
+}
+
+inline Int4 truncate(Float4 value) {
+    return vcvtq_u32_f32(value);
+}
+
+inline Float4 toFloat(Int4 value) {
+    return vcvtq_f32_u32(value);
+}
+
+template<int bits>
+inline Int4 shiftLeft(Int4 value) {
+    return vshlq_n_u32(value, bits);
+}
+
+template<int bits>
+inline Int4 shiftRight(Int4 value) {
+    return vshrq_n_u32(value, bits);
+}
+
+inline Int4 bitOr(Int4 a, Int4 b) {
+    return vorrq_u32(a, b);
+}
+
+inline Int4 bitAnd(Int4 a, Int4 b) {
+    return vandq_u32(a, b);
+}
+
+#endif
+
+#if defined(MATH_AVX)
+
+typedef __m256 Float8;
+
+inline Float8 loadu8(const float* data) {
+    return _mm256_loadu_ps(data);
+}
+
+inline void storeu(float* data, Float8 value) {
+    _mm256_storeu_ps(data, value);
+}
+
+inline Float8 duplicate(const float* data) {
+    return _mm256_broadcast_ps(reinterpret_cast<const __m128*>(data));
+}
+
+template<int lane>
+inline Float8 broadcast(Float8 value) {
+    return _mm256_permute_ps(value, _MM_SHUFFLE(lane, lane, lane, lane));
+}
+
+inline Float8 mul(Float8 a, Float8 b) {
+    return _mm256_mul_ps(a, b);
+}
+
+inline Float8 madd(Float8 a, Float8 b, Float8 c) {
+#if defined(MATH_FMA)
+    return _mm256_fmadd_ps(a, b, c);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+}
+
+#endif
+
+}  // namespace MATH_SIMD_ISA
+
+}  // namespace Simd
+
+}  // namespace Math
+
+#endif  // MATHSIMD_H
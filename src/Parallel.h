@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <MathApi.h>
+#include <Executor.h>
+#include <View.h>
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+
+namespace Math {
+
+class Mat4;
+class Quaternion;
+class Vec3;
+class Vec4;
+class Vec3SoA;
+class Vec4SoA;
+
+/*!
+ * \brief Parallel batch operations.
+ * \details Batch operations split into chunks executed by an Executor. Chunks
+ *          start on cache line boundaries relative to the array start, so that
+ *          no two tasks write the same line, and are large enough to amortize
+ *          scheduling.
+ */
+namespace Parallel {
+
+constexpr std::size_t CACHE_LINE = 64;             /*!< Chunk alignment in bytes. */
+constexpr std::size_t MIN_CHUNK_BYTES = 64 * 1024;  /*!< Smallest chunk worth a task. */
+constexpr std::size_t CHUNKS_PER_THREAD = 4;        /*!< Chunks per thread for load balancing. */
+
+/*!
+ * \brief Chunk size calculation.
+ * \param count Number of elements.
+ * \param elementSize Element size in bytes.
+ * \param concurrency Number of threads.
+ * \return Number of elements per chunk, chunk size in bytes is a multiple of #CACHE_LINE.
+ */
+inline std::size_t chunkSize(std::size_t count, std::size_t elementSize, std::size_t concurrency) {
+    std::size_t grain = CACHE_LINE / std::gcd(CACHE_LINE, elementSize);
+    std::size_t chunks = std::max<std::size_t>(concurrency, 1) * CHUNKS_PER_THREAD;
+    std::size_t chunk = std::max((count + chunks - 1) / chunks, MIN_CHUNK_BYTES / elementSize);
+    return (chunk + grain - 1) / grain * grain;
+}
+
+/*!
+ * \brief Chunked loop.
+ * \details Calls function(first, count) for consecutive chunks covering 0..count - 1,
+ *          small arrays are processed by a single call on the calling thread.
+ * \param executor Executor running the chunks.
+ * \param count Number of elements.
+ * \param elementSize Element size in bytes.
+ * \param function Chunk body.
+ */
+template<typename Function>
+void forEach(Executor& executor, std::size_t count, std::size_t elementSize, Function function) {
+    std::size_t chunk = chunkSize(count, elementSize, executor.concurrency());
+    std::size_t chunks = (count + chunk - 1) / chunk;
+
+    if (chunks < 2) {
+        if (count > 0) {
+            function(std::size_t(0), count);
+        }
+
+        return;
+    }
+
+    executor.run(chunks, [&function, chunk, count](std::size_t index) {
+        std::size_t first = index * chunk;
+        function(first, std::min(chunk, count - first));
+    });
+}
+
+/*!
+ * \brief Parallel Mat4::transformPoints(const Vec3*, Vec3*, std::size_t) const.
+ * \param executor Executor running the chunks.
+ * \param matrix Transformation matrix.
+ * \param points First source point.
+ * \param result First transformed point.
+ * \param count Number of points.
+ */
+MATH_API void transformPoints(Executor& executor, const Mat4& matrix,
+        const Vec3* points, Vec3* result, std::size_t count);
+
+/*!
+ * \brief Parallel Mat4::transformDirections(const Vec3*, Vec3*, std::size_t) const.
+ * \param executor Executor running the chunks.
+ * \param matrix Transformation matrix.
+ * \param directions First source direction.
+ * \param result First transformed direction.
+ * \param count Number of directions.
+ */
+MATH_API void transformDirections(Executor& executor, const Mat4& matrix,
+        const Vec3* directions, Vec3* result, std::size_t count);
+
+/*!
+ * \brief Parallel Mat4::transform(const Vec4*, Vec4*, std::size_t) const.
+ * \param executor Executor running the chunks.
+ * \param matrix Transformation matrix.
+ * \param vectors First source vector.
+ * \param result First transformed vector.
+ * \param count Number of vectors.
+ */
+MATH_API void transform(Executor& executor, const Mat4& matrix,
+        const Vec4* vectors, Vec4* result, std::size_t count);
+
+/*!
+ * \brief Parallel Mat4::transformPoints(const ConstVec3View&, const Vec3View&) const.
+ * \param executor Executor running the chunks.
+ * \param matrix Transformation matrix.
+ * \param points Source points.
+ * \param result Transformed points.
+ */
+MATH_API void transformPoints(Executor& executor, const Mat4& matrix,
+        const ConstVec3View& points, const Vec3View& result);
+
+/*!
+ * \brief Parallel Mat4::transformDirections(const ConstVec3View&, const Vec3View&) const.
+ * \param executor Executor running the chunks.
+ * \param matrix Transformation matrix.
+ * \param directions Source directions.
+ * \param result Transformed directions.
+ */
+MATH_API void transformDirections(Executor& executor, const Mat4& matrix,
+        const ConstVec3View& directions, const Vec3View& result);
+
+/*!
+ * \brief Parallel Mat4::transform(const ConstVec4View&, const Vec4View&) const.
+ * \param executor Executor running the chunks.
+ * \param matrix Transformation matrix.
+ * \param vectors Source vectors.
+ * \param result Transformed vectors.
+ */
+MATH_API void transform(Executor& executor, const Mat4& matrix,
+        const ConstVec4View& vectors, const Vec4View& result);
+
+/*!
+ * \brief Parallel Quaternion::rotate(const Vec3*, Vec3*, std::size_t) const.
+ * \param executor Executor running the chunks.
+ * \param quaternion Unit rotation quaternion.
+ * \param vectors First source vector.
+ * \param result First rotated vector.
+ * \param count Number of vectors.
+ */
+MATH_API void rotate(Executor& executor, const Quaternion& quaternion,
+        const Vec3* vectors, Vec3* result, std::size_t count);
+
+/*!
+ * \brief Parallel matrices inversion.
+ * \details Computes result[i] = matrices[i] inverted, every chunk goes through
+ *          Mat4::invert(const Mat4*, Mat4*, std::size_t, Mat4::Layout).
+ * \param executor Executor running the chunks.
+ * \param matrices First source matrix.
+ * \param result First inverted matrix, may be the same as matrices.
+ * \param count Number of matrices.
+ */
+MATH_API void invert(Executor& executor, const Mat4* matrices, Mat4* result, std::size_t count);
+
+/*!
+ * \brief Parallel Vec3SoA::dot(const Vec3SoA&, float*) const.
+ * \param executor Executor running the chunks.
+ * \param left Vector multiplicands.
+ * \param right Vector multipliers, must be of the same size.
+ * \param result Scalar (dot) products, left.size() elements.
+ */
+MATH_API void dot(Executor& executor, const Vec3SoA& left, const Vec3SoA& right, float* result);
+
+/*!
+ * \brief Parallel Vec4SoA::dot(const Vec4SoA&, float*) const.
+ * \param executor Executor running the chunks.
+ * \param left Vector multiplicands.
+ * \param right Vector multipliers, must be of the same size.
+ * \param result Scalar (dot) products, left.size() elements.
+ */
+MATH_API void dot(Executor& executor, const Vec4SoA& left, const Vec4SoA& right, float* result);
+
+/*!
+ * \brief Parallel Vec3SoA::normalize().
+ * \param executor Executor running the chunks.
+ * \param soa Normalized vectors.
+ * \note Method has a side-effect.
+ */
+MATH_API void normalize(Executor& executor, Vec3SoA& soa);
+
+/*!
+ * \brief Parallel Vec3SoA::normalizeFast().
+ * \param executor Executor running the chunks.
+ * \param soa Normalized vectors.
+ * \note Method has a side-effect.
+ */
+MATH_API void normalizeFast(Executor& executor, Vec3SoA& soa);
+
+}  // namespace Parallel
+
+}  // namespace Math
+
+#ifdef MATH_HEADER_ONLY
+#include <Parallel.inl>
+#endif
+
+#endif  // PARALLEL_H
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef PARALLEL_INL
+#define PARALLEL_INL
+
+#include <Parallel.h>
+#include <Mat4.h>
+#include <Quaternion.h>
+#include <Vec3.h>
+#include <Vec4.h>
+#include <Vec3SoA.h>
+#include <Vec4SoA.h>
+
+namespace Math {
+
+namespace Parallel {
+
+MATH_INLINE void transformPoints(Executor& executor, const Mat4& matrix,
+        const Vec3* points, Vec3* result, std::size_t count) {
+    forEach(executor, count, sizeof(Vec3), [&](std::size_t first, std::size_t chunk) {
+        matrix.transformPoints(points + first, result + first, chunk);
+    });
+}
+
+MATH_INLINE void transformDirections(Executor& executor, const Mat4& matrix,
+        const Vec3* directions, Vec3* result, std::size_t count) {
+    forEach(executor, count, sizeof(Vec3), [&](std::size_t first, std::size_t chunk) {
+        matrix.transformDirections(directions + first, result + first, chunk);
+    });
+}
+
+MATH_INLINE void transform(Executor& executor, const Mat4& matrix,
+        const Vec4* vectors, Vec4* result, std::size_t count) {
+    forEach(executor, count, sizeof(Vec4), [&](std::size_t first, std::size_t chunk) {
+        matrix.transform(vectors + first, result + first, chunk);
+    });
+}
+
+MATH_INLINE void transformPoints(Executor& executor, const Mat4& matrix,
+        const ConstVec3View& points, const Vec3View& result) {
+    std::size_t elementSize = points.getStride() * sizeof(float);
+    forEach(executor, points.size(), elementSize, [&](std::size_t first, std::size_t chunk) {
+        matrix.transformPoints(points.subview(first, chunk), result.subview(first, chunk));
+    });
+}
+
+MATH_INLINE void transformDirections(Executor& executor, const Mat4& matrix,
+        const ConstVec3View& directions, const Vec3View& result) {
+    std::size_t elementSize = directions.getStride() * sizeof(float);
+    forEach(executor, directions.size(), elementSize, [&](std::size_t first, std::size_t chunk) {
+        matrix.transformDirections(directions.subview(first, chunk), result.subview(first, chunk));
+    });
+}
+
+MATH_INLINE void transform(Executor& executor, const Mat4& matrix,
+        const ConstVec4View& vectors, const Vec4View& result) {
+    std::size_t elementSize = vectors.getStride() * sizeof(float);
+    forEach(executor, vectors.size(), elementSize, [&](std::size_t first, std::size_t chunk) {
+        matrix.transform(vectors.subview(first, chunk), result.subview(first, chunk));
+    });
+}
+
+MATH_INLINE void rotate(Executor& executor, const Quaternion& quaternion,
+        const Vec3* vectors, Vec3* result, std::size_t count) {
+    forEach(executor, count, sizeof(Vec3), [&](std::size_t first, std::size_t chunk) {
+        quaternion.rotate(vectors + first, result + first, chunk);
+    });
+}
+
+MATH_INLINE void invert(Executor& executor, const Mat4* matrices, Mat4* result, std::size_t count) {
+    forEach(executor, count, sizeof(Mat4), [&](std::size_t first, std::size_t chunk) {
+        Mat4::invert(matrices + first, result + first, chunk);
+    });
+}
+
+MATH_INLINE void dot(Executor& executor, const Vec3SoA& left, const Vec3SoA& right, float* result) {
+    forEach(executor, left.size(), sizeof(float), [&](std::size_t first, std::size_t chunk) {
+        left.dot(right, result, first, chunk);
+    });
+}
+
+MATH_INLINE void dot(Executor& executor, const Vec4SoA& left, const Vec4SoA& right, float* result) {
+    forEach(executor, left.size(), sizeof(float), [&](std::size_t first, std::size_t chunk) {
+        left.dot(right, result, first, chunk);
+    });
+}
+
+MATH_INLINE void normalize(Executor& executor, Vec3SoA& soa) {
+    forEach(executor, soa.size(), sizeof(float), [&](std::size_t first, std::size_t chunk) {
+        soa.normalize(first, chunk);
+    });
+}
+
+MATH_INLINE void normalizeFast(Executor& executor, Vec3SoA& soa) {
+    forEach(executor, soa.size(), sizeof(float), [&](std::size_t first, std::size_t chunk) {
+        soa.normalizeFast(first, chunk);
+    });
+}
+
+}  // namespace Parallel
+
+}  // namespace Math
+
+#endif  // PARALLEL_INL
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef PLANE_H
+#define PLANE_H
+
+#include <MathApi.h>
+#include <Vec3.h>
+#include <cassert>
+
+namespace Math {
+
+/*!
+ * \brief Plane representation.
+ * \details Plane is stored as A, B, C, D coefficients of the equation
+ *          A * x + B * y + C * z + D = 0, where (A, B, C) is the plane normal.
+ *          Points on the side the normal points to have positive distance.
+ */
+class Plane {
+public:
+    enum {
+        A = 0,  /*!< Normal X component index. */
+        B = 1,  /*!< Normal Y component index. */
+        C = 2,  /*!< Normal Z component index. */
+        D = 3   /*!< Distance coefficient index. */
+    };
+
+    /*!
+     * \brief Default constructor.
+     * \details Constructs XY plane passing through the origin.
+     */
+    constexpr Plane();
+
+    /*!
+     * \brief Per-coefficient constructor.
+     * \param a A coefficient.
+     * \param b B coefficient.
+     * \param c C coefficient.
+     * \param d D coefficient.
+     */
+    constexpr Plane(float a, float b, float c, float d);
+
+    /*!
+     * \brief Normal and distance constructor.
+     * \param normal Plane normal.
+     * \param distance D coefficient.
+     */
+    constexpr Plane(const Vec3& normal, float distance);
+
+    /*!
+     * \brief Normal and point constructor.
+     * \param normal Plane normal.
+     * \param point Point lying on the plane.
+     */
+    constexpr Plane(const Vec3& normal, const Vec3& point);
+
+    /*!
+     * \brief Planes equalty check.
+     * \param plane Compared plane.
+     * \return true if plane coefficients are equal, false otherwise.
+     */
+    constexpr bool operator ==(const Plane& plane) const;
+
+    /*!
+     * \brief Planes inequalty check.
+     * \param plane Compared plane.
+     * \return false if plane coefficients are equal, true otherwise.
+     */
+    constexpr bool operator !=(const Plane& plane) const;
+
+    /*!
+     * \brief Plane normalization.
+     * \details Scales all coefficients so that the normal has unit length.
+     *          Only normalized planes yield true distances.
+     * \return Normalized plane.
+     * \note Method has a side-effect.
+     */
+    MATH_API Plane& normalize();
+
+    /*!
+     * \brief Signed distance calculation.
+     * \param point Tested point.
+     * \return Signed distance from the point to the plane scaled by normal length.
+     */
+    constexpr float distanceTo(const Vec3& point) const;
+
+    /*!
+     * \brief Plane normal selector.
+     * \return Plane normal.
+     */
+    constexpr Vec3 getNormal() const;
+
+    /*!
+     * \brief Plane distance selector.
+     * \return D coefficient.
+     */
+    constexpr float getDistance() const;
+
+    /*!
+     * \brief Plane's coefficient selector.
+     * \param index Coefficient's index.
+     * \return Coefficient's value.
+     * \note You are advised to use #A, #B, #C, #D constants as indices.
+     */
+    constexpr float get(int index) const;
+
+    /*!
+     * \brief Plane's coefficient mutator.
+     * \param index Coefficient's index.
+     * \param value Coefficient's new value.
+     * \note You are advised to use #A, #B, #C, #D constants as indices.
+     */
+    constexpr void set(int index, float value);
+
+    /*!
+     * \brief Plane's data accessor.
+     * \return Plane's data pointer.
+     */
+    constexpr const float* data() const;
+
+private:
+    float plane[4];
+};
+
+constexpr Plane::Plane():
+        plane{0.0f, 0.0f, 1.0f, 0.0f} {
+}
+
+constexpr Plane::Plane(float a, float b, float c, float d):
+        plane{a, b, c, d} {
+}
+
+constexpr Plane::Plane(const Vec3& normal, float distance):
+        plane{normal.get(Vec3::X), normal.get(Vec3::Y), normal.get(Vec3::Z), distance} {
+}
+
+constexpr Plane::Plane(const Vec3& normal, const Vec3& point):
+        plane{normal.get(Vec3::X), normal.get(Vec3::Y), normal.get(Vec3::Z), -normal.dot(point)} {
+}
+
+constexpr bool Plane::operator ==(const Plane& plane) const {
+    return (this->plane[A] == plane.get(A)) &&
+           (this->plane[B] == plane.get(B)) &&
+           (this->plane[C] == plane.get(C)) &&
+           (this->plane[D] == plane.get(D));
+}
+
+constexpr bool Plane::operator !=(const Plane& plane) const {
+    return !(*this == plane);
+}
+
+constexpr float Plane::distanceTo(const Vec3& point) const {
+    return this->plane[A] * point.get(Vec3::X) +
+           this->plane[B] * point.get(Vec3::Y) +
+           this->plane[C] * point.get(Vec3::Z) +
+           this->plane[D];
+}
+
+constexpr Vec3 Plane::getNormal() const {
+    return Vec3(this->plane[A], this->plane[B], this->plane[C]);
+}
+
+constexpr float Plane::getDistance() const {
+    return this->plane[D];
+}
+
+constexpr float Plane::get(int index) const {
+    assert(index >= A && index <= D);
+    return this->plane[index];
+}
+
+constexpr void Plane::set(int index, float value) {
+    assert(index >= A && index <= D);
+    this->plane[index] = value;
+}
+
+constexpr const float* Plane::data() const {
+    return this->plane;
+}
+
+}  // namespace Math
+
+#ifdef MATH_HEADER_ONLY
+#include <Plane.inl>
+#endif
+
+#endif  // PLANE_H
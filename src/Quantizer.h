@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef QUANTIZER_H
+#define QUANTIZER_H
+
+#include <MathApi.h>
+#include <AABB.h>
+#include <Vec3.h>
+#include <Quaternion.h>
+#include <cassert>
+#include <cstddef>
+
+namespace Math {
+
+/*!
+ * \brief Smallest three quaternion encoding in 32 bits.
+ * \details Largest by magnitude component is dropped and restored from the unit
+ *          length, its index takes 2 bits. Remaining components lie within
+ *          [-1/sqrt(2), 1/sqrt(2)] and are stored in 10 bits each, the sign is
+ *          chosen to make the dropped component positive. Stored components are off
+ *          by at most 7e-4.
+ */
+class PackedQuaternion {
+public:
+    /*!
+     * \brief Default constructor.
+     * \details Constructs the encoded unit quaternion.
+     */
+    constexpr PackedQuaternion();
+
+    /*!
+     * \brief Quaternion based constructor.
+     * \param quaternion Encoded unit quaternion.
+     * \note Quaternion is assumed to be normalized, no check is performed.
+     */
+    MATH_API explicit PackedQuaternion(const Quaternion& quaternion);
+
+    /*!
+     * \brief Quaternion decoder.
+     * \return Unit quaternion.
+     */
+    MATH_API Quaternion unpack() const;
+
+    /*!
+     * \brief Binary representation selector.
+     * \return Encoded 32 bits.
+     */
+    constexpr unsigned int bits() const;
+
+    /*!
+     * \brief Binary representation based factory.
+     * \param bits Encoded 32 bits.
+     * \return Packed quaternion.
+     */
+    static constexpr PackedQuaternion fromBits(unsigned int bits);
+
+    /*!
+     * \brief Batch quaternions encoding.
+     * \param quaternions Source unit quaternions.
+     * \param result Encoded quaternions.
+     * \param count Number of quaternions.
+     * \note SSE2 or NEON kernel encodes four quaternions at once when available.
+     */
+    MATH_API static void pack(const Quaternion* quaternions, PackedQuaternion* result, std::size_t count);
+
+    /*!
+     * \brief Batch quaternions decoding.
+     * \param packed Encoded quaternions.
+     * \param result Decoded unit quaternions.
+     * \param count Number of quaternions.
+     * \note SSE2 or NEON kernel decodes four quaternions at once when available.
+     */
+    MATH_API static void unpack(const PackedQuaternion* packed, Quaternion* result, std::size_t count);
+
+private:
+    friend class PackedQuaternion48;
+
+    static void encode(const Quaternion& quaternion, float steps, unsigned int& index, unsigned int* components);
+    static Quaternion decode(unsigned int index, const unsigned int* components, float steps);
+
+    unsigned int value;
+};
+
+/*!
+ * \brief Smallest three quaternion encoding in 48 bits.
+ * \details Same scheme as PackedQuaternion with 15 bits per component, stored
+ *          components are off by at most 2.2e-5. Each of the three 16 bit words holds
+ *          one component, the dropped component index occupies the high bits of the
+ *          first two words.
+ */
+class PackedQuaternion48 {
+public:
+    /*!
+     * \brief Default constructor.
+     * \details Constructs the encoded unit quaternion.
+     */
+    constexpr PackedQuaternion48();
+
+    /*!
+     * \brief Quaternion based constructor.
+     * \param quaternion Encoded unit quaternion.
+     * \note Quaternion is assumed to be normalized, no check is performed.
+     */
+    MATH_API explicit PackedQuaternion48(const Quaternion& quaternion);
+
+    /*!
+     * \brief Quaternion decoder.
+     * \return Unit quaternion.
+     */
+    MATH_API Quaternion unpack() const;
+
+    /*!
+     * \brief Binary representation selector.
+     * \return Pointer to three encoded 16 bit words.
+     */
+    constexpr const unsigned short* data() const;
+
+    /*!
+     * \brief Batch quaternions encoding.
+     * \param quaternions Source unit quaternions.
+     * \param result Encoded quaternions.
+     * \param count Number of quaternions.
+     */
+    MATH_API static void pack(const Quaternion* quaternions, PackedQuaternion48* result, std::size_t count);
+
+    /*!
+     * \brief Batch quaternions decoding.
+     * \param packed Encoded quaternions.
+     * \param result Decoded unit quaternions.
+     * \param count Number of quaternions.
+     */
+    MATH_API static void unpack(const PackedQuaternion48* packed, Quaternion* result, std::size_t count);
+
+private:
+    unsigned short value[3];
+};
+
+/*!
+ * \brief Fixed point vector storage.
+ * \details PackedVec3 keeps three 16 bit components produced by Quantizer.
+ */
+class PackedVec3 {
+public:
+    /*!
+     * \brief Default constructor.
+     * \details Constructs the encoded minimum corner of the bounds.
+     */
+    constexpr PackedVec3();
+
+    /*!
+     * \brief Per-component constructor.
+     * \param x Encoded X component.
+     * \param y Encoded Y component.
+     * \param z Encoded Z component.
+     */
+    constexpr PackedVec3(unsigned short x, unsigned short y, unsigned short z);
+
+    /*!
+     * \brief Encoded component selector.
+     * \param index Component index, see Vec3::X, Vec3::Y, Vec3::Z.
+     * \return Encoded component.
+     * \note There is an assert for index bounds.
+     */
+    constexpr unsigned short get(int index) const;
+
+    /*!
+     * \brief Encoded data accessor.
+     * \return Pointer to three encoded components.
+     */
+    constexpr const unsigned short* data() const;
+
+private:
+    unsigned short vector[3];
+};
+
+/*!
+ * \brief Fixed point position quantizer.
+ * \details Quantizer maps positions within bounds to 16 bits per axis, the step is
+ *          (max - min) / 65535 per axis. Positions out of bounds are clamped.
+ */
+class Quantizer {
+public:
+    /*!
+     * \brief Default constructor.
+     * \details Constructs quantizer for the unit cube [0, 1]^3.
+     */
+    MATH_API Quantizer();
+
+    /*!
+     * \brief Bounds based constructor.
+     * \param bounds Quantized positions range, zero size axes encode to zero.
+     */
+    MATH_API explicit Quantizer(const AABB& bounds);
+
+    /*!
+     * \brief Position encoder.
+     * \param position Position to encode.
+     * \return Encoded position.
+     */
+    MATH_API PackedVec3 pack(const Vec3& position) const;
+
+    /*!
+     * \brief Position decoder.
+     * \param packed Encoded position.
+     * \return Decoded position.
+     */
+    MATH_API Vec3 unpack(const PackedVec3& packed) const;
+
+    /*!
+     * \brief Batch positions encoding.
+     * \param positions Source positions.
+     * \param result Encoded positions.
+     * \param count Number of positions.
+     * \note SSE2 or NEON kernel encodes four positions at once when available.
+     */
+    MATH_API void pack(const Vec3* positions, PackedVec3* result, std::size_t count) const;
+
+    /*!
+     * \brief Batch positions decoding.
+     * \param packed Encoded positions.
+     * \param result Decoded positions.
+     * \param count Number of positions.
+     * \note SSE2 or NEON kernel decodes four positions at once when available.
+     */
+    MATH_API void unpack(const PackedVec3* packed, Vec3* result, std::size_t count) const;
+
+    /*!
+     * \brief Quantized range selector.
+     * \return Bounds positions are encoded within.
+     */
+    MATH_API const AABB& getBounds() const;
+
+    /*!
+     * \brief Quantization step selector.
+     * \return Per-axis distance between adjacent encoded values.
+     */
+    MATH_API const Vec3& getStep() const;
+
+private:
+    AABB bounds;
+    Vec3 scale;
+    Vec3 step;
+};
+
+constexpr PackedQuaternion::PackedQuaternion():
+        value((3u << 30) | (511u << 20) | (511u << 10) | 511u) {
+}
+
+constexpr unsigned int PackedQuaternion::bits() const {
+    return this->value;
+}
+
+constexpr PackedQuaternion PackedQuaternion::fromBits(unsigned int bits) {
+    PackedQuaternion packed;
+    packed.value = bits;
+    return packed;
+}
+
+constexpr PackedQuaternion48::PackedQuaternion48():
+        value{0xBFFF, 0xBFFF, 0x3FFF} {
+}
+
+constexpr const unsigned short* PackedQuaternion48::data() const {
+    return this->value;
+}
+
+constexpr PackedVec3::PackedVec3():
+        vector{0, 0, 0} {
+}
+
+constexpr PackedVec3::PackedVec3(unsigned short x, unsigned short y, unsigned short z):
+        vector{x, y, z} {
+}
+
+constexpr unsigned short PackedVec3::get(int index) const {
+    assert(index >= Vec3::X && index <= Vec3::Z);
+    return this->vector[index];
+}
+
+constexpr const unsigned short* PackedVec3::data() const {
+    return this->vector;
+}
+
+}  // namespace Math
+
+#ifdef MATH_HEADER_ONLY
+#include <Quantizer.inl>
+#endif
+
+#endif  // QUANTIZER_H
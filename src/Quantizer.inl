@@ -0,0 +1,371 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef QUANTIZER_INL
+#define QUANTIZER_INL
+
+#include <Quantizer.h>
+#include <MathSimd.h>
+#include <algorithm>
+#include <cmath>
+
+namespace Math {
+
+// Encoded values range over 0...2 * steps, steps encodes zero exactly
+MATH_INLINE void PackedQuaternion::encode(const Quaternion& quaternion, float steps,
+        unsigned int& index, unsigned int* components) {
+    float x = quaternion.get(Quaternion::X);
+    float y = quaternion.get(Quaternion::Y);
+    float z = quaternion.get(Quaternion::Z);
+    float w = quaternion.get(Quaternion::W);
+
+    // Selects instead of a search loop, random inputs mispredict every branch
+    float magnitudeX = std::fabs(x);
+    float magnitudeY = std::fabs(y);
+    float magnitudeZ = std::fabs(z);
+    float magnitudeW = std::fabs(w);
+
+    bool mask01 = magnitudeX < magnitudeY;
+    bool mask23 = magnitudeZ < magnitudeW;
+    bool mask = std::max(magnitudeX, magnitudeY) < std::max(magnitudeZ, magnitudeW);
+    float largest = mask ? (mask23 ? w : z) : (mask01 ? y : x);
+    index = mask ? (mask23 ? 3u : 2u) : (mask01 ? 1u : 0u);
+
+    float first = (index == 0) ? y : x;
+    float second = (index <= 1) ? z : y;
+    float third = (index <= 2) ? w : z;
+
+    float scale = std::copysign(steps * 1.41421356f, largest);
+    float offset = steps + 0.5f;
+    float limit = 2.0f * steps;
+
+    components[0] = static_cast<unsigned int>(std::min(std::max(first * scale + offset, 0.0f), limit));
+    components[1] = static_cast<unsigned int>(std::min(std::max(second * scale + offset, 0.0f), limit));
+    components[2] = static_cast<unsigned int>(std::min(std::max(third * scale + offset, 0.0f), limit));
+}
+
+MATH_INLINE Quaternion PackedQuaternion::decode(unsigned int index, const unsigned int* components, float steps) {
+    float scale = 0.70710678f / steps;
+    float offset = -0.70710678f;
+    float vector[4];
+    float squareLength = 0.0f;
+
+    for (unsigned int i = 0, j = 0; i < 4; i++) {
+        if (i != index) {
+            vector[i] = static_cast<float>(components[j++]) * scale + offset;
+            squareLength += vector[i] * vector[i];
+        }
+    }
+
+    vector[index] = std::sqrt(std::max(1.0f - squareLength, 0.0f));
+    return Quaternion(vector[Quaternion::X], vector[Quaternion::Y], vector[Quaternion::Z], vector[Quaternion::W]);
+}
+
+MATH_INLINE PackedQuaternion::PackedQuaternion(const Quaternion& quaternion) {
+    unsigned int index;
+    unsigned int components[3];
+    PackedQuaternion::encode(quaternion, 511.0f, index, components);
+    this->value = (index << 30) | (components[0] << 20) | (components[1] << 10) | components[2];
+}
+
+MATH_INLINE Quaternion PackedQuaternion::unpack() const {
+    unsigned int components[3] = {
+        (this->value >> 20) & 0x3FFu,
+        (this->value >> 10) & 0x3FFu,
+        this->value & 0x3FFu
+    };
+
+    return PackedQuaternion::decode(this->value >> 30, components, 511.0f);
+}
+
+MATH_INLINE void PackedQuaternion::pack(const Quaternion* quaternions, PackedQuaternion* result, std::size_t count) {
+    std::size_t i = 0;
+
+#if defined(MATH_SIMD)
+    static_assert(sizeof(PackedQuaternion) == sizeof(unsigned int), "PackedQuaternion is expected to be 32 bit");
+
+    Simd::Float4 zero = Simd::splat(0.0f);
+    Simd::Float4 one = Simd::splat(1.0f);
+    Simd::Float4 two = Simd::splat(2.0f);
+    Simd::Float4 three = Simd::splat(3.0f);
+    Simd::Float4 scale = Simd::splat(511.0f * 1.41421356f);
+    Simd::Float4 offset = Simd::splat(511.5f);
+    Simd::Float4 limit = Simd::splat(1022.0f);
+
+    for (; i + 4 <= count; i += 4) {
+        Simd::Float4 x = Simd::loadu(quaternions[i].data());
+        Simd::Float4 y = Simd::loadu(quaternions[i + 1].data());
+        Simd::Float4 z = Simd::loadu(quaternions[i + 2].data());
+        Simd::Float4 w = Simd::loadu(quaternions[i + 3].data());
+        Simd::transpose(x, y, z, w);
+
+        // Same first largest component as the scalar loop, ties keep the lower index
+        Simd::Float4 magnitudeX = Simd::abs(x);
+        Simd::Float4 magnitudeY = Simd::abs(y);
+        Simd::Float4 magnitudeZ = Simd::abs(z);
+        Simd::Float4 magnitudeW = Simd::abs(w);
+
+        Simd::Float4 mask01 = Simd::compareLess(magnitudeX, magnitudeY);
+        Simd::Float4 mask23 = Simd::compareLess(magnitudeZ, magnitudeW);
+        Simd::Float4 largest01 = Simd::select(mask01, y, x);
+        Simd::Float4 largest23 = Simd::select(mask23, w, z);
+        Simd::Float4 mask = Simd::compareLess(Simd::max(magnitudeX, magnitudeY), Simd::max(magnitudeZ, magnitudeW));
+        Simd::Float4 largest = Simd::select(mask, largest23, largest01);
+        Simd::Float4 index = Simd::select(mask, Simd::select(mask23, three, two), Simd::select(mask01, one, zero));
+
+        // Components left of the dropped one keep their place, the rest shift down
+        Simd::Float4 first = Simd::select(Simd::compareLess(index, Simd::splat(0.5f)), y, x);
+        Simd::Float4 second = Simd::select(Simd::compareLess(index, Simd::splat(1.5f)), z, y);
+        Simd::Float4 third = Simd::select(Simd::compareLess(index, Simd::splat(2.5f)), w, z);
+
+        Simd::Float4 signedScale = Simd::xorSign(scale, largest);
+        first = Simd::min(Simd::max(Simd::madd(first, signedScale, offset), zero), limit);
+        second = Simd::min(Simd::max(Simd::madd(second, signedScale, offset), zero), limit);
+        third = Simd::min(Simd::max(Simd::madd(third, signedScale, offset), zero), limit);
+
+        Simd::Int4 bits = Simd::shiftLeft<30>(Simd::truncate(index));
+        bits = Simd::bitOr(bits, Simd::shiftLeft<20>(Simd::truncate(first)));
+        bits = Simd::bitOr(bits, Simd::shiftLeft<10>(Simd::truncate(second)));
+        bits = Simd::bitOr(bits, Simd::truncate(third));
+        Simd::storeu(reinterpret_cast<unsigned int*>(result + i), bits);
+    }
+#endif
+
+    for (; i < count; i++) {
+        result[i] = PackedQuaternion(quaternions[i]);
+    }
+}
+
+MATH_INLINE void PackedQuaternion::unpack(const PackedQuaternion* packed, Quaternion* result, std::size_t count) {
+    std::size_t i = 0;
+
+#if defined(MATH_SIMD)
+    static_assert(sizeof(Quaternion) == sizeof(float) * 4, "Quaternion is expected to be tightly packed");
+
+    Simd::Int4 componentMask = Simd::splatBits(0x3FFu);
+    Simd::Float4 zero = Simd::splat(0.0f);
+    Simd::Float4 one = Simd::splat(1.0f);
+    Simd::Float4 scale = Simd::splat(0.70710678f / 511.0f);
+    Simd::Float4 offset = Simd::splat(-0.70710678f);
+
+    for (; i + 4 <= count; i += 4) {
+        Simd::Int4 bits = Simd::loadu(reinterpret_cast<const unsigned int*>(packed + i));
+        Simd::Float4 index = Simd::toFloat(Simd::shiftRight<30>(bits));
+        Simd::Float4 first = Simd::toFloat(Simd::bitAnd(Simd::shiftRight<20>(bits), componentMask));
+        Simd::Float4 second = Simd::toFloat(Simd::bitAnd(Simd::shiftRight<10>(bits), componentMask));
+        Simd::Float4 third = Simd::toFloat(Simd::bitAnd(bits, componentMask));
+
+        first = Simd::madd(first, scale, offset);
+        second = Simd::madd(second, scale, offset);
+        third = Simd::madd(third, scale, offset);
+
+        Simd::Float4 squareLength = Simd::mul(first, first);
+        squareLength = Simd::madd(second, second, squareLength);
+        squareLength = Simd::madd(third, third, squareLength);
+        Simd::Float4 largest = Simd::sqrt(Simd::max(Simd::sub(one, squareLength), zero));
+
+        Simd::Float4 mask0 = Simd::compareLess(index, Simd::splat(0.5f));
+        Simd::Float4 mask1 = Simd::compareLess(index, Simd::splat(1.5f));
+        Simd::Float4 mask2 = Simd::compareLess(index, Simd::splat(2.5f));
+
+        Simd::Float4 x = Simd::select(mask0, largest, first);
+        Simd::Float4 y = Simd::select(mask0, first, Simd::select(mask1, largest, second));
+        Simd::Float4 z = Simd::select(mask1, second, Simd::select(mask2, largest, third));
+        Simd::Float4 w = Simd::select(mask2, third, largest);
+        Simd::transpose(x, y, z, w);
+
+        float* destination = reinterpret_cast<float*>(result + i);
+        Simd::storeu(destination, x);
+        Simd::storeu(destination + 4, y);
+        Simd::storeu(destination + 8, z);
+        Simd::storeu(destination + 12, w);
+    }
+#endif
+
+    for (; i < count; i++) {
+        result[i] = packed[i].unpack();
+    }
+}
+
+MATH_INLINE PackedQuaternion48::PackedQuaternion48(const Quaternion& quaternion) {
+    unsigned int index;
+    unsigned int components[3];
+    PackedQuaternion::encode(quaternion, 16383.0f, index, components);
+
+    this->value[0] = static_cast<unsigned short>(((index & 2u) << 14) | components[0]);
+    this->value[1] = static_cast<unsigned short>(((index & 1u) << 15) | components[1]);
+    this->value[2] = static_cast<unsigned short>(components[2]);
+}
+
+MATH_INLINE Quaternion PackedQuaternion48::unpack() const {
+    unsigned int index = ((this->value[0] >> 14) & 2u) | (this->value[1] >> 15);
+    unsigned int components[3] = {
+        this->value[0] & 0x7FFFu,
+        this->value[1] & 0x7FFFu,
+        this->value[2] & 0x7FFFu
+    };
+
+    return PackedQuaternion::decode(index, components, 16383.0f);
+}
+
+MATH_INLINE void PackedQuaternion48::pack(const Quaternion* quaternions, PackedQuaternion48* result,
+        std::size_t count) {
+    for (std::size_t i = 0; i < count; i++) {
+        result[i] = PackedQuaternion48(quaternions[i]);
+    }
+}
+
+MATH_INLINE void PackedQuaternion48::unpack(const PackedQuaternion48* packed, Quaternion* result,
+        std::size_t count) {
+    for (std::size_t i = 0; i < count; i++) {
+        result[i] = packed[i].unpack();
+    }
+}
+
+MATH_INLINE Quantizer::Quantizer():
+        Quantizer(AABB(Vec3::ZERO, Vec3(1.0f, 1.0f, 1.0f))) {
+}
+
+MATH_INLINE Quantizer::Quantizer(const AABB& bounds):
+        bounds(bounds) {
+    Vec3 extent(bounds.getMax() - bounds.getMin());
+
+    for (int i = Vec3::X; i <= Vec3::Z; i++) {
+        float size = extent.get(i);
+        this->scale.set(i, (size > 0.0f) ? 65535.0f / size : 0.0f);
+        this->step.set(i, size / 65535.0f);
+    }
+}
+
+MATH_INLINE PackedVec3 Quantizer::pack(const Vec3& position) const {
+    unsigned short encoded[3];
+
+    // Same rounding as the batch kernel, bias folds the minimum corner in
+    for (int i = Vec3::X; i <= Vec3::Z; i++) {
+        float bias = 0.5f - this->bounds.getMin().get(i) * this->scale.get(i);
+        float value = position.get(i) * this->scale.get(i) + bias;
+        encoded[i] = static_cast<unsigned short>(std::min(std::max(value, 0.0f), 65535.0f));
+    }
+
+    return PackedVec3(encoded[Vec3::X], encoded[Vec3::Y], encoded[Vec3::Z]);
+}
+
+MATH_INLINE Vec3 Quantizer::unpack(const PackedVec3& packed) const {
+    const Vec3& minimum = this->bounds.getMin();
+
+    return Vec3(
+            static_cast<float>(packed.get(Vec3::X)) * this->step.get(Vec3::X) + minimum.get(Vec3::X),
+            static_cast<float>(packed.get(Vec3::Y)) * this->step.get(Vec3::Y) + minimum.get(Vec3::Y),
+            static_cast<float>(packed.get(Vec3::Z)) * this->step.get(Vec3::Z) + minimum.get(Vec3::Z));
+}
+
+MATH_INLINE void Quantizer::pack(const Vec3* positions, PackedVec3* result, std::size_t count) const {
+    std::size_t i = 0;
+
+#if defined(MATH_SIMD)
+    static_assert(sizeof(Vec3) == sizeof(float) * 3, "Vec3 is expected to be tightly packed");
+    static_assert(sizeof(PackedVec3) == sizeof(unsigned short) * 3, "PackedVec3 is expected to be tightly packed");
+
+    // Four positions fill three registers, per-axis constants rotate accordingly
+    const Vec3& minimum = this->bounds.getMin();
+    float bias[3] = {
+        0.5f - minimum.get(Vec3::X) * this->scale.get(Vec3::X),
+        0.5f - minimum.get(Vec3::Y) * this->scale.get(Vec3::Y),
+        0.5f - minimum.get(Vec3::Z) * this->scale.get(Vec3::Z)
+    };
+
+    Simd::Float4 scale0 = Simd::set(this->scale.get(Vec3::X), this->scale.get(Vec3::Y),
+            this->scale.get(Vec3::Z), this->scale.get(Vec3::X));
+    Simd::Float4 scale1 = Simd::set(this->scale.get(Vec3::Y), this->scale.get(Vec3::Z),
+            this->scale.get(Vec3::X), this->scale.get(Vec3::Y));
+    Simd::Float4 scale2 = Simd::set(this->scale.get(Vec3::Z), this->scale.get(Vec3::X),
+            this->scale.get(Vec3::Y), this->scale.get(Vec3::Z));
+    Simd::Float4 bias0 = Simd::set(bias[0], bias[1], bias[2], bias[0]);
+    Simd::Float4 bias1 = Simd::set(bias[1], bias[2], bias[0], bias[1]);
+    Simd::Float4 bias2 = Simd::set(bias[2], bias[0], bias[1], bias[2]);
+    Simd::Float4 zero = Simd::splat(0.0f);
+    Simd::Float4 limit = Simd::splat(65535.0f);
+
+    for (; i + 4 <= count; i += 4) {
+        const float* source = positions[i].data();
+        unsigned short* destination = reinterpret_cast<unsigned short*>(result + i);
+
+        Simd::Float4 value0 = Simd::madd(Simd::loadu(source), scale0, bias0);
+        Simd::Float4 value1 = Simd::madd(Simd::loadu(source + 4), scale1, bias1);
+        Simd::Float4 value2 = Simd::madd(Simd::loadu(source + 8), scale2, bias2);
+
+        Simd::storeShorts(destination, Simd::truncate(Simd::min(Simd::max(value0, zero), limit)));
+        Simd::storeShorts(destination + 4, Simd::truncate(Simd::min(Simd::max(value1, zero), limit)));
+        Simd::storeShorts(destination + 8, Simd::truncate(Simd::min(Simd::max(value2, zero), limit)));
+    }
+#endif
+
+    for (; i < count; i++) {
+        result[i] = this->pack(positions[i]);
+    }
+}
+
+MATH_INLINE void Quantizer::unpack(const PackedVec3* packed, Vec3* result, std::size_t count) const {
+    std::size_t i = 0;
+
+#if defined(MATH_SIMD)
+    const Vec3& minimum = this->bounds.getMin();
+
+    Simd::Float4 step0 = Simd::set(this->step.get(Vec3::X), this->step.get(Vec3::Y),
+            this->step.get(Vec3::Z), this->step.get(Vec3::X));
+    Simd::Float4 step1 = Simd::set(this->step.get(Vec3::Y), this->step.get(Vec3::Z),
+            this->step.get(Vec3::X), this->step.get(Vec3::Y));
+    Simd::Float4 step2 = Simd::set(this->step.get(Vec3::Z), this->step.get(Vec3::X),
+            this->step.get(Vec3::Y), this->step.get(Vec3::Z));
+    Simd::Float4 minimum0 = Simd::set(minimum.get(Vec3::X), minimum.get(Vec3::Y),
+            minimum.get(Vec3::Z), minimum.get(Vec3::X));
+    Simd::Float4 minimum1 = Simd::set(minimum.get(Vec3::Y), minimum.get(Vec3::Z),
+            minimum.get(Vec3::X), minimum.get(Vec3::Y));
+    Simd::Float4 minimum2 = Simd::set(minimum.get(Vec3::Z), minimum.get(Vec3::X),
+            minimum.get(Vec3::Y), minimum.get(Vec3::Z));
+
+    for (; i + 4 <= count; i += 4) {
+        const unsigned short* source = packed[i].data();
+        float* destination = reinterpret_cast<float*>(result + i);
+
+        Simd::storeu(destination, Simd::madd(Simd::toFloat(Simd::loadShorts(source)), step0, minimum0));
+        Simd::storeu(destination + 4, Simd::madd(Simd::toFloat(Simd::loadShorts(source + 4)), step1, minimum1));
+        Simd::storeu(destination + 8, Simd::madd(Simd::toFloat(Simd::loadShorts(source + 8)), step2, minimum2));
+    }
+#endif
+
+    for (; i < count; i++) {
+        result[i] = this->unpack(packed[i]);
+    }
+}
+
+MATH_INLINE const AABB& Quantizer::getBounds() const {
+    return this->bounds;
+}
+
+MATH_INLINE const Vec3& Quantizer::getStep() const {
+    return this->step;
+}
+
+}  // namespace Math
+
+#endif  // QUANTIZER_INL
@@ -20,122 +20,4 @@
  * SOFTWARE.
  */
 
-#include <Quaternion.h>
-#include <Vec3.h>
-#include <Mat4.h>
-#include <cmath>
-#include <cassert>
-
-namespace Math {
-
-Quaternion::Quaternion() {
-    this->vector[X] = 0.0f;
-    this->vector[Y] = 0.0f;
-    this->vector[Z] = 0.0f;
-    this->vector[W] = 1.0f;
-}
-
-Quaternion::Quaternion(float x, float y, float z, float w) {
-    this->vector[X] = x;
-    this->vector[Y] = y;
-    this->vector[Z] = z;
-    this->vector[W] = w;
-}
-
-Quaternion::Quaternion(const Vec3& axis, float angle) {
-    float sinAngle = sinf(angle / 2);
-
-    this->vector[X] = axis.get(Vec3::X) * sinAngle;
-    this->vector[Y] = axis.get(Vec3::Y) * sinAngle;
-    this->vector[Z] = axis.get(Vec3::Z) * sinAngle;
-    this->vector[W] = cosf(angle / 2);
-}
-
-Quaternion Quaternion::operator *(const Quaternion& quaternion) const {
-    Quaternion result;
-
-    result.set(W, this->vector[W] * quaternion.get(W) -
-                  this->vector[X] * quaternion.get(X) -
-                  this->vector[Y] * quaternion.get(Y) -
-                  this->vector[Z] * quaternion.get(Z));
-
-    result.set(X, this->vector[W] * quaternion.get(X) +
-                  this->vector[X] * quaternion.get(W) +
-                  this->vector[Y] * quaternion.get(Z) -
-                  this->vector[Z] * quaternion.get(Y));
-
-    result.set(Y, this->vector[W] * quaternion.get(Y) -
-                  this->vector[X] * quaternion.get(Z) +
-                  this->vector[Y] * quaternion.get(W) +
-                  this->vector[Z] * quaternion.get(X));
-
-    result.set(Z, this->vector[W] * quaternion.get(Z) +
-                  this->vector[X] * quaternion.get(Y) -
-                  this->vector[Y] * quaternion.get(X) +
-                  this->vector[Z] * quaternion.get(W));
-
-    return result;
-}
-
-Quaternion& Quaternion::normalize() {
-    float length = this->length();
-    this->vector[X] /= length;
-    this->vector[Y] /= length;
-    this->vector[Z] /= length;
-    this->vector[W] /= length;
-    return *this;
-}
-
-float Quaternion::length() const {
-    return sqrtf(this->vector[X] * this->vector[X] +
-                 this->vector[Y] * this->vector[Y] +
-                 this->vector[Z] * this->vector[Z] +
-                 this->vector[W] * this->vector[W]);
-}
-
-float Quaternion::get(int index) const {
-    assert(index >= X && index <= W);
-    return this->vector[index];
-}
-
-void Quaternion::set(int index, float value) {
-    assert(index >= X && index <= W);
-    this->vector[index] = value;
-}
-
-Mat4 Quaternion::extractMat4() const {
-    Mat4 result;
-
-    result.set(0, 0, 1 - 2 * this->vector[Y] * this->vector[Y] -
-                         2 * this->vector[Z] * this->vector[Z]);
-    result.set(0, 1, 2 * this->vector[X] * this->vector[Y] -
-                     2 * this->vector[Z] * this->vector[W]);
-    result.set(0, 2, 2 * this->vector[X] * this->vector[Y] +
-                     2 * this->vector[Y] * this->vector[W]);
-
-    result.set(1, 0, 2 * this->vector[X] * this->vector[Y] +
-                     2 * this->vector[Z] * this->vector[W]);
-    result.set(1, 1, 1 - 2 * this->vector[X] * this->vector[X] -
-                         2 * this->vector[Z] * this->vector[Z]);
-    result.set(1, 2, 2 * this->vector[Y] * this->vector[Z] -
-                     2 * this->vector[X] * this->vector[W]);
-
-    result.set(2, 0, 2 * this->vector[X] * this->vector[Z] -
-                     2 * this->vector[Y] * this->vector[W]);
-    result.set(2, 1, 2 * this->vector[Y] * this->vector[Z] +
-                     2 * this->vector[X] * this->vector[W]);
-    result.set(2, 2, 1 - 2 * this->vector[X] * this->vector[X] -
-                         2 * this->vector[Y] * this->vector[Y]);
-
-    return result;
-}
-
-void Quaternion::extractEulerAngles(float& xAngle, float& yAngle, float& zAngle) const {
-    xAngle = atan2f(2 * (this->vector[X] * this->vector[W] - this->vector[Y] * this->vector[Z]),
-                    1 - 2 * (this->vector[X] * this->vector[X] - this->vector[Z] * this->vector[Z]));
-    yAngle = atan2f(2 * (this->vector[Y] * this->vector[W] - this->vector[X] * this->vector[Z]),
-                    1 - 2 * (this->vector[Y] * this->vector[Y] - this->vector[Z] * this->vector[Z]));
-    zAngle = asinf(2 * (this->vector[X] * this->vector[Y] + this->vector[Z] * this->vector[W]));
-}
-
-}  // namespace Math
+#include <Quaternion.inl>
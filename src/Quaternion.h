@@ -24,18 +24,26 @@
 #define QUATERNION_H
 
 #include <MathApi.h>
+#include <Uninitialized.h>
+#include <cassert>
+#include <type_traits>
+#include <cstddef>
 
 namespace Math {
 
 class Vec3;
+class Mat3;
 class Mat4;
 
 /*!
  * \brief %Quaternion representation.
  * \details Quaternion implements basic operations that are:
- *          * multiplication;
+ *          * multiplication, addition, dot product;
+ *          * conjugation;
  *          * normalization;
- *          * euler angles and Mat4 rotation matrix extraction.
+ *          * vector rotation;
+ *          * spherical and normalized linear interpolation;
+ *          * euler angles, Mat3 and Mat4 rotation matrix extraction and conversion back.
  */
 class Quaternion {
 public:
@@ -46,11 +54,23 @@ public:
         W = 3   /*!< W component index. */
     };
 
+    enum Precision {
+        EXACT = 0,       /*!< Exact trigonometric evaluation. */
+        APPROXIMATE = 1  /*!< Polynomial approximation. */
+    };
+
     /*!
      * \brief Default constructor.
      * \details Constructs a unit quaternion initializing every but W component with zero.
      */
-    MATH_API Quaternion();
+    constexpr Quaternion() noexcept;
+
+    /*!
+     * \brief Uninitialized constructor.
+     * \details Leaves components indeterminate, for results written completely right after.
+     * \note Reading components before writing them is undefined behaviour.
+     */
+    explicit Quaternion(Uninitialized) noexcept;
 
     /*!
      * \brief Per-component constructor.
@@ -60,7 +80,7 @@ public:
      * \param z Z component.
      * \param w W component.
      */
-    MATH_API Quaternion(float x, float y, float z, float w);
+    constexpr Quaternion(float x, float y, float z, float w) noexcept;
 
     /*!
      * \brief Axis-angle based constructor.
@@ -68,27 +88,152 @@ public:
      * \param axis Rotation axis vector.
      * \param angle Rotation angle in radians.
      */
-    MATH_API Quaternion(const Vec3& axis, float angle);
+    MATH_API Quaternion(const Vec3& axis, float angle) noexcept;
 
     /*!
      * \brief Quaternions multiplication.
      * \param quaternion %Quaternion multiplier.
      * \return Product quaternion.
      */
-    MATH_API Quaternion operator *(const Quaternion& quaternion) const;
+    constexpr Quaternion operator *(const Quaternion& quaternion) const noexcept;
+
+    /*!
+     * \brief Quaternions addition.
+     * \param quaternion Summand quaternion.
+     * \return Sum quaternion.
+     */
+    constexpr Quaternion operator +(const Quaternion& quaternion) const noexcept;
+
+    /*!
+     * \brief %Quaternion by scalar multiplication.
+     * \param scalar Scalar multiplier.
+     * \return Product quaternion.
+     */
+    constexpr Quaternion operator *(float scalar) const noexcept;
+
+    /*!
+     * \brief Dot product calculation.
+     * \param quaternion %Quaternion multiplier.
+     * \return Scalar (dot) product.
+     */
+    constexpr float dot(const Quaternion& quaternion) const noexcept;
 
     /*!
      * \brief %Quaternion normalization.
      * \return Normalized quaternion.
      * \note Method has a side-effect.
      */
-    MATH_API Quaternion& normalize();
+    MATH_API Quaternion& normalize() noexcept;
+
+    /*!
+     * \brief Approximate quaternion normalization.
+     * \details Scales quaternion by a reciprocal square root estimate refined with one
+     *          Newton-Raphson step instead of dividing by length(). Relative error
+     *          stays within 1e-4 (2.5e-7 on SSE), normalize() remains the exact version.
+     * \return Normalized quaternion.
+     * \note %Quaternion of zero length produces NaN components, no check is performed.
+     * \note Method has a side-effect.
+     */
+    MATH_API Quaternion& normalizeFast() noexcept;
+
+    /*!
+     * \brief %Quaternion conjugation.
+     * \details Negates X, Y, Z components. Conjugate of a unit quaternion is its inverse.
+     * \return Conjugated quaternion.
+     * \note Method has a side-effect.
+     */
+    constexpr Quaternion& conjugate() noexcept;
 
     /*!
      * \brief %Quaternion's length calculation.
      * \return %Quaternion length.
      */
-    MATH_API float length() const;
+    MATH_API float length() const noexcept;
+
+    /*!
+     * \brief Vector rotation.
+     * \details Rotates vector as q * v * q^-1 without building a rotation matrix:
+     *           -# t = 2 * cross(q.xyz, v)
+     *           -# v' = v + q.w * t + cross(q.xyz, t)
+     *
+     * \param vector Rotated vector.
+     * \return Rotated vector.
+     * \note %Quaternion is assumed to be normalized, no check is performed.
+     */
+    MATH_API Vec3 rotate(const Vec3& vector) const noexcept;
+
+    /*!
+     * \brief Batch vectors rotation.
+     * \details Batch equivalent of rotate(const Vec3&) const.
+     * \param vectors Rotated vectors.
+     * \param result Rotated vectors, may be the same array as vectors.
+     * \param count Number of vectors.
+     * \note %Quaternion is assumed to be normalized, no check is performed.
+     */
+    MATH_API void rotate(const Vec3* vectors, Vec3* result, std::size_t count) const noexcept;
+
+    /*!
+     * \brief Spherical linear interpolation.
+     * \details Interpolates along the shortest arc between this and quaternion.
+     *          #APPROXIMATE precision evaluates sin(t * angle) / sin(angle) ratios with
+     *          a polynomial in dot product and factor instead of acos and sin calls.
+     *          Absolute error of the result stays within 3e-5. References:
+     *           * https://www.geometrictools.com/Documentation/FastAndAccurateSlerp.pdf
+     *
+     * \param quaternion Target quaternion.
+     * \param factor Interpolation factor in [0, 1] range.
+     * \param precision Evaluation precision.
+     * \return Interpolated quaternion.
+     * \note Both quaternions are assumed to be normalized, no check is performed.
+     */
+    MATH_API Quaternion slerp(const Quaternion& quaternion, float factor, Precision precision = EXACT) const noexcept;
+
+    /*!
+     * \brief Normalized linear interpolation.
+     * \details Interpolates along the shortest arc between this and quaternion
+     *          linearly and normalizes the result. Angular velocity is not constant.
+     * \param quaternion Target quaternion.
+     * \param factor Interpolation factor in [0, 1] range.
+     * \return Interpolated quaternion.
+     */
+    MATH_API Quaternion nlerp(const Quaternion& quaternion, float factor) const noexcept;
+
+    /*!
+     * \brief Batch spherical linear interpolation.
+     * \details Batch equivalent of slerp(const Quaternion&, float, Precision) const.
+     *          #APPROXIMATE precision blends four quaternions per SIMD pass.
+     * \param from Source quaternions.
+     * \param to Target quaternions.
+     * \param factors Interpolation factors.
+     * \param result Interpolated quaternions, may be the same array as from or to.
+     * \param count Number of quaternions.
+     * \param precision Evaluation precision.
+     */
+    MATH_API static void slerp(const Quaternion* from, const Quaternion* to, const float* factors,
+            Quaternion* result, std::size_t count, Precision precision = EXACT) noexcept;
+
+    /*!
+     * \brief Batch normalized linear interpolation.
+     * \details Batch equivalent of nlerp(const Quaternion&, float) const, blends four
+     *          quaternions per SIMD pass.
+     * \param from Source quaternions.
+     * \param to Target quaternions.
+     * \param factors Interpolation factors.
+     * \param result Interpolated quaternions, may be the same array as from or to.
+     * \param count Number of quaternions.
+     */
+    MATH_API static void nlerp(const Quaternion* from, const Quaternion* to, const float* factors,
+            Quaternion* result, std::size_t count) noexcept;
+
+    /*!
+     * \brief Batch approximate normalization.
+     * \details Batch equivalent of normalizeFast(), normalizes four quaternions per
+     *          SIMD pass.
+     * \param quaternions Source quaternions.
+     * \param result Normalized quaternions, may be the same array as quaternions.
+     * \param count Number of quaternions.
+     */
+    MATH_API static void normalizeFast(const Quaternion* quaternions, Quaternion* result, std::size_t count) noexcept;
 
     /*!
      * \brief %Quaternion's component selector.
@@ -96,7 +241,7 @@ public:
      * \return Component's value.
      * \note You are advised to use #X, #Y, #Z, #W constants as indices.
      */
-    MATH_API float get(int index) const;
+    constexpr float get(int index) const noexcept;
 
     /*!
      * \brief %Quaternion's component mutator.
@@ -104,28 +249,189 @@ public:
      * \param value Component's new value.
      * \note You are advised to use #X, #Y, #Z, #W constants as indices.
      */
-    MATH_API void set(int index, float value);
+    constexpr void set(int index, float value) noexcept;
+
+    /*!
+     * \brief %Quaternion's data accessor.
+     * \return %Quaternion's data pointer.
+     */
+    constexpr const float* data() const noexcept;
+
+    /*!
+     * \brief Mat3 matrix extraction.
+     * \details Composes Mat3 rotation matrix, every component product is computed once.
+     * \return 3x3 two dimetional matrix.
+     */
+    MATH_API Mat3 extractMat3() const noexcept;
 
     /*!
      * \brief Mat4 matrix extraction.
-     * \details Composes Mat4 rotation matrix.
+     * \details Composes Mat4 rotation matrix, every component product is computed once.
      * \return 4x4 two dimetional matrix.
      */
-    MATH_API Mat4 extractMat4() const;
+    MATH_API Mat4 extractMat4() const noexcept;
+
+    /*!
+     * \brief Batch Mat4 matrices extraction.
+     * \details Batch equivalent of extractMat4() const, SIMD composes four matrices
+     *          per pass.
+     * \param quaternions Source unit quaternions.
+     * \param result Rotation matrices.
+     * \param count Number of quaternions.
+     */
+    MATH_API static void extractMat4(const Quaternion* quaternions, Mat4* result, std::size_t count) noexcept;
 
     /*!
      * \brief Euler angles extraction.
-     * \details Derives roll, yaw, pitch angle values in radians.
+     * \details Derives roll, yaw, pitch angle values in radians. #APPROXIMATE precision
+     *          replaces atan2f() and asinf() with polynomials, the error is below 2e-5
+     *          radians.
      * \param xAngle Rotation angle around X axis.
      * \param yAngle Rotation angle around Y axis.
      * \param zAngle Rotation angle around Z axis.
+     * \param precision Trigonometric evaluation precision.
      */
-    MATH_API void extractEulerAngles(float& xAngle, float& yAngle, float& zAngle) const;
+    MATH_API void extractEulerAngles(float& xAngle, float& yAngle, float& zAngle,
+            Precision precision = EXACT) const noexcept;
+
+    /*!
+     * \brief Batch Euler angles extraction.
+     * \details Batch equivalent of extractEulerAngles(float&, float&, float&, Precision) const.
+     *          #APPROXIMATE precision evaluates four quaternions per SIMD pass.
+     * \param quaternions Source unit quaternions.
+     * \param angles Rotation angles around X, Y and Z axes.
+     * \param count Number of quaternions.
+     * \param precision Trigonometric evaluation precision.
+     */
+    MATH_API static void extractEulerAngles(const Quaternion* quaternions, Vec3* angles, std::size_t count,
+            Precision precision = EXACT) noexcept;
+
+    /*!
+     * \brief Rotation matrix conversion.
+     * \details Uses Shepperd's method, the largest of four squared components is
+     *          computed first and divides the others to stay numerically stable.
+     * \param matrix Rotation matrix.
+     * \return Unit quaternion.
+     * \note Matrix is assumed to be a pure rotation, no check is performed.
+     */
+    MATH_API static Quaternion fromMat3(const Mat3& matrix) noexcept;
+
+    /*!
+     * \brief Transformation matrix rotation conversion.
+     * \details Same as fromMat3() for the upper 3x3 block, translation is ignored.
+     * \param matrix Rigid transformation matrix without scale.
+     * \return Unit quaternion.
+     * \note Matrix block is assumed to be a pure rotation, no check is performed.
+     */
+    MATH_API static Quaternion fromMat4(const Mat4& matrix) noexcept;
+
+    /*!
+     * \brief Batch transformation matrices rotation conversion.
+     * \details Batch equivalent of fromMat4(), SIMD converts four matrices per pass
+     *          picking Shepperd's case per lane.
+     * \param matrices Rigid transformation matrices without scale.
+     * \param result Unit quaternions.
+     * \param count Number of matrices.
+     */
+    MATH_API static void fromMat4(const Mat4* matrices, Quaternion* result, std::size_t count) noexcept;
 
 private:
+    friend class DualQuaternion;
+
+    static float approximateAtan2(float y, float x) noexcept;
+    static Quaternion fromRotation(float m00, float m01, float m02, float m10, float m11, float m12,
+            float m20, float m21, float m22) noexcept;
+
     float vector[4];
 };
 
+static_assert(std::is_trivially_copyable<Quaternion>::value, "Quaternion should be copied with memcpy");
+static_assert(std::is_nothrow_move_constructible<Quaternion>::value && std::is_nothrow_move_assignable<Quaternion>::value,
+        "Quaternion should be moved without exceptions");
+
+constexpr Quaternion::Quaternion() noexcept:
+        vector{0.0f, 0.0f, 0.0f, 1.0f} {
+}
+
+inline Quaternion::Quaternion(Uninitialized) noexcept {
+}
+
+constexpr Quaternion::Quaternion(float x, float y, float z, float w) noexcept:
+        vector{x, y, z, w} {
+}
+
+constexpr Quaternion Quaternion::operator *(const Quaternion& quaternion) const noexcept {
+    Quaternion result;
+
+    result.set(W, this->vector[W] * quaternion.get(W) -
+                  this->vector[X] * quaternion.get(X) -
+                  this->vector[Y] * quaternion.get(Y) -
+                  this->vector[Z] * quaternion.get(Z));
+
+    result.set(X, this->vector[W] * quaternion.get(X) +
+                  this->vector[X] * quaternion.get(W) +
+                  this->vector[Y] * quaternion.get(Z) -
+                  this->vector[Z] * quaternion.get(Y));
+
+    result.set(Y, this->vector[W] * quaternion.get(Y) -
+                  this->vector[X] * quaternion.get(Z) +
+                  this->vector[Y] * quaternion.get(W) +
+                  this->vector[Z] * quaternion.get(X));
+
+    result.set(Z, this->vector[W] * quaternion.get(Z) +
+                  this->vector[X] * quaternion.get(Y) -
+                  this->vector[Y] * quaternion.get(X) +
+                  this->vector[Z] * quaternion.get(W));
+
+    return result;
+}
+
+constexpr Quaternion Quaternion::operator +(const Quaternion& quaternion) const noexcept {
+    return Quaternion(this->vector[X] + quaternion.get(X),
+                      this->vector[Y] + quaternion.get(Y),
+                      this->vector[Z] + quaternion.get(Z),
+                      this->vector[W] + quaternion.get(W));
+}
+
+constexpr Quaternion Quaternion::operator *(float scalar) const noexcept {
+    return Quaternion(this->vector[X] * scalar,
+                      this->vector[Y] * scalar,
+                      this->vector[Z] * scalar,
+                      this->vector[W] * scalar);
+}
+
+constexpr float Quaternion::dot(const Quaternion& quaternion) const noexcept {
+    return this->vector[X] * quaternion.get(X) +
+           this->vector[Y] * quaternion.get(Y) +
+           this->vector[Z] * quaternion.get(Z) +
+           this->vector[W] * quaternion.get(W);
+}
+
+constexpr Quaternion& Quaternion::conjugate() noexcept {
+    this->vector[X] = -this->vector[X];
+    this->vector[Y] = -this->vector[Y];
+    this->vector[Z] = -this->vector[Z];
+    return *this;
+}
+
+constexpr float Quaternion::get(int index) const noexcept {
+    assert(index >= X && index <= W);
+    return this->vector[index];
+}
+
+constexpr void Quaternion::set(int index, float value) noexcept {
+    assert(index >= X && index <= W);
+    this->vector[index] = value;
+}
+
+constexpr const float* Quaternion::data() const noexcept {
+    return this->vector;
+}
+
 }  // namespace Math
 
+#ifdef MATH_HEADER_ONLY
+#include <Quaternion.inl>
+#endif
+
 #endif  // QUATERNION_H
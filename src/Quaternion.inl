@@ -0,0 +1,708 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef QUATERNION_INL
+#define QUATERNION_INL
+
+#include <Quaternion.h>
+#include <Vec3.h>
+#include <Mat3.h>
+#include <Mat4.h>
+#include <MathSimd.h>
+#include <Instrumentation.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace Math {
+
+MATH_INLINE Quaternion::Quaternion(const Vec3& axis, float angle) noexcept {
+    float sinAngle = sinf(angle / 2);
+
+    this->vector[X] = axis.get(Vec3::X) * sinAngle;
+    this->vector[Y] = axis.get(Vec3::Y) * sinAngle;
+    this->vector[Z] = axis.get(Vec3::Z) * sinAngle;
+    this->vector[W] = cosf(angle / 2);
+}
+
+MATH_INLINE Quaternion& Quaternion::normalize() noexcept {
+    MATH_COUNT(QUATERNION_NORMALIZE);
+
+    float length = this->length();
+    this->vector[X] /= length;
+    this->vector[Y] /= length;
+    this->vector[Z] /= length;
+    this->vector[W] /= length;
+    return *this;
+}
+
+MATH_INLINE Quaternion& Quaternion::normalizeFast() noexcept {
+#if defined(MATH_SIMD)
+    float scale = Simd::rsqrt(this->dot(*this));
+#else
+    float scale = 1.0f / this->length();
+#endif
+    this->vector[X] *= scale;
+    this->vector[Y] *= scale;
+    this->vector[Z] *= scale;
+    this->vector[W] *= scale;
+    return *this;
+}
+
+MATH_INLINE float Quaternion::length() const noexcept {
+    return sqrtf(this->vector[X] * this->vector[X] +
+                 this->vector[Y] * this->vector[Y] +
+                 this->vector[Z] * this->vector[Z] +
+                 this->vector[W] * this->vector[W]);
+}
+
+MATH_INLINE Vec3 Quaternion::rotate(const Vec3& vector) const noexcept {
+    Vec3 result(UNINITIALIZED);
+    this->rotate(&vector, &result, 1);
+    return result;
+}
+
+MATH_INLINE void Quaternion::rotate(const Vec3* vectors, Vec3* result, std::size_t count) const noexcept {
+    MATH_PROBE(QUATERNION_ROTATE_BATCH, count);
+
+    float x = this->vector[X];
+    float y = this->vector[Y];
+    float z = this->vector[Z];
+    float w = this->vector[W];
+
+    for (std::size_t i = 0; i < count; i++) {
+        const float* source = vectors[i].data();
+        float vectorX = source[Vec3::X];
+        float vectorY = source[Vec3::Y];
+        float vectorZ = source[Vec3::Z];
+
+        float tX = 2.0f * (y * vectorZ - z * vectorY);
+        float tY = 2.0f * (z * vectorX - x * vectorZ);
+        float tZ = 2.0f * (x * vectorY - y * vectorX);
+
+        result[i] = Vec3(vectorX + w * tX + (y * tZ - z * tY),
+                         vectorY + w * tY + (z * tX - x * tZ),
+                         vectorZ + w * tZ + (x * tY - y * tX));
+    }
+}
+
+MATH_INLINE Quaternion Quaternion::slerp(const Quaternion& quaternion, float factor, Precision precision) const noexcept {
+    float cosAngle = this->dot(quaternion);
+    float sign = (cosAngle < 0.0f) ? -1.0f : 1.0f;
+    cosAngle *= sign;
+
+    float fromFactor;
+    float toFactor;
+
+    if (precision == APPROXIMATE) {
+        // Coefficients of sin(t * angle) / sin(angle) series in (cos(angle) - 1), see header
+        const float mu = 1.85298109240830f;
+        const float u[8] = {
+            1.0f / 3.0f, 1.0f / 10.0f, 1.0f / 21.0f, 1.0f / 36.0f,
+            1.0f / 55.0f, 1.0f / 78.0f, 1.0f / 105.0f, mu / 136.0f
+        };
+        const float v[8] = {
+            1.0f / 3.0f, 2.0f / 5.0f, 3.0f / 7.0f, 4.0f / 9.0f,
+            5.0f / 11.0f, 6.0f / 13.0f, 7.0f / 15.0f, mu * 8.0f / 17.0f
+        };
+
+        float cosAngleMinusOne = cosAngle - 1.0f;
+        float complement = 1.0f - factor;
+        float squareFactor = factor * factor;
+        float squareComplement = complement * complement;
+        toFactor = 1.0f;
+        fromFactor = 1.0f;
+
+        for (int i = 7; i >= 0; i--) {
+            toFactor = 1.0f + (u[i] * squareFactor - v[i]) * cosAngleMinusOne * toFactor;
+            fromFactor = 1.0f + (u[i] * squareComplement - v[i]) * cosAngleMinusOne * fromFactor;
+        }
+
+        toFactor *= factor;
+        fromFactor *= complement;
+    } else if (cosAngle > 0.9995f) {
+        // Nearly parallel quaternions, sin(angle) is too small to divide by
+        return this->nlerp(quaternion, factor);
+    } else {
+        float angle = acosf(cosAngle);
+        float sinAngle = sinf(angle);
+        fromFactor = sinf((1.0f - factor) * angle) / sinAngle;
+        toFactor = sinf(factor * angle) / sinAngle;
+    }
+
+    toFactor *= sign;
+    return Quaternion(this->vector[X] * fromFactor + quaternion.get(X) * toFactor,
+                      this->vector[Y] * fromFactor + quaternion.get(Y) * toFactor,
+                      this->vector[Z] * fromFactor + quaternion.get(Z) * toFactor,
+                      this->vector[W] * fromFactor + quaternion.get(W) * toFactor);
+}
+
+MATH_INLINE Quaternion Quaternion::nlerp(const Quaternion& quaternion, float factor) const noexcept {
+    float toFactor = (this->dot(quaternion) < 0.0f) ? -factor : factor;
+    float fromFactor = 1.0f - factor;
+
+    Quaternion result(this->vector[X] * fromFactor + quaternion.get(X) * toFactor,
+                      this->vector[Y] * fromFactor + quaternion.get(Y) * toFactor,
+                      this->vector[Z] * fromFactor + quaternion.get(Z) * toFactor,
+                      this->vector[W] * fromFactor + quaternion.get(W) * toFactor);
+    return result.normalize();
+}
+
+MATH_INLINE void Quaternion::slerp(const Quaternion* from, const Quaternion* to, const float* factors,
+        Quaternion* result, std::size_t count, Precision precision) noexcept {
+    MATH_PROBE(QUATERNION_INTERPOLATE_BATCH, count);
+
+    std::size_t i = 0;
+
+#if defined(MATH_SIMD)
+    if (precision == APPROXIMATE) {
+        const float mu = 1.85298109240830f;
+        const float u[8] = {
+            1.0f / 3.0f, 1.0f / 10.0f, 1.0f / 21.0f, 1.0f / 36.0f,
+            1.0f / 55.0f, 1.0f / 78.0f, 1.0f / 105.0f, mu / 136.0f
+        };
+        const float v[8] = {
+            1.0f / 3.0f, 2.0f / 5.0f, 3.0f / 7.0f, 4.0f / 9.0f,
+            5.0f / 11.0f, 6.0f / 13.0f, 7.0f / 15.0f, mu * 8.0f / 17.0f
+        };
+
+        Simd::Float4 one = Simd::splat(1.0f);
+
+        // Every lane holds one component of four quaternions
+        for (; i + 4 <= count; i += 4) {
+            Simd::Float4 fromX = Simd::loadu(from[i].vector);
+            Simd::Float4 fromY = Simd::loadu(from[i + 1].vector);
+            Simd::Float4 fromZ = Simd::loadu(from[i + 2].vector);
+            Simd::Float4 fromW = Simd::loadu(from[i + 3].vector);
+            Simd::transpose(fromX, fromY, fromZ, fromW);
+
+            Simd::Float4 toX = Simd::loadu(to[i].vector);
+            Simd::Float4 toY = Simd::loadu(to[i + 1].vector);
+            Simd::Float4 toZ = Simd::loadu(to[i + 2].vector);
+            Simd::Float4 toW = Simd::loadu(to[i + 3].vector);
+            Simd::transpose(toX, toY, toZ, toW);
+
+            Simd::Float4 cosAngle = Simd::mul(fromX, toX);
+            cosAngle = Simd::madd(fromY, toY, cosAngle);
+            cosAngle = Simd::madd(fromZ, toZ, cosAngle);
+            cosAngle = Simd::madd(fromW, toW, cosAngle);
+
+            Simd::Float4 cosAngleMinusOne = Simd::sub(Simd::abs(cosAngle), one);
+            Simd::Float4 factor = Simd::loadu(factors + i);
+            Simd::Float4 complement = Simd::sub(one, factor);
+            Simd::Float4 squareFactor = Simd::mul(factor, factor);
+            Simd::Float4 squareComplement = Simd::mul(complement, complement);
+            Simd::Float4 toFactor = one;
+            Simd::Float4 fromFactor = one;
+
+            for (int j = 7; j >= 0; j--) {
+                Simd::Float4 coefficientU = Simd::splat(u[j]);
+                Simd::Float4 coefficientV = Simd::splat(v[j]);
+                Simd::Float4 termTo = Simd::sub(Simd::mul(coefficientU, squareFactor), coefficientV);
+                Simd::Float4 termFrom = Simd::sub(Simd::mul(coefficientU, squareComplement), coefficientV);
+                toFactor = Simd::madd(Simd::mul(termTo, cosAngleMinusOne), toFactor, one);
+                fromFactor = Simd::madd(Simd::mul(termFrom, cosAngleMinusOne), fromFactor, one);
+            }
+
+            toFactor = Simd::xorSign(Simd::mul(toFactor, factor), cosAngle);
+            fromFactor = Simd::mul(fromFactor, complement);
+
+            Simd::Float4 resultX = Simd::madd(toX, toFactor, Simd::mul(fromX, fromFactor));
+            Simd::Float4 resultY = Simd::madd(toY, toFactor, Simd::mul(fromY, fromFactor));
+            Simd::Float4 resultZ = Simd::madd(toZ, toFactor, Simd::mul(fromZ, fromFactor));
+            Simd::Float4 resultW = Simd::madd(toW, toFactor, Simd::mul(fromW, fromFactor));
+            Simd::transpose(resultX, resultY, resultZ, resultW);
+
+            Simd::storeu(result[i].vector, resultX);
+            Simd::storeu(result[i + 1].vector, resultY);
+            Simd::storeu(result[i + 2].vector, resultZ);
+            Simd::storeu(result[i + 3].vector, resultW);
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        result[i] = from[i].slerp(to[i], factors[i], precision);
+    }
+}
+
+MATH_INLINE void Quaternion::nlerp(const Quaternion* from, const Quaternion* to, const float* factors,
+        Quaternion* result, std::size_t count) noexcept {
+    MATH_PROBE(QUATERNION_INTERPOLATE_BATCH, count);
+
+    std::size_t i = 0;
+
+#if defined(MATH_SIMD)
+    Simd::Float4 one = Simd::splat(1.0f);
+
+    for (; i + 4 <= count; i += 4) {
+        Simd::Float4 fromX = Simd::loadu(from[i].vector);
+        Simd::Float4 fromY = Simd::loadu(from[i + 1].vector);
+        Simd::Float4 fromZ = Simd::loadu(from[i + 2].vector);
+        Simd::Float4 fromW = Simd::loadu(from[i + 3].vector);
+        Simd::transpose(fromX, fromY, fromZ, fromW);
+
+        Simd::Float4 toX = Simd::loadu(to[i].vector);
+        Simd::Float4 toY = Simd::loadu(to[i + 1].vector);
+        Simd::Float4 toZ = Simd::loadu(to[i + 2].vector);
+        Simd::Float4 toW = Simd::loadu(to[i + 3].vector);
+        Simd::transpose(toX, toY, toZ, toW);
+
+        Simd::Float4 cosAngle = Simd::mul(fromX, toX);
+        cosAngle = Simd::madd(fromY, toY, cosAngle);
+        cosAngle = Simd::madd(fromZ, toZ, cosAngle);
+        cosAngle = Simd::madd(fromW, toW, cosAngle);
+
+        Simd::Float4 factor = Simd::loadu(factors + i);
+        Simd::Float4 toFactor = Simd::xorSign(factor, cosAngle);
+        Simd::Float4 fromFactor = Simd::sub(one, factor);
+
+        Simd::Float4 resultX = Simd::madd(toX, toFactor, Simd::mul(fromX, fromFactor));
+        Simd::Float4 resultY = Simd::madd(toY, toFactor, Simd::mul(fromY, fromFactor));
+        Simd::Float4 resultZ = Simd::madd(toZ, toFactor, Simd::mul(fromZ, fromFactor));
+        Simd::Float4 resultW = Simd::madd(toW, toFactor, Simd::mul(fromW, fromFactor));
+
+        Simd::Float4 length = Simd::mul(resultX, resultX);
+        length = Simd::madd(resultY, resultY, length);
+        length = Simd::madd(resultZ, resultZ, length);
+        length = Simd::madd(resultW, resultW, length);
+        length = Simd::sqrt(length);
+
+        resultX = Simd::div(resultX, length);
+        resultY = Simd::div(resultY, length);
+        resultZ = Simd::div(resultZ, length);
+        resultW = Simd::div(resultW, length);
+        Simd::transpose(resultX, resultY, resultZ, resultW);
+
+        Simd::storeu(result[i].vector, resultX);
+        Simd::storeu(result[i + 1].vector, resultY);
+        Simd::storeu(result[i + 2].vector, resultZ);
+        Simd::storeu(result[i + 3].vector, resultW);
+    }
+#endif
+
+    for (; i < count; i++) {
+        result[i] = from[i].nlerp(to[i], factors[i]);
+    }
+}
+
+MATH_INLINE void Quaternion::normalizeFast(const Quaternion* quaternions, Quaternion* result,
+        std::size_t count) noexcept {
+    std::size_t i = 0;
+
+#if defined(MATH_SIMD)
+    for (; i + 4 <= count; i += 4) {
+        Simd::Float4 quaternionX = Simd::loadu(quaternions[i].vector);
+        Simd::Float4 quaternionY = Simd::loadu(quaternions[i + 1].vector);
+        Simd::Float4 quaternionZ = Simd::loadu(quaternions[i + 2].vector);
+        Simd::Float4 quaternionW = Simd::loadu(quaternions[i + 3].vector);
+        Simd::transpose(quaternionX, quaternionY, quaternionZ, quaternionW);
+
+        Simd::Float4 scale = Simd::mul(quaternionX, quaternionX);
+        scale = Simd::madd(quaternionY, quaternionY, scale);
+        scale = Simd::madd(quaternionZ, quaternionZ, scale);
+        scale = Simd::madd(quaternionW, quaternionW, scale);
+        scale = Simd::rsqrt(scale);
+
+        quaternionX = Simd::mul(quaternionX, scale);
+        quaternionY = Simd::mul(quaternionY, scale);
+        quaternionZ = Simd::mul(quaternionZ, scale);
+        quaternionW = Simd::mul(quaternionW, scale);
+        Simd::transpose(quaternionX, quaternionY, quaternionZ, quaternionW);
+
+        Simd::storeu(result[i].vector, quaternionX);
+        Simd::storeu(result[i + 1].vector, quaternionY);
+        Simd::storeu(result[i + 2].vector, quaternionZ);
+        Simd::storeu(result[i + 3].vector, quaternionW);
+    }
+#endif
+
+    for (; i < count; i++) {
+        result[i] = Quaternion(quaternions[i]).normalizeFast();
+    }
+}
+
+MATH_INLINE Mat3 Quaternion::extractMat3() const noexcept {
+    float x2 = this->vector[X] + this->vector[X];
+    float y2 = this->vector[Y] + this->vector[Y];
+    float z2 = this->vector[Z] + this->vector[Z];
+
+    float xx = this->vector[X] * x2;
+    float xy = this->vector[X] * y2;
+    float xz = this->vector[X] * z2;
+    float yy = this->vector[Y] * y2;
+    float yz = this->vector[Y] * z2;
+    float zz = this->vector[Z] * z2;
+    float wx = this->vector[W] * x2;
+    float wy = this->vector[W] * y2;
+    float wz = this->vector[W] * z2;
+
+    Mat3 result(UNINITIALIZED);
+    result.set(0, 0, 1.0f - (yy + zz));
+    result.set(0, 1, xy - wz);
+    result.set(0, 2, xz + wy);
+
+    result.set(1, 0, xy + wz);
+    result.set(1, 1, 1.0f - (xx + zz));
+    result.set(1, 2, yz - wx);
+
+    result.set(2, 0, xz - wy);
+    result.set(2, 1, yz + wx);
+    result.set(2, 2, 1.0f - (xx + yy));
+
+    return result;
+}
+
+MATH_INLINE Mat4 Quaternion::extractMat4() const noexcept {
+    float x2 = this->vector[X] + this->vector[X];
+    float y2 = this->vector[Y] + this->vector[Y];
+    float z2 = this->vector[Z] + this->vector[Z];
+
+    float xx = this->vector[X] * x2;
+    float xy = this->vector[X] * y2;
+    float xz = this->vector[X] * z2;
+    float yy = this->vector[Y] * y2;
+    float yz = this->vector[Y] * z2;
+    float zz = this->vector[Z] * z2;
+    float wx = this->vector[W] * x2;
+    float wy = this->vector[W] * y2;
+    float wz = this->vector[W] * z2;
+
+    Mat4 result;
+    result.set(0, 0, 1.0f - (yy + zz));
+    result.set(0, 1, xy - wz);
+    result.set(0, 2, xz + wy);
+
+    result.set(1, 0, xy + wz);
+    result.set(1, 1, 1.0f - (xx + zz));
+    result.set(1, 2, yz - wx);
+
+    result.set(2, 0, xz - wy);
+    result.set(2, 1, yz + wx);
+    result.set(2, 2, 1.0f - (xx + yy));
+
+    return result;
+}
+
+MATH_INLINE void Quaternion::extractMat4(const Quaternion* quaternions, Mat4* result, std::size_t count) noexcept {
+    MATH_PROBE(QUATERNION_CONVERT_BATCH, count);
+
+    std::size_t i = 0;
+
+#if defined(MATH_SIMD)
+    static_assert(sizeof(Mat4) == sizeof(float) * 16, "Mat4 is expected to be tightly packed");
+
+    Simd::Float4 zero = Simd::splat(0.0f);
+    Simd::Float4 one = Simd::splat(1.0f);
+    Simd::Float4 lastRow = Simd::set(0.0f, 0.0f, 0.0f, 1.0f);
+
+    for (; i + 4 <= count; i += 4) {
+        Simd::Float4 x = Simd::loadu(quaternions[i].vector);
+        Simd::Float4 y = Simd::loadu(quaternions[i + 1].vector);
+        Simd::Float4 z = Simd::loadu(quaternions[i + 2].vector);
+        Simd::Float4 w = Simd::loadu(quaternions[i + 3].vector);
+        Simd::transpose(x, y, z, w);
+
+        Simd::Float4 x2 = Simd::add(x, x);
+        Simd::Float4 y2 = Simd::add(y, y);
+        Simd::Float4 z2 = Simd::add(z, z);
+
+        Simd::Float4 xx = Simd::mul(x, x2);
+        Simd::Float4 xy = Simd::mul(x, y2);
+        Simd::Float4 xz = Simd::mul(x, z2);
+        Simd::Float4 yy = Simd::mul(y, y2);
+        Simd::Float4 yz = Simd::mul(y, z2);
+        Simd::Float4 zz = Simd::mul(z, z2);
+        Simd::Float4 wx = Simd::mul(w, x2);
+        Simd::Float4 wy = Simd::mul(w, y2);
+        Simd::Float4 wz = Simd::mul(w, z2);
+
+        // Lane k of each row register ends up in matrix i + k after the transpose
+        Simd::Float4 row00 = Simd::sub(one, Simd::add(yy, zz));
+        Simd::Float4 row01 = Simd::sub(xy, wz);
+        Simd::Float4 row02 = Simd::add(xz, wy);
+        Simd::Float4 row03 = zero;
+        Simd::transpose(row00, row01, row02, row03);
+
+        Simd::Float4 row10 = Simd::add(xy, wz);
+        Simd::Float4 row11 = Simd::sub(one, Simd::add(xx, zz));
+        Simd::Float4 row12 = Simd::sub(yz, wx);
+        Simd::Float4 row13 = zero;
+        Simd::transpose(row10, row11, row12, row13);
+
+        Simd::Float4 row20 = Simd::sub(xz, wy);
+        Simd::Float4 row21 = Simd::add(yz, wx);
+        Simd::Float4 row22 = Simd::sub(one, Simd::add(xx, yy));
+        Simd::Float4 row23 = zero;
+        Simd::transpose(row20, row21, row22, row23);
+
+        float* destination = reinterpret_cast<float*>(result + i);
+        Simd::Float4 rows[4][3] = {
+            { row00, row10, row20 },
+            { row01, row11, row21 },
+            { row02, row12, row22 },
+            { row03, row13, row23 }
+        };
+
+        for (int k = 0; k < 4; k++) {
+            Simd::store(destination + k * 16, rows[k][0]);
+            Simd::store(destination + k * 16 + 4, rows[k][1]);
+            Simd::store(destination + k * 16 + 8, rows[k][2]);
+            Simd::store(destination + k * 16 + 12, lastRow);
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        result[i] = quaternions[i].extractMat4();
+    }
+}
+
+MATH_INLINE void Quaternion::extractEulerAngles(float& xAngle, float& yAngle, float& zAngle,
+        Precision precision) const noexcept {
+    float xNumerator = 2 * (this->vector[X] * this->vector[W] - this->vector[Y] * this->vector[Z]);
+    float xDenominator = 1 - 2 * (this->vector[X] * this->vector[X] - this->vector[Z] * this->vector[Z]);
+    float yNumerator = 2 * (this->vector[Y] * this->vector[W] - this->vector[X] * this->vector[Z]);
+    float yDenominator = 1 - 2 * (this->vector[Y] * this->vector[Y] - this->vector[Z] * this->vector[Z]);
+    float zSine = 2 * (this->vector[X] * this->vector[Y] + this->vector[Z] * this->vector[W]);
+
+    if (precision == APPROXIMATE) {
+        // asin(s) = atan2(s, sqrt(1 - s^2)), the clamp covers slightly denormalized input
+        xAngle = Quaternion::approximateAtan2(xNumerator, xDenominator);
+        yAngle = Quaternion::approximateAtan2(yNumerator, yDenominator);
+        zAngle = Quaternion::approximateAtan2(zSine, std::sqrt(std::max(1.0f - zSine * zSine, 0.0f)));
+    } else {
+        xAngle = atan2f(xNumerator, xDenominator);
+        yAngle = atan2f(yNumerator, yDenominator);
+        zAngle = asinf(zSine);
+    }
+}
+
+MATH_INLINE void Quaternion::extractEulerAngles(const Quaternion* quaternions, Vec3* angles, std::size_t count,
+        Precision precision) noexcept {
+    MATH_PROBE(QUATERNION_CONVERT_BATCH, count);
+
+    std::size_t i = 0;
+
+#if defined(MATH_SIMD)
+    if (precision == APPROXIMATE) {
+        static_assert(sizeof(Vec3) == sizeof(float) * 3, "Vec3 is expected to be tightly packed");
+
+        Simd::Float4 zero = Simd::splat(0.0f);
+        Simd::Float4 one = Simd::splat(1.0f);
+        Simd::Float4 two = Simd::splat(2.0f);
+        Simd::Float4 halfPi = Simd::splat(1.57079632679f);
+        Simd::Float4 pi = Simd::splat(3.14159265359f);
+        Simd::Float4 smallest = Simd::splat(FLT_MIN);
+
+        // Same octant reduction and polynomial as approximateAtan2()
+        auto atan2 = [&](Simd::Float4 y, Simd::Float4 x) {
+            Simd::Float4 absoluteX = Simd::abs(x);
+            Simd::Float4 absoluteY = Simd::abs(y);
+            Simd::Float4 ratio = Simd::div(Simd::min(absoluteX, absoluteY),
+                    Simd::max(Simd::max(absoluteX, absoluteY), smallest));
+            Simd::Float4 square = Simd::mul(ratio, ratio);
+
+            Simd::Float4 angle = Simd::madd(square, Simd::splat(-0.01172120f), Simd::splat(0.05265332f));
+            angle = Simd::madd(square, angle, Simd::splat(-0.11643287f));
+            angle = Simd::madd(square, angle, Simd::splat(0.19354346f));
+            angle = Simd::madd(square, angle, Simd::splat(-0.33262347f));
+            angle = Simd::madd(square, angle, Simd::splat(0.99997726f));
+            angle = Simd::mul(ratio, angle);
+
+            angle = Simd::select(Simd::compareLess(absoluteX, absoluteY), Simd::sub(halfPi, angle), angle);
+            angle = Simd::select(Simd::compareLess(x, zero), Simd::sub(pi, angle), angle);
+            return Simd::xorSign(angle, y);
+        };
+
+        for (; i + 4 <= count; i += 4) {
+            Simd::Float4 x = Simd::loadu(quaternions[i].vector);
+            Simd::Float4 y = Simd::loadu(quaternions[i + 1].vector);
+            Simd::Float4 z = Simd::loadu(quaternions[i + 2].vector);
+            Simd::Float4 w = Simd::loadu(quaternions[i + 3].vector);
+            Simd::transpose(x, y, z, w);
+
+            Simd::Float4 xNumerator = Simd::mul(two, Simd::sub(Simd::mul(x, w), Simd::mul(y, z)));
+            Simd::Float4 xDenominator = Simd::sub(one, Simd::mul(two, Simd::sub(Simd::mul(x, x), Simd::mul(z, z))));
+            Simd::Float4 yNumerator = Simd::mul(two, Simd::sub(Simd::mul(y, w), Simd::mul(x, z)));
+            Simd::Float4 yDenominator = Simd::sub(one, Simd::mul(two, Simd::sub(Simd::mul(y, y), Simd::mul(z, z))));
+            Simd::Float4 zSine = Simd::mul(two, Simd::add(Simd::mul(x, y), Simd::mul(z, w)));
+            Simd::Float4 zCosine = Simd::sqrt(Simd::max(Simd::sub(one, Simd::mul(zSine, zSine)), zero));
+
+            Simd::Float4 xAngle = atan2(xNumerator, xDenominator);
+            Simd::Float4 yAngle = atan2(yNumerator, yDenominator);
+            Simd::Float4 zAngle = atan2(zSine, zCosine);
+            Simd::Float4 padding = zero;
+            Simd::transpose(xAngle, yAngle, zAngle, padding);
+
+            float* destination = reinterpret_cast<float*>(angles + i);
+            Simd::store3(destination, xAngle);
+            Simd::store3(destination + 3, yAngle);
+            Simd::store3(destination + 6, zAngle);
+            Simd::store3(destination + 9, padding);
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        float xAngle, yAngle, zAngle;
+        quaternions[i].extractEulerAngles(xAngle, yAngle, zAngle, precision);
+        angles[i] = Vec3(xAngle, yAngle, zAngle);
+    }
+}
+
+MATH_INLINE Quaternion Quaternion::fromMat3(const Mat3& matrix) noexcept {
+    return Quaternion::fromRotation(matrix.get(0, 0), matrix.get(0, 1), matrix.get(0, 2),
+                                    matrix.get(1, 0), matrix.get(1, 1), matrix.get(1, 2),
+                                    matrix.get(2, 0), matrix.get(2, 1), matrix.get(2, 2));
+}
+
+MATH_INLINE Quaternion Quaternion::fromMat4(const Mat4& matrix) noexcept {
+    return Quaternion::fromRotation(matrix.get(0, 0), matrix.get(0, 1), matrix.get(0, 2),
+                                    matrix.get(1, 0), matrix.get(1, 1), matrix.get(1, 2),
+                                    matrix.get(2, 0), matrix.get(2, 1), matrix.get(2, 2));
+}
+
+MATH_INLINE void Quaternion::fromMat4(const Mat4* matrices, Quaternion* result, std::size_t count) noexcept {
+    MATH_PROBE(QUATERNION_CONVERT_BATCH, count);
+
+    std::size_t i = 0;
+
+#if defined(MATH_SIMD)
+    static_assert(sizeof(Mat4) == sizeof(float) * 16, "Mat4 is expected to be tightly packed");
+
+    Simd::Float4 zero = Simd::splat(0.0f);
+    Simd::Float4 one = Simd::splat(1.0f);
+    Simd::Float4 two = Simd::splat(2.0f);
+
+    for (; i + 4 <= count; i += 4) {
+        const float* source = reinterpret_cast<const float*>(matrices + i);
+
+        Simd::Float4 m00 = Simd::load(source);
+        Simd::Float4 m01 = Simd::load(source + 16);
+        Simd::Float4 m02 = Simd::load(source + 32);
+        Simd::Float4 m03 = Simd::load(source + 48);
+        Simd::transpose(m00, m01, m02, m03);
+
+        Simd::Float4 m10 = Simd::load(source + 4);
+        Simd::Float4 m11 = Simd::load(source + 20);
+        Simd::Float4 m12 = Simd::load(source + 36);
+        Simd::Float4 m13 = Simd::load(source + 52);
+        Simd::transpose(m10, m11, m12, m13);
+
+        Simd::Float4 m20 = Simd::load(source + 8);
+        Simd::Float4 m21 = Simd::load(source + 24);
+        Simd::Float4 m22 = Simd::load(source + 40);
+        Simd::Float4 m23 = Simd::load(source + 56);
+        Simd::transpose(m20, m21, m22, m23);
+
+        // Shepperd's case per lane, later selects take priority as the scalar branches do
+        Simd::Float4 trace = Simd::add(Simd::add(m00, m11), m22);
+        Simd::Float4 case0 = Simd::compareLess(zero, trace);
+        Simd::Float4 case1 = Simd::select(Simd::compareLess(m11, m00), Simd::compareLess(m22, m00), zero);
+        Simd::Float4 case2 = Simd::compareLess(m22, m11);
+
+        Simd::Float4 radicand0 = Simd::add(trace, one);
+        Simd::Float4 radicand1 = Simd::sub(Simd::sub(Simd::add(one, m00), m11), m22);
+        Simd::Float4 radicand2 = Simd::sub(Simd::sub(Simd::add(one, m11), m00), m22);
+        Simd::Float4 radicand3 = Simd::sub(Simd::sub(Simd::add(one, m22), m00), m11);
+        Simd::Float4 radicand = Simd::select(case0, radicand0,
+                Simd::select(case1, radicand1, Simd::select(case2, radicand2, radicand3)));
+
+        Simd::Float4 difference21 = Simd::sub(m21, m12);
+        Simd::Float4 difference02 = Simd::sub(m02, m20);
+        Simd::Float4 difference10 = Simd::sub(m10, m01);
+        Simd::Float4 sum01 = Simd::add(m01, m10);
+        Simd::Float4 sum02 = Simd::add(m02, m20);
+        Simd::Float4 sum12 = Simd::add(m12, m21);
+
+        // Largest component is scale / 4 = radicand / scale, so every component is a ratio
+        Simd::Float4 inverseScale = Simd::div(one, Simd::mul(Simd::sqrt(radicand), two));
+        Simd::Float4 x = Simd::select(case0, difference21,
+                Simd::select(case1, radicand, Simd::select(case2, sum01, sum02)));
+        Simd::Float4 y = Simd::select(case0, difference02,
+                Simd::select(case1, sum01, Simd::select(case2, radicand, sum12)));
+        Simd::Float4 z = Simd::select(case0, difference10,
+                Simd::select(case1, sum02, Simd::select(case2, sum12, radicand)));
+        Simd::Float4 w = Simd::select(case0, radicand,
+                Simd::select(case1, difference21, Simd::select(case2, difference02, difference10)));
+
+        x = Simd::mul(x, inverseScale);
+        y = Simd::mul(y, inverseScale);
+        z = Simd::mul(z, inverseScale);
+        w = Simd::mul(w, inverseScale);
+        Simd::transpose(x, y, z, w);
+
+        Simd::storeu(result[i].vector, x);
+        Simd::storeu(result[i + 1].vector, y);
+        Simd::storeu(result[i + 2].vector, z);
+        Simd::storeu(result[i + 3].vector, w);
+    }
+#endif
+
+    for (; i < count; i++) {
+        result[i] = Quaternion::fromMat4(matrices[i]);
+    }
+}
+
+MATH_INLINE float Quaternion::approximateAtan2(float y, float x) noexcept {
+    // Minimax atan() polynomial on [0, 1], octants are folded onto the ratio
+    float absoluteX = std::fabs(x);
+    float absoluteY = std::fabs(y);
+    float ratio = std::min(absoluteX, absoluteY) / std::max(std::max(absoluteX, absoluteY), FLT_MIN);
+    float square = ratio * ratio;
+
+    float angle = square * -0.01172120f + 0.05265332f;
+    angle = square * angle - 0.11643287f;
+    angle = square * angle + 0.19354346f;
+    angle = square * angle - 0.33262347f;
+    angle = square * angle + 0.99997726f;
+    angle *= ratio;
+
+    angle = (absoluteX < absoluteY) ? 1.57079632679f - angle : angle;
+    angle = (x < 0.0f) ? 3.14159265359f - angle : angle;
+    return std::copysign(angle, y);
+}
+
+MATH_INLINE Quaternion Quaternion::fromRotation(float m00, float m01, float m02, float m10, float m11, float m12,
+        float m20, float m21, float m22) noexcept {
+    float trace = m00 + m11 + m22;
+
+    // Take the largest of the four squared components to keep the division stable
+    if (trace > 0.0f) {
+        float scale = sqrtf(trace + 1.0f) * 2.0f;
+        return Quaternion((m21 - m12) / scale, (m02 - m20) / scale, (m10 - m01) / scale, 0.25f * scale);
+    } else if (m00 > m11 && m00 > m22) {
+        float scale = sqrtf(1.0f + m00 - m11 - m22) * 2.0f;
+        return Quaternion(0.25f * scale, (m01 + m10) / scale, (m02 + m20) / scale, (m21 - m12) / scale);
+    } else if (m11 > m22) {
+        float scale = sqrtf(1.0f + m11 - m00 - m22) * 2.0f;
+        return Quaternion((m01 + m10) / scale, 0.25f * scale, (m12 + m21) / scale, (m02 - m20) / scale);
+    } else {
+        float scale = sqrtf(1.0f + m22 - m00 - m11) * 2.0f;
+        return Quaternion((m02 + m20) / scale, (m12 + m21) / scale, 0.25f * scale, (m10 - m01) / scale);
+    }
+}
+
+}  // namespace Math
+
+#endif  // QUATERNION_INL
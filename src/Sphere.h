@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SPHERE_H
+#define SPHERE_H
+
+#include <Vec3.h>
+
+namespace Math {
+
+/*!
+ * \brief Bounding sphere.
+ * \details Sphere is stored as its center followed by its radius.
+ */
+class Sphere {
+public:
+    /*!
+     * \brief Default constructor.
+     * \details Constructs zero radius sphere at the origin.
+     */
+    constexpr Sphere();
+
+    /*!
+     * \brief Center and radius constructor.
+     * \param center Sphere center.
+     * \param radius Sphere radius.
+     */
+    constexpr Sphere(const Vec3& center, float radius);
+
+    /*!
+     * \brief Spheres equalty check.
+     * \param sphere Compared sphere.
+     * \return true if spheres are equal, false otherwise.
+     */
+    constexpr bool operator ==(const Sphere& sphere) const;
+
+    /*!
+     * \brief Spheres inequalty check.
+     * \param sphere Compared sphere.
+     * \return false if spheres are equal, true otherwise.
+     */
+    constexpr bool operator !=(const Sphere& sphere) const;
+
+    /*!
+     * \brief Point containment check.
+     * \param point Tested point.
+     * \return true if the point is inside the sphere or on its surface, false otherwise.
+     */
+    constexpr bool contains(const Vec3& point) const;
+
+    /*!
+     * \brief Spheres overlap check.
+     * \param sphere Tested sphere.
+     * \return true if spheres overlap or touch, false otherwise.
+     */
+    constexpr bool intersects(const Sphere& sphere) const;
+
+    /*!
+     * \brief Sphere center selector.
+     * \return Sphere center.
+     */
+    constexpr const Vec3& getCenter() const;
+
+    /*!
+     * \brief Sphere radius selector.
+     * \return Sphere radius.
+     */
+    constexpr float getRadius() const;
+
+private:
+    Vec3 center;
+    float radius;
+};
+
+constexpr Sphere::Sphere():
+        center(),
+        radius(0.0f) {
+}
+
+constexpr Sphere::Sphere(const Vec3& center, float radius):
+        center(center),
+        radius(radius) {
+}
+
+constexpr bool Sphere::operator ==(const Sphere& sphere) const {
+    return (this->center == sphere.getCenter()) && (this->radius == sphere.getRadius());
+}
+
+constexpr bool Sphere::operator !=(const Sphere& sphere) const {
+    return !(*this == sphere);
+}
+
+constexpr bool Sphere::contains(const Vec3& point) const {
+    return (point - this->center).squareLength() <= this->radius * this->radius;
+}
+
+constexpr bool Sphere::intersects(const Sphere& sphere) const {
+    float radius = this->radius + sphere.getRadius();
+    return (sphere.getCenter() - this->center).squareLength() <= radius * radius;
+}
+
+constexpr const Vec3& Sphere::getCenter() const {
+    return this->center;
+}
+
+constexpr float Sphere::getRadius() const {
+    return this->radius;
+}
+
+}  // namespace Math
+
+#endif  // SPHERE_H
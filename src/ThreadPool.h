@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <MathApi.h>
+#include <Executor.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Math {
+
+/*!
+ * \brief Fixed size thread pool.
+ * \details ThreadPool implements Executor with a set of worker threads. Tasks are
+ *          claimed from a shared atomic counter so idle threads pick up remaining
+ *          work of slower ones. The thread calling run() participates as well.
+ */
+class ThreadPool: public Executor {
+public:
+    /*!
+     * \brief Default constructor.
+     * \details Starts one worker less than the hardware concurrency, the calling
+     *          thread makes up for the last one.
+     */
+    MATH_API ThreadPool();
+
+    /*!
+     * \brief Workers constructor.
+     * \param workers Number of worker threads, zero runs all tasks on the calling thread.
+     */
+    MATH_API explicit ThreadPool(std::size_t workers);
+
+    /*!
+     * \brief Destructor.
+     * \details Stops and joins worker threads.
+     */
+    MATH_API ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator =(const ThreadPool&) = delete;
+
+    /*!
+     * \brief Tasks execution.
+     * \details Concurrent run() calls are serialized. Nested calls made from within
+     *          a task run on the calling thread. If a task throws, tasks not yet
+     *          started are skipped and the first exception is rethrown once every
+     *          thread has left the task.
+     * \param count Number of tasks.
+     * \param task Task body.
+     */
+    MATH_API void run(std::size_t count, const std::function<void(std::size_t)>& task) override;
+
+    /*!
+     * \brief Concurrency selector.
+     * \return Number of workers plus the calling thread.
+     */
+    MATH_API std::size_t concurrency() const override;
+
+private:
+    static const ThreadPool*& current();
+
+    void work();
+    void execute(const std::function<void(std::size_t)>& task, std::size_t count);
+
+    std::vector<std::thread> workers;
+    std::mutex runMutex;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::function<void(std::size_t)>* task;
+    std::size_t taskCount;
+    std::atomic<std::size_t> nextTask;
+    std::size_t activeWorkers;
+    std::uint64_t generation;
+    bool stopping;
+    std::exception_ptr failure;
+};
+
+}  // namespace Math
+
+#ifdef MATH_HEADER_ONLY
+#include <ThreadPool.inl>
+#endif
+
+#endif  // THREADPOOL_H
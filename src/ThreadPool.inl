@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef THREADPOOL_INL
+#define THREADPOOL_INL
+
+#include <ThreadPool.h>
+
+namespace Math {
+
+MATH_INLINE ThreadPool::ThreadPool():
+        ThreadPool(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 0) {
+}
+
+MATH_INLINE ThreadPool::ThreadPool(std::size_t workers):
+        task(nullptr),
+        taskCount(0),
+        nextTask(0),
+        activeWorkers(0),
+        generation(0),
+        stopping(false),
+        failure(nullptr) {
+    this->workers.reserve(workers);
+
+    for (std::size_t i = 0; i < workers; i++) {
+        this->workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+MATH_INLINE ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+
+    this->wake.notify_all();
+
+    for (std::thread& worker: this->workers) {
+        worker.join();
+    }
+}
+
+MATH_INLINE void ThreadPool::run(std::size_t count, const std::function<void(std::size_t)>& task) {
+    if (this->workers.empty() || count < 2 || ThreadPool::current() == this) {
+        for (std::size_t i = 0; i < count; i++) {
+            task(i);
+        }
+
+        return;
+    }
+
+    std::lock_guard<std::mutex> runLock(this->runMutex);
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->task = &task;
+        this->taskCount = count;
+        this->nextTask.store(0, std::memory_order_relaxed);
+        this->activeWorkers = this->workers.size();
+        this->generation++;
+    }
+
+    this->wake.notify_all();
+    this->execute(task, count);
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->done.wait(lock, [this] { return this->activeWorkers == 0; });
+    this->task = nullptr;
+
+    // Workers no longer reference the task, safe to unwind the caller
+    std::exception_ptr failure(this->failure);
+    this->failure = nullptr;
+    lock.unlock();
+
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+MATH_INLINE std::size_t ThreadPool::concurrency() const {
+    return this->workers.size() + 1;
+}
+
+MATH_INLINE void ThreadPool::work() {
+    std::uint64_t seenGeneration = 0;
+
+    for (;;) {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->wake.wait(lock, [this, seenGeneration] {
+            return this->stopping || this->generation != seenGeneration;
+        });
+
+        if (this->stopping) {
+            return;
+        }
+
+        seenGeneration = this->generation;
+        const std::function<void(std::size_t)>* task = this->task;
+        std::size_t count = this->taskCount;
+        lock.unlock();
+
+        this->execute(*task, count);
+
+        lock.lock();
+        if (--this->activeWorkers == 0) {
+            this->done.notify_one();
+        }
+    }
+}
+
+MATH_INLINE const ThreadPool*& ThreadPool::current() {
+    // Pool whose task is being executed by the calling thread, nested run() calls go inline
+    static thread_local const ThreadPool* pool = nullptr;
+    return pool;
+}
+
+MATH_INLINE void ThreadPool::execute(const std::function<void(std::size_t)>& task, std::size_t count) {
+    // Restores the enclosing pool however the loop is left
+    struct Scope {
+        const ThreadPool* previous;
+
+        ~Scope() {
+            ThreadPool::current() = this->previous;
+        }
+    } scope = { ThreadPool::current() };
+
+    ThreadPool::current() = this;
+
+    try {
+        for (std::size_t i = this->nextTask.fetch_add(1, std::memory_order_relaxed); i < count;
+                i = this->nextTask.fetch_add(1, std::memory_order_relaxed)) {
+            task(i);
+        }
+    } catch (...) {
+        // Tasks not claimed yet are skipped, run() rethrows the first exception
+        this->nextTask.store(count, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (!this->failure) {
+            this->failure = std::current_exception();
+        }
+    }
+}
+
+}  // namespace Math
+
+#endif  // THREADPOOL_INL
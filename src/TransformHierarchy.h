@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TRANSFORMHIERARCHY_H
+#define TRANSFORMHIERARCHY_H
+
+#include <MathApi.h>
+#include <Vec3.h>
+#include <Quaternion.h>
+#include <Mat4.h>
+#include <cstddef>
+#include <vector>
+
+namespace Math {
+
+/*!
+ * \brief Flat transform hierarchy with cached world matrices.
+ * \details TransformHierarchy keeps local translation, rotation and scale of every
+ *          node together with its world matrix in flat arrays. Nodes are sorted by
+ *          parent index, a parent always precedes its children, so a single forward
+ *          sweep visits parents first. Local mutators mark nodes dirty, update()
+ *          recomputes world matrices of dirty nodes and their subtrees only.
+ *
+ *          sortBreadthFirst() renumbers nodes level by level, siblings become
+ *          adjacent and the sweep reads parent matrices in nearly sequential order.
+ */
+class TransformHierarchy {
+public:
+    static constexpr std::size_t ROOT = static_cast<std::size_t>(-1);  /*!< Parent index of root nodes. */
+
+    /*!
+     * \brief Default constructor.
+     * \details Constructs an empty hierarchy.
+     */
+    MATH_API TransformHierarchy();
+
+    /*!
+     * \brief Node insertion.
+     * \details New node is dirty, its world matrix is valid after the next update().
+     * \param parent Parent node index or #ROOT.
+     * \param translation Local translation.
+     * \param rotation Local unit rotation quaternion.
+     * \param scale Local per-axis scale factors.
+     * \return New node index.
+     * \note There is an assert for parent to be an existing node.
+     */
+    MATH_API std::size_t add(std::size_t parent, const Vec3& translation = Vec3::ZERO,
+            const Quaternion& rotation = Quaternion(), const Vec3& scale = Vec3(1.0f, 1.0f, 1.0f));
+
+    /*!
+     * \brief Capacity reservation.
+     * \param size Expected number of nodes.
+     */
+    MATH_API void reserve(std::size_t size);
+
+    /*!
+     * \brief Local translation mutator.
+     * \param node Node index.
+     * \param translation New local translation.
+     * \note There is an assert for node bounds.
+     */
+    MATH_API void setTranslation(std::size_t node, const Vec3& translation);
+
+    /*!
+     * \brief Local rotation mutator.
+     * \param node Node index.
+     * \param rotation New local unit rotation quaternion.
+     * \note There is an assert for node bounds.
+     */
+    MATH_API void setRotation(std::size_t node, const Quaternion& rotation);
+
+    /*!
+     * \brief Local scale mutator.
+     * \param node Node index.
+     * \param scale New local per-axis scale factors.
+     * \note There is an assert for node bounds.
+     */
+    MATH_API void setScale(std::size_t node, const Vec3& scale);
+
+    /*!
+     * \brief World matrices update.
+     * \details Walks nodes in index order, a node is recomputed as
+     *          world(parent) * Mat4::fromTRS(local) when it or any of its ancestors
+     *          is dirty. Dirty flags are cleared afterwards.
+     * \return Number of recomputed nodes.
+     */
+    MATH_API std::size_t update();
+
+    /*!
+     * \brief Breadth-first renumbering.
+     * \details Reorders nodes level by level, roots first, keeping the relative order
+     *          of siblings. Cached world matrices and dirty flags move with their nodes.
+     * \return Mapping from old to new node indices.
+     */
+    MATH_API std::vector<std::size_t> sortBreadthFirst();
+
+    /*!
+     * \brief Parent selector.
+     * \param node Node index.
+     * \return Parent node index or #ROOT.
+     * \note There is an assert for node bounds.
+     */
+    MATH_API std::size_t getParent(std::size_t node) const;
+
+    /*!
+     * \brief Local translation selector.
+     * \param node Node index.
+     * \return Local translation.
+     * \note There is an assert for node bounds.
+     */
+    MATH_API const Vec3& getTranslation(std::size_t node) const;
+
+    /*!
+     * \brief Local rotation selector.
+     * \param node Node index.
+     * \return Local rotation.
+     * \note There is an assert for node bounds.
+     */
+    MATH_API const Quaternion& getRotation(std::size_t node) const;
+
+    /*!
+     * \brief Local scale selector.
+     * \param node Node index.
+     * \return Local scale factors.
+     * \note There is an assert for node bounds.
+     */
+    MATH_API const Vec3& getScale(std::size_t node) const;
+
+    /*!
+     * \brief World matrix selector.
+     * \param node Node index.
+     * \return World matrix as of the last update().
+     * \note There is an assert for node bounds.
+     */
+    MATH_API const Mat4& getWorld(std::size_t node) const;
+
+    /*!
+     * \brief World matrices accessor.
+     * \return Pointer to size() world matrices in node order, e.g. for buffer uploads.
+     */
+    MATH_API const Mat4* getWorlds() const;
+
+    /*!
+     * \brief Hierarchy's size selector.
+     * \return Number of nodes.
+     */
+    MATH_API std::size_t size() const;
+
+private:
+    std::vector<std::size_t> parents;
+    std::vector<Vec3> translations;
+    std::vector<Quaternion> rotations;
+    std::vector<Vec3> scales;
+    std::vector<Mat4> worlds;
+    std::vector<unsigned char> dirty;
+    std::size_t dirtyCount;
+};
+
+}  // namespace Math
+
+#ifdef MATH_HEADER_ONLY
+#include <TransformHierarchy.inl>
+#endif
+
+#endif  // TRANSFORMHIERARCHY_H
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TRANSFORMHIERARCHY_INL
+#define TRANSFORMHIERARCHY_INL
+
+#include <TransformHierarchy.h>
+#include <Instrumentation.h>
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace Math {
+
+MATH_INLINE TransformHierarchy::TransformHierarchy():
+        dirtyCount(0) {
+}
+
+MATH_INLINE std::size_t TransformHierarchy::add(std::size_t parent, const Vec3& translation,
+        const Quaternion& rotation, const Vec3& scale) {
+    assert(parent == ROOT || parent < this->parents.size());
+
+    this->parents.push_back(parent);
+    this->translations.push_back(translation);
+    this->rotations.push_back(rotation);
+    this->scales.push_back(scale);
+    this->worlds.push_back(Mat4());
+    this->dirty.push_back(1);
+    this->dirtyCount++;
+
+    return this->parents.size() - 1;
+}
+
+MATH_INLINE void TransformHierarchy::reserve(std::size_t size) {
+    this->parents.reserve(size);
+    this->translations.reserve(size);
+    this->rotations.reserve(size);
+    this->scales.reserve(size);
+    this->worlds.reserve(size);
+    this->dirty.reserve(size);
+}
+
+MATH_INLINE void TransformHierarchy::setTranslation(std::size_t node, const Vec3& translation) {
+    assert(node < this->parents.size());
+    this->translations[node] = translation;
+    this->dirtyCount += (this->dirty[node] == 0);
+    this->dirty[node] = 1;
+}
+
+MATH_INLINE void TransformHierarchy::setRotation(std::size_t node, const Quaternion& rotation) {
+    assert(node < this->parents.size());
+    this->rotations[node] = rotation;
+    this->dirtyCount += (this->dirty[node] == 0);
+    this->dirty[node] = 1;
+}
+
+MATH_INLINE void TransformHierarchy::setScale(std::size_t node, const Vec3& scale) {
+    assert(node < this->parents.size());
+    this->scales[node] = scale;
+    this->dirtyCount += (this->dirty[node] == 0);
+    this->dirty[node] = 1;
+}
+
+MATH_INLINE std::size_t TransformHierarchy::update() {
+    MATH_PROBE(TRANSFORM_HIERARCHY_UPDATE, this->parents.size());
+
+    if (this->dirtyCount == 0) {
+        return 0;
+    }
+
+    std::size_t size = this->parents.size();
+    const std::size_t* parents = this->parents.data();
+    unsigned char* dirty = this->dirty.data();
+    std::size_t updated = 0;
+
+    // Parents precede children, a dirty flag set here is seen by every descendant
+    for (std::size_t i = 0; i < size; i++) {
+        std::size_t parent = parents[i];
+        if (parent != ROOT) {
+            dirty[i] |= dirty[parent];
+        }
+
+        if (dirty[i] == 0) {
+            continue;
+        }
+
+        Mat4 local(Mat4::fromTRS(this->translations[i], this->rotations[i], this->scales[i]));
+        this->worlds[i] = (parent == ROOT) ? local : this->worlds[parent] * local;
+        updated++;
+    }
+
+    std::fill(this->dirty.begin(), this->dirty.end(), 0);
+    this->dirtyCount = 0;
+
+    return updated;
+}
+
+MATH_INLINE std::vector<std::size_t> TransformHierarchy::sortBreadthFirst() {
+    std::size_t size = this->parents.size();
+
+    // Children lists in CSR form, slot 0 collects roots
+    std::vector<std::size_t> offsets(size + 2, 0);
+    for (std::size_t i = 0; i < size; i++) {
+        std::size_t parent = this->parents[i];
+        offsets[(parent == ROOT) ? 1 : parent + 2]++;
+    }
+
+    for (std::size_t i = 1; i < offsets.size(); i++) {
+        offsets[i] += offsets[i - 1];
+    }
+
+    std::vector<std::size_t> children(size);
+    for (std::size_t i = 0; i < size; i++) {
+        std::size_t parent = this->parents[i];
+        children[offsets[(parent == ROOT) ? 0 : parent + 1]++] = i;
+    }
+
+    // Children of node n now occupy children[offsets[n]..offsets[n + 1]), roots come first
+    std::vector<std::size_t> order;
+    order.reserve(size);
+    order.insert(order.end(), children.begin(), children.begin() + offsets[0]);
+
+    for (std::size_t i = 0; i < order.size(); i++) {
+        std::size_t node = order[i];
+        order.insert(order.end(), children.begin() + offsets[node], children.begin() + offsets[node + 1]);
+    }
+
+    std::vector<std::size_t> remap(size);
+    for (std::size_t i = 0; i < size; i++) {
+        remap[order[i]] = i;
+    }
+
+    std::vector<std::size_t> parents(size);
+    std::vector<Vec3> translations(size);
+    std::vector<Quaternion> rotations(size);
+    std::vector<Vec3> scales(size);
+    std::vector<Mat4> worlds(size);
+    std::vector<unsigned char> dirty(size);
+
+    for (std::size_t i = 0; i < size; i++) {
+        std::size_t node = order[i];
+        std::size_t parent = this->parents[node];
+        parents[i] = (parent == ROOT) ? ROOT : remap[parent];
+        translations[i] = this->translations[node];
+        rotations[i] = this->rotations[node];
+        scales[i] = this->scales[node];
+        worlds[i] = this->worlds[node];
+        dirty[i] = this->dirty[node];
+    }
+
+    this->parents.swap(parents);
+    this->translations.swap(translations);
+    this->rotations.swap(rotations);
+    this->scales.swap(scales);
+    this->worlds.swap(worlds);
+    this->dirty.swap(dirty);
+
+    return remap;
+}
+
+MATH_INLINE std::size_t TransformHierarchy::getParent(std::size_t node) const {
+    assert(node < this->parents.size());
+    return this->parents[node];
+}
+
+MATH_INLINE const Vec3& TransformHierarchy::getTranslation(std::size_t node) const {
+    assert(node < this->parents.size());
+    return this->translations[node];
+}
+
+MATH_INLINE const Quaternion& TransformHierarchy::getRotation(std::size_t node) const {
+    assert(node < this->parents.size());
+    return this->rotations[node];
+}
+
+MATH_INLINE const Vec3& TransformHierarchy::getScale(std::size_t node) const {
+    assert(node < this->parents.size());
+    return this->scales[node];
+}
+
+MATH_INLINE const Mat4& TransformHierarchy::getWorld(std::size_t node) const {
+    assert(node < this->parents.size());
+    return this->worlds[node];
+}
+
+MATH_INLINE const Mat4* TransformHierarchy::getWorlds() const {
+    return this->worlds.data();
+}
+
+MATH_INLINE std::size_t TransformHierarchy::size() const {
+    return this->parents.size();
+}
+
+}  // namespace Math
+
+#endif  // TRANSFORMHIERARCHY_INL
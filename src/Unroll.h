@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef UNROLL_H
+#define UNROLL_H
+
+#include <type_traits>
+#include <utility>
+
+namespace Math {
+
+/*
+ * Compile time loop used by the templated core to get fully unrolled kernels
+ * regardless of the optimizer heuristics. Function is called with an index
+ * convertible to int, in order from 0 to Count - 1.
+ */
+template<int... Indices, typename Function>
+constexpr void unrollSequence(std::integer_sequence<int, Indices...>, Function&& function) {
+    (function(std::integral_constant<int, Indices>()), ...);
+}
+
+template<int Count, typename Function>
+constexpr void unroll(Function&& function) {
+    unrollSequence(std::make_integer_sequence<int, Count>(), function);
+}
+
+}  // namespace Math
+
+#endif  // UNROLL_H
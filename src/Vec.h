@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef VEC_H
+#define VEC_H
+
+#include <Half.h>
+#include <type_traits>
+
+namespace Math {
+
+/*!
+ * \brief Compile time sized vector template.
+ * \details Vec<N, T> is the templated core shared by all precisions. Every loop is
+ *          unrolled at compile time, there are no runtime dimension checks. It
+ *          implements basic operations that are:
+ *          * vector-vector addition, difference (both one and two operand);
+ *          * vector-scalar multiplication (both one and two operand);
+ *          * dot product, cross product (N = 3), normalization;
+ *          * length, square length calculation;
+ *          * conversion between precisions.
+ *
+ *          Arithmetic is carried out in Scalar type, which is float for Half and
+ *          int for short components.
+ */
+template<int N, typename T>
+class Vec {
+public:
+    static_assert(N > 0, "Vector dimension must be positive");
+
+    typedef T Type;                           /*!< Component type. */
+    typedef decltype(T() * T()) Scalar;       /*!< Arithmetic type. */
+
+    enum {
+        Size = N  /*!< Number of components. */
+    };
+
+    /*!
+     * \brief Default constructor.
+     * \details Constructs zero-length vector.
+     */
+    constexpr Vec();
+
+    /*!
+     * \brief Per-component constructor.
+     * \param values N component values.
+     */
+    template<typename... Values, typename = typename std::enable_if<sizeof...(Values) == N &&
+            ((std::is_arithmetic<Values>::value || std::is_same<Values, T>::value) && ...)>::type>
+    constexpr Vec(Values... values);
+
+    /*!
+     * \brief Array based constructor.
+     * \param data N components.
+     */
+    explicit constexpr Vec(const T* data);
+
+    /*!
+     * \brief Precision conversion constructor.
+     * \param vector Converted vector.
+     */
+    template<typename U>
+    explicit constexpr Vec(const Vec<N, U>& vector);
+
+    /*!
+     * \brief Vectors substraction.
+     * \param vector Substracted vector.
+     * \return Difference vector.
+     */
+    constexpr Vec operator -(const Vec& vector) const;
+
+    /*!
+     * \brief Vectors addition.
+     * \param vector Summand vector.
+     * \return Sum vector.
+     */
+    constexpr Vec operator +(const Vec& vector) const;
+
+    /*!
+     * \brief Vector by scalar multiplication.
+     * \param scalar Scalar multiplier.
+     * \return Product vector.
+     */
+    constexpr Vec operator *(Scalar scalar) const;
+
+    /*!
+     * \brief Vectors substraction.
+     * \param vector Substracted vector.
+     * \return Difference vector.
+     * \note Method has a side-effect.
+     */
+    constexpr Vec& operator -=(const Vec& vector);
+
+    /*!
+     * \brief Vectors addition.
+     * \param vector Summand vector.
+     * \return Sum vector.
+     * \note Method has a side-effect.
+     */
+    constexpr Vec& operator +=(const Vec& vector);
+
+    /*!
+     * \brief Vector by scalar multiplication.
+     * \param scalar Scalar multiplier.
+     * \return Product vector.
+     * \note Method has a side-effect.
+     */
+    constexpr Vec& operator *=(Scalar scalar);
+
+    /*!
+     * \brief Vectors equalty check.
+     * \param vector Compared vector.
+     * \return true if vectors are equal, false otherwise.
+     */
+    constexpr bool operator ==(const Vec& vector) const;
+
+    /*!
+     * \brief Vectors inequalty check.
+     * \param vector Compared vector.
+     * \return false if vectors are equal, true otherwise.
+     */
+    constexpr bool operator !=(const Vec& vector) const;
+
+    /*!
+     * \brief Vector inversion.
+     * \return Inverted vector.
+     */
+    constexpr Vec operator -() const;
+
+    /*!
+     * \brief Dot product calculation.
+     * \param vector Vector mutliplier.
+     * \return Scalar (dot) product.
+     */
+    constexpr Scalar dot(const Vec& vector) const;
+
+    /*!
+     * \brief Cross product calculation.
+     * \param vector Vector mutliplier.
+     * \return Vector (cross) product.
+     * \note Available for three component vectors only.
+     */
+    constexpr Vec cross(const Vec& vector) const;
+
+    /*!
+     * \brief Vector normalization.
+     * \return Normalized (unit) vector.
+     * \note Method has a side-effect.
+     */
+    Vec& normalize();
+
+    /*!
+     * \brief Vector's length calculation.
+     * \return Vector length.
+     */
+    Scalar length() const;
+
+    /*!
+     * \brief Vector's square length calculation.
+     * \return Vector square length.
+     */
+    constexpr Scalar squareLength() const;
+
+    /*!
+     * \brief Vector's component selector.
+     * \param index Component's index.
+     * \return Component's value.
+     */
+    constexpr T get(int index) const;
+
+    /*!
+     * \brief Vector's component mutator.
+     * \param index Component's index.
+     * \param value Component's new value.
+     */
+    constexpr void set(int index, T value);
+
+    /*!
+     * \brief Vector's data accessor.
+     * \return Vector's data pointer.
+     */
+    constexpr const T* data() const;
+
+    /*!
+     * \brief Addition kernel.
+     * \details Computes result = left + right on raw N component arrays.
+     */
+    static constexpr void add(const T* left, const T* right, T* result);
+
+    /*!
+     * \brief Substraction kernel.
+     * \details Computes result = left - right on raw N component arrays.
+     */
+    static constexpr void subtract(const T* left, const T* right, T* result);
+
+    /*!
+     * \brief Scaling kernel.
+     * \details Computes result = vector * scalar on raw N component arrays.
+     */
+    static constexpr void scale(const T* vector, Scalar scalar, T* result);
+
+    /*!
+     * \brief Dot product kernel.
+     * \details Computes dot product of raw N component arrays.
+     */
+    static constexpr Scalar dot(const T* left, const T* right);
+
+    /*!
+     * \brief Cross product kernel.
+     * \details Computes result = left x right on raw three component arrays.
+     * \note Available for three component vectors only.
+     */
+    static constexpr void cross(const T* left, const T* right, T* result);
+
+    /*!
+     * \brief Negation kernel.
+     * \details Computes result = -vector on raw N component arrays.
+     */
+    static constexpr void negate(const T* vector, T* result);
+
+    /*!
+     * \brief Equalty check kernel.
+     * \return true if raw N component arrays are equal, false otherwise.
+     */
+    static constexpr bool equal(const T* left, const T* right);
+
+    /*!
+     * \brief Normalization kernel.
+     * \details Computes result = vector / length on raw N component arrays.
+     */
+    static void normalize(const T* vector, T* result);
+
+private:
+    T vector[N];
+};
+
+typedef Vec<3, double> Vec3d;  /*!< Three component double precision vector. */
+typedef Vec<4, double> Vec4d;  /*!< Four component double precision vector. */
+typedef Vec<3, Half> Vec3h;    /*!< Three component half precision vector. */
+typedef Vec<4, Half> Vec4h;    /*!< Four component half precision vector. */
+typedef Vec<4, short> Vec4s;   /*!< Four component 16 bit integer vector. */
+
+}  // namespace Math
+
+// Templates are always defined in headers, MATH_HEADER_ONLY makes no difference here
+#include <Vec.inl>
+
+#endif  // VEC_H
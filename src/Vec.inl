@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef VEC_INL
+#define VEC_INL
+
+#include <Vec.h>
+#include <Unroll.h>
+#include <cmath>
+#include <cassert>
+
+namespace Math {
+
+template<int N, typename T>
+constexpr Vec<N, T>::Vec():
+        vector() {
+}
+
+template<int N, typename T>
+template<typename... Values, typename>
+constexpr Vec<N, T>::Vec(Values... values):
+        vector { static_cast<T>(values)... } {
+}
+
+template<int N, typename T>
+constexpr Vec<N, T>::Vec(const T* data):
+        vector() {
+    unroll<N>([&](int i) { this->vector[i] = data[i]; });
+}
+
+template<int N, typename T>
+template<typename U>
+constexpr Vec<N, T>::Vec(const Vec<N, U>& vector):
+        vector() {
+    unroll<N>([&](int i) { this->vector[i] = static_cast<T>(vector.get(i)); });
+}
+
+template<int N, typename T>
+constexpr Vec<N, T> Vec<N, T>::operator -(const Vec& vector) const {
+    Vec result;
+    Vec::subtract(this->vector, vector.vector, result.vector);
+    return result;
+}
+
+template<int N, typename T>
+constexpr Vec<N, T> Vec<N, T>::operator +(const Vec& vector) const {
+    Vec result;
+    Vec::add(this->vector, vector.vector, result.vector);
+    return result;
+}
+
+template<int N, typename T>
+constexpr Vec<N, T> Vec<N, T>::operator *(Scalar scalar) const {
+    Vec result;
+    Vec::scale(this->vector, scalar, result.vector);
+    return result;
+}
+
+template<int N, typename T>
+constexpr Vec<N, T>& Vec<N, T>::operator -=(const Vec& vector) {
+    Vec::subtract(this->vector, vector.vector, this->vector);
+    return *this;
+}
+
+template<int N, typename T>
+constexpr Vec<N, T>& Vec<N, T>::operator +=(const Vec& vector) {
+    Vec::add(this->vector, vector.vector, this->vector);
+    return *this;
+}
+
+template<int N, typename T>
+constexpr Vec<N, T>& Vec<N, T>::operator *=(Scalar scalar) {
+    Vec::scale(this->vector, scalar, this->vector);
+    return *this;
+}
+
+template<int N, typename T>
+constexpr bool Vec<N, T>::operator ==(const Vec& vector) const {
+    return Vec::equal(this->vector, vector.vector);
+}
+
+template<int N, typename T>
+constexpr bool Vec<N, T>::operator !=(const Vec& vector) const {
+    return !(*this == vector);
+}
+
+template<int N, typename T>
+constexpr Vec<N, T> Vec<N, T>::operator -() const {
+    Vec result;
+    Vec::negate(this->vector, result.vector);
+    return result;
+}
+
+template<int N, typename T>
+constexpr typename Vec<N, T>::Scalar Vec<N, T>::dot(const Vec& vector) const {
+    return Vec::dot(this->vector, vector.vector);
+}
+
+template<int N, typename T>
+constexpr Vec<N, T> Vec<N, T>::cross(const Vec& vector) const {
+    Vec result;
+    Vec::cross(this->vector, vector.vector, result.vector);
+    return result;
+}
+
+template<int N, typename T>
+Vec<N, T>& Vec<N, T>::normalize() {
+    Vec::normalize(this->vector, this->vector);
+    return *this;
+}
+
+template<int N, typename T>
+typename Vec<N, T>::Scalar Vec<N, T>::length() const {
+    return static_cast<Scalar>(std::sqrt(this->squareLength()));
+}
+
+template<int N, typename T>
+constexpr typename Vec<N, T>::Scalar Vec<N, T>::squareLength() const {
+    return Vec::dot(this->vector, this->vector);
+}
+
+template<int N, typename T>
+constexpr T Vec<N, T>::get(int index) const {
+    assert(index >= 0 && index < N);
+    return this->vector[index];
+}
+
+template<int N, typename T>
+constexpr void Vec<N, T>::set(int index, T value) {
+    assert(index >= 0 && index < N);
+    this->vector[index] = value;
+}
+
+template<int N, typename T>
+constexpr const T* Vec<N, T>::data() const {
+    return this->vector;
+}
+
+template<int N, typename T>
+constexpr void Vec<N, T>::add(const T* left, const T* right, T* result) {
+    unroll<N>([&](int i) { result[i] = static_cast<T>(left[i] + right[i]); });
+}
+
+template<int N, typename T>
+constexpr void Vec<N, T>::subtract(const T* left, const T* right, T* result) {
+    unroll<N>([&](int i) { result[i] = static_cast<T>(left[i] - right[i]); });
+}
+
+template<int N, typename T>
+constexpr void Vec<N, T>::scale(const T* vector, Scalar scalar, T* result) {
+    unroll<N>([&](int i) { result[i] = static_cast<T>(vector[i] * scalar); });
+}
+
+template<int N, typename T>
+constexpr typename Vec<N, T>::Scalar Vec<N, T>::dot(const T* left, const T* right) {
+    // Seeded with the first product, an addition to zero cannot be folded because of -0.0f
+    Scalar product = static_cast<Scalar>(left[0]) * static_cast<Scalar>(right[0]);
+    unroll<N - 1>([&](int i) { product += static_cast<Scalar>(left[i + 1]) * static_cast<Scalar>(right[i + 1]); });
+    return product;
+}
+
+template<int N, typename T>
+constexpr void Vec<N, T>::cross(const T* left, const T* right, T* result) {
+    static_assert(N == 3, "Cross product is defined for three component vectors only");
+
+    // Operands are read first, result may be the same array as either of them
+    Scalar x = static_cast<Scalar>(left[1]) * right[2] - static_cast<Scalar>(left[2]) * right[1];
+    Scalar y = static_cast<Scalar>(left[2]) * right[0] - static_cast<Scalar>(left[0]) * right[2];
+    Scalar z = static_cast<Scalar>(left[0]) * right[1] - static_cast<Scalar>(left[1]) * right[0];
+
+    result[0] = static_cast<T>(x);
+    result[1] = static_cast<T>(y);
+    result[2] = static_cast<T>(z);
+}
+
+template<int N, typename T>
+constexpr void Vec<N, T>::negate(const T* vector, T* result) {
+    unroll<N>([&](int i) { result[i] = static_cast<T>(-vector[i]); });
+}
+
+template<int N, typename T>
+constexpr bool Vec<N, T>::equal(const T* left, const T* right) {
+    bool equal = true;
+    unroll<N>([&](int i) { equal = equal && (left[i] == right[i]); });
+    return equal;
+}
+
+template<int N, typename T>
+void Vec<N, T>::normalize(const T* vector, T* result) {
+    Scalar length = static_cast<Scalar>(std::sqrt(Vec::dot(vector, vector)));
+    unroll<N>([&](int i) { result[i] = static_cast<T>(vector[i] / length); });
+}
+
+}  // namespace Math
+
+#endif  // VEC_INL
@@ -24,6 +24,10 @@
 #define VEC3_H
 
 #include <MathApi.h>
+#include <Uninitialized.h>
+#include <Vec.h>
+#include <cassert>
+#include <type_traits>
 
 namespace Math {
 
@@ -43,16 +47,23 @@ public:
         Z = 2   /*!< Z component index. */
     };
 
-    MATH_API static const Vec3 UNIT_X;  /*!< X unit vector. */
-    MATH_API static const Vec3 UNIT_Y;  /*!< Y unit vector. */
-    MATH_API static const Vec3 UNIT_Z;  /*!< Z unit vector. */
-    MATH_API static const Vec3 ZERO;    /*!< Zero length vector. */
+    static const Vec3 UNIT_X;  /*!< X unit vector. */
+    static const Vec3 UNIT_Y;  /*!< Y unit vector. */
+    static const Vec3 UNIT_Z;  /*!< Z unit vector. */
+    static const Vec3 ZERO;    /*!< Zero length vector. */
 
     /*!
      * \brief Default constructor.
      * \details Constructs zero-length vector.
      */
-    MATH_API Vec3();
+    constexpr Vec3() noexcept;
+
+    /*!
+     * \brief Uninitialized constructor.
+     * \details Leaves components indeterminate, for results written completely right after.
+     * \note Reading components before writing them is undefined behaviour.
+     */
+    explicit Vec3(Uninitialized) noexcept;
 
     /*!
      * \brief Per-component constructor.
@@ -61,28 +72,34 @@ public:
      * \param y Y component.
      * \param z Z component.
      */
-    MATH_API Vec3(float x, float y, float z);
+    constexpr Vec3(float x, float y, float z) noexcept;
+
+    /*!
+     * \brief Array based constructor.
+     * \param data Pointer to x, y, z values.
+     */
+    explicit constexpr Vec3(const float* data) noexcept;
 
     /*!
      * \brief Vectors substraction.
      * \param vector Substructed vector.
      * \return Difference vector.
      */
-    MATH_API Vec3 operator -(const Vec3& vector) const;
+    constexpr Vec3 operator -(const Vec3& vector) const noexcept;
 
     /*!
      * \brief Vectors addition.
      * \param vector Summand vector.
      * \return Sum vector.
      */
-    MATH_API Vec3 operator +(const Vec3& vector) const;
+    constexpr Vec3 operator +(const Vec3& vector) const noexcept;
 
     /*!
      * \brief Vector by scalar multiplication.
      * \param scalar Scalar multiplier.
      * \return Product vector.
      */
-    MATH_API Vec3 operator *(float scalar) const;
+    constexpr Vec3 operator *(float scalar) const noexcept;
 
     /*!
      * \brief Vector substruction.
@@ -90,7 +107,7 @@ public:
      * \return Difference vector.
      * \note Method has a side-effect.
      */
-    MATH_API Vec3& operator -=(const Vec3& vector);
+    constexpr Vec3& operator -=(const Vec3& vector) noexcept;
 
     /*!
      * \brief Vector addition.
@@ -98,7 +115,7 @@ public:
      * \return Sum vector.
      * \note Method has a side-effect.
      */
-    MATH_API Vec3& operator +=(const Vec3& vector);
+    constexpr Vec3& operator +=(const Vec3& vector) noexcept;
 
     /*!
      * \brief Scalar multiplication.
@@ -106,61 +123,72 @@ public:
      * \return Product vector.
      * \note Method has a side-effect.
      */
-    MATH_API Vec3& operator *=(float scalar);
+    constexpr Vec3& operator *=(float scalar) noexcept;
 
     /*!
      * \brief Vectors equalty check.
      * \param vector Compared vector.
      * \return true if vectors are equal, false otherwise.
      */
-    MATH_API bool operator ==(const Vec3& vector) const;
+    constexpr bool operator ==(const Vec3& vector) const noexcept;
 
     /*!
      * \brief Vectors inequalty check.
      * \param vector Compared vector.
      * \return false if vectors are equal, true otherwise.
      */
-    MATH_API bool operator !=(const Vec3& vector) const;
+    constexpr bool operator !=(const Vec3& vector) const noexcept;
 
     /*!
      * \brief Vector inversion.
      * \return Inverted vector.
      * \note Method has a side-effect.
      */
-    MATH_API Vec3 operator -() const;
+    constexpr Vec3 operator -() const noexcept;
 
     /*!
      * \brief Dot product calculation.
      * \param vector Vector mutliplier.
      * \return Scalar (dot) product.
      */
-    MATH_API float dot(const Vec3& vector) const;
+    constexpr float dot(const Vec3& vector) const noexcept;
 
     /*!
      * \brief Cross product calculation.
      * \param vector Vector mutliplier.
      * \return Vector (cross) product.
      */
-    MATH_API Vec3 cross(const Vec3& vector) const;
+    constexpr Vec3 cross(const Vec3& vector) const noexcept;
 
     /*!
      * \brief Vector normalization.
      * \return Normalized (unit) vector.
      * \note Method has a side-effect.
      */
-    MATH_API Vec3& normalize();
+    MATH_API Vec3& normalize() noexcept;
+
+    /*!
+     * \brief Approximate vector normalization.
+     * \details Scales vector by a reciprocal square root estimate refined with one
+     *          Newton-Raphson step instead of dividing by length(). Relative error
+     *          stays within 1e-4 (2.5e-7 on SSE), normalize() remains the exact version.
+     * \return Normalized (unit) vector.
+     * \note Vector of zero length produces NaN components, no check is performed.
+     * \note Method has a side-effect.
+     */
+    MATH_API Vec3& normalizeFast() noexcept;
 
     /*!
      * \brief Vector's length calculation.
      * \return Vector length.
      */
-    MATH_API float length() const;
+    MATH_API float length() const noexcept;
 
     /*!
      * \brief Vector's square length calculation.
      * \return Vector square length.
      */
-    MATH_API float squareLength() const;
+    constexpr float squareLength() const noexcept;
 
     /*!
      * \brief Vector's component selector.
@@ -168,7 +196,7 @@ public:
      * \return Component's value.
      * \note You are advised to use #X, #Y, #Z constants as indices.
      */
-    MATH_API float get(int index) const;
+    constexpr float get(int index) const noexcept;
 
     /*!
      * \brief Vector's component mutator.
@@ -176,18 +204,118 @@ public:
      * \param value Component's new value.
      * \note You are advised to use #X, #Y, #Z constants as indices.
      */
-    MATH_API void set(int index, float value);
+    constexpr void set(int index, float value) noexcept;
 
     /*!
      * \brief Vector's data accessor.
      * \return Vector's data pointer.
      */
-    MATH_API const float* data() const;
+    constexpr const float* data() const noexcept;
 
 private:
     float vector[3];
 };
 
+static_assert(std::is_trivially_copyable<Vec3>::value, "Vec3 should be copied with memcpy");
+static_assert(std::is_nothrow_move_constructible<Vec3>::value && std::is_nothrow_move_assignable<Vec3>::value,
+        "Vec3 should be moved without exceptions");
+
+constexpr Vec3::Vec3() noexcept:
+        vector() {
+}
+
+inline Vec3::Vec3(Uninitialized) noexcept {
+}
+
+constexpr Vec3::Vec3(float x, float y, float z) noexcept:
+        vector{x, y, z} {
+}
+
+constexpr Vec3::Vec3(const float* data) noexcept:
+        vector{data[X], data[Y], data[Z]} {
+}
+
+constexpr Vec3 Vec3::operator -(const Vec3& vector) const noexcept {
+    Vec3 me(*this);
+    return me -= vector;
+}
+
+constexpr Vec3 Vec3::operator +(const Vec3& vector) const noexcept {
+    Vec3 me(*this);
+    return me += vector;
+}
+
+constexpr Vec3 Vec3::operator *(float scalar) const noexcept {
+    Vec3 me(*this);
+    return me *= scalar;
+}
+
+constexpr Vec3& Vec3::operator -=(const Vec3& vector) noexcept {
+    Vec<3, float>::subtract(this->vector, vector.vector, this->vector);
+    return *this;
+}
+
+constexpr Vec3& Vec3::operator +=(const Vec3& vector) noexcept {
+    Vec<3, float>::add(this->vector, vector.vector, this->vector);
+    return *this;
+}
+
+constexpr Vec3& Vec3::operator *=(float scalar) noexcept {
+    Vec<3, float>::scale(this->vector, scalar, this->vector);
+    return *this;
+}
+
+constexpr bool Vec3::operator ==(const Vec3& vector) const noexcept {
+    return Vec<3, float>::equal(this->vector, vector.vector);
+}
+
+constexpr bool Vec3::operator !=(const Vec3& vector) const noexcept {
+    return !(*this == vector);
+}
+
+constexpr Vec3 Vec3::operator -() const noexcept {
+    Vec3 result;
+    Vec<3, float>::negate(this->vector, result.vector);
+    return result;
+}
+
+constexpr float Vec3::dot(const Vec3& vector) const noexcept {
+    return Vec<3, float>::dot(this->vector, vector.vector);
+}
+
+constexpr Vec3 Vec3::cross(const Vec3& vector) const noexcept {
+    Vec3 result;
+    Vec<3, float>::cross(this->vector, vector.vector, result.vector);
+    return result;
+}
+
+constexpr float Vec3::squareLength() const noexcept {
+    return Vec<3, float>::dot(this->vector, this->vector);
+}
+
+constexpr float Vec3::get(int index) const noexcept {
+    assert(index >= X && index <= Z);
+    return this->vector[index];
+}
+
+constexpr void Vec3::set(int index, float value) noexcept {
+    assert(index >= X && index <= Z);
+    this->vector[index] = value;
+}
+
+constexpr const float* Vec3::data() const noexcept {
+    return this->vector;
+}
+
+inline constexpr Vec3 Vec3::UNIT_X(1.0f, 0.0f, 0.0f);
+inline constexpr Vec3 Vec3::UNIT_Y(0.0f, 1.0f, 0.0f);
+inline constexpr Vec3 Vec3::UNIT_Z(0.0f, 0.0f, 1.0f);
+inline constexpr Vec3 Vec3::ZERO(0.0f, 0.0f, 0.0f);
+
 }  // namespace Math
 
+#ifdef MATH_HEADER_ONLY
+#include <Vec3.inl>
+#endif
+
 #endif  // VEC3_H
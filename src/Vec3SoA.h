@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef VEC3SOA_H
+#define VEC3SOA_H
+
+#include <MathApi.h>
+#include <cstddef>
+
+namespace Math {
+
+class Vec3;
+
+/*!
+ * \brief Structure of arrays container of three component vectors.
+ * \details Vec3SoA keeps X, Y and Z components in separate cache line aligned
+ *          streams and implements bulk counterparts of Vec3 operations that are:
+ *          * vector-vector addition, difference;
+ *          * vector-scalar multiplication;
+ *          * dot and cross product, normalization;
+ *          * length, square length calculation.
+ */
+class Vec3SoA {
+public:
+    /*!
+     * \brief Default constructor.
+     * \details Constructs an empty container.
+     */
+    MATH_API Vec3SoA() noexcept;
+
+    /*!
+     * \brief Sized constructor.
+     * \details Constructs a container of zero-length vectors.
+     * \param size Number of vectors.
+     */
+    MATH_API explicit Vec3SoA(std::size_t size);
+
+    /*!
+     * \brief Vec3 array based constructor.
+     * \param vectors Source vectors.
+     * \param count Number of vectors.
+     */
+    MATH_API Vec3SoA(const Vec3* vectors, std::size_t count);
+
+    /*!
+     * \brief Copy constructor.
+     * \param soa Source container.
+     */
+    MATH_API Vec3SoA(const Vec3SoA& soa);
+
+    /*!
+     * \brief Move constructor.
+     * \param soa Source container, left empty.
+     */
+    MATH_API Vec3SoA(Vec3SoA&& soa) noexcept;
+
+    /*!
+     * \brief Destructor.
+     */
+    MATH_API ~Vec3SoA();
+
+    /*!
+     * \brief Copy assignment.
+     * \param soa Source container.
+     * \return Assigned container.
+     */
+    MATH_API Vec3SoA& operator =(const Vec3SoA& soa);
+
+    /*!
+     * \brief Move assignment.
+     * \param soa Source container, left empty.
+     * \return Assigned container.
+     */
+    MATH_API Vec3SoA& operator =(Vec3SoA&& soa) noexcept;
+
+    /*!
+     * \brief Vectors substraction.
+     * \param soa Substructed vectors, must be of the same size.
+     * \return Difference vectors.
+     * \note Method has a side-effect.
+     */
+    MATH_API Vec3SoA& operator -=(const Vec3SoA& soa);
+
+    /*!
+     * \brief Vectors addition.
+     * \param soa Summand vectors, must be of the same size.
+     * \return Sum vectors.
+     * \note Method has a side-effect.
+     */
+    MATH_API Vec3SoA& operator +=(const Vec3SoA& soa);
+
+    /*!
+     * \brief Scalar multiplication.
+     * \param scalar Scalar multiplier.
+     * \return Product vectors.
+     * \note Method has a side-effect.
+     */
+    MATH_API Vec3SoA& operator *=(float scalar);
+
+    /*!
+     * \brief Dot products calculation.
+     * \param soa Vector multipliers, must be of the same size.
+     * \param result Scalar (dot) products, size() elements.
+     */
+    MATH_API void dot(const Vec3SoA& soa, float* result) const;
+
+    /*!
+     * \brief Ranged dot products calculation.
+     * \details Same as dot(const Vec3SoA&, float*) const for count vectors starting
+     *          at first, result is indexed as in the full calculation.
+     * \param soa Vector multipliers, must be of the same size.
+     * \param result Scalar (dot) products, size() elements.
+     * \param first First vector index, must be a multiple of 4.
+     * \param count Number of vectors.
+     */
+    MATH_API void dot(const Vec3SoA& soa, float* result, std::size_t first, std::size_t count) const;
+
+    /*!
+     * \brief Cross products calculation.
+     * \param soa Vector multipliers, must be of the same size.
+     * \param result Vector (cross) products, resized to size() if needed.
+     *        May be the same container as this or soa.
+     */
+    MATH_API void cross(const Vec3SoA& soa, Vec3SoA& result) const;
+
+    /*!
+     * \brief Vectors normalization.
+     * \return Normalized (unit) vectors.
+     * \note Method has a side-effect.
+     */
+    MATH_API Vec3SoA& normalize();
+
+    /*!
+     * \brief Ranged vectors normalization.
+     * \details Same as normalize() for count vectors starting at first.
+     * \param first First vector index, must be a multiple of 4.
+     * \param count Number of vectors.
+     * \return Partially normalized vectors.
+     * \note Method has a side-effect.
+     */
+    MATH_API Vec3SoA& normalize(std::size_t first, std::size_t count);
+
+    /*!
+     * \brief Approximate vectors normalization.
+     * \details Batch equivalent of Vec3::normalizeFast(), four reciprocal square root
+     *          estimates per SIMD pass replace square roots and divisions.
+     * \return Normalized (unit) vectors.
+     * \note Method has a side-effect.
+     */
+    MATH_API Vec3SoA& normalizeFast();
+
+    /*!
+     * \brief Ranged approximate vectors normalization.
+     * \details Same as normalizeFast() for count vectors starting at first.
+     * \param first First vector index, must be a multiple of 4.
+     * \param count Number of vectors.
+     * \return Partially normalized vectors.
+     * \note Method has a side-effect.
+     */
+    MATH_API Vec3SoA& normalizeFast(std::size_t first, std::size_t count);
+
+    /*!
+     * \brief Vectors' length calculation.
+     * \param result Vector lengths, size() elements.
+     */
+    MATH_API void length(float* result) const;
+
+    /*!
+     * \brief Vectors' square length calculation.
+     * \param result Vector square lengths, size() elements.
+     */
+    MATH_API void squareLength(float* result) const;
+
+    /*!
+     * \brief Container resizing.
+     * \details Keeps existing vectors, new vectors are zero-length.
+     * \param size New number of vectors.
+     */
+    MATH_API void resize(std::size_t size);
+
+    /*!
+     * \brief Container's size accessor.
+     * \return Number of vectors.
+     */
+    MATH_API std::size_t size() const;
+
+    /*!
+     * \brief Vec3 array conversion.
+     * \details Resizes the container to count and copies vectors in.
+     * \param vectors Source vectors.
+     * \param count Number of vectors.
+     */
+    MATH_API void load(const Vec3* vectors, std::size_t count);
+
+    /*!
+     * \brief Vec3 array conversion.
+     * \param vectors Destination vectors, size() elements.
+     */
+    MATH_API void store(Vec3* vectors) const;
+
+    /*!
+     * \brief Vector selector.
+     * \param index Vector's index.
+     * \return Vector value.
+     */
+    MATH_API Vec3 get(std::size_t index) const;
+
+    /*!
+     * \brief Vector mutator.
+     * \param index Vector's index.
+     * \param vector Vector's new value.
+     */
+    MATH_API void set(std::size_t index, const Vec3& vector);
+
+    /*!
+     * \brief Component stream accessor.
+     * \param component Component's index.
+     * \return Stream data pointer, aligned to a cache line.
+     * \note You are advised to use Vec3::X, Vec3::Y, Vec3::Z constants as indices.
+     */
+    MATH_API float* data(int component);
+
+    /*!
+     * \brief Component stream accessor.
+     * \param component Component's index.
+     * \return Stream data pointer, aligned to a cache line.
+     * \note You are advised to use Vec3::X, Vec3::Y, Vec3::Z constants as indices.
+     */
+    MATH_API const float* data(int component) const;
+
+private:
+    float* streams[3];
+    std::size_t count;
+    std::size_t capacity;
+};
+
+}  // namespace Math
+
+#ifdef MATH_HEADER_ONLY
+#include <Vec3SoA.inl>
+#endif
+
+#endif  // VEC3SOA_H
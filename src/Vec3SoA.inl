@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef VEC3SOA_INL
+#define VEC3SOA_INL
+
+#include <Vec3SoA.h>
+#include <Vec3.h>
+#include <MathSimd.h>
+#include <Dispatch.h>
+#include <Instrumentation.h>
+#include <cmath>
+#include <cassert>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace Math {
+
+MATH_INLINE Vec3SoA::Vec3SoA() noexcept {
+    this->streams[Vec3::X] = nullptr;
+    this->streams[Vec3::Y] = nullptr;
+    this->streams[Vec3::Z] = nullptr;
+    this->count = 0;
+    this->capacity = 0;
+}
+
+MATH_INLINE Vec3SoA::Vec3SoA(std::size_t size):
+        Vec3SoA() {
+    this->resize(size);
+}
+
+MATH_INLINE Vec3SoA::Vec3SoA(const Vec3* vectors, std::size_t count):
+        Vec3SoA() {
+    this->load(vectors, count);
+}
+
+MATH_INLINE Vec3SoA::Vec3SoA(const Vec3SoA& soa):
+        Vec3SoA(soa.size()) {
+    if (this->count > 0) {
+        for (int i = Vec3::X; i <= Vec3::Z; i++) {
+            std::memcpy(this->streams[i], soa.data(i), this->count * sizeof(float));
+        }
+    }
+}
+
+MATH_INLINE Vec3SoA::Vec3SoA(Vec3SoA&& soa) noexcept:
+        Vec3SoA() {
+    *this = std::move(soa);
+}
+
+MATH_INLINE Vec3SoA::~Vec3SoA() {
+    if (this->streams[Vec3::X] != nullptr) {
+        operator delete(this->streams[Vec3::X], std::align_val_t(64));
+    }
+}
+
+MATH_INLINE Vec3SoA& Vec3SoA::operator =(const Vec3SoA& soa) {
+    if (this != &soa) {
+        Vec3SoA copy(soa);
+        *this = std::move(copy);
+    }
+
+    return *this;
+}
+
+MATH_INLINE Vec3SoA& Vec3SoA::operator =(Vec3SoA&& soa) noexcept {
+    std::swap(this->streams, soa.streams);
+    std::swap(this->count, soa.count);
+    std::swap(this->capacity, soa.capacity);
+    return *this;
+}
+
+MATH_INLINE Vec3SoA& Vec3SoA::operator -=(const Vec3SoA& soa) {
+    assert(this->count == soa.size());
+    for (int j = Vec3::X; j <= Vec3::Z; j++) {
+        float* left = this->streams[j];
+        const float* right = soa.data(j);
+        std::size_t i = 0;
+
+#if defined(MATH_SIMD)
+        for (; i + 4 <= this->count; i += 4) {
+            Simd::store(left + i, Simd::sub(Simd::load(left + i), Simd::load(right + i)));
+        }
+#endif
+
+        for (; i < this->count; i++) {
+            left[i] -= right[i];
+        }
+    }
+
+    return *this;
+}
+
+MATH_INLINE Vec3SoA& Vec3SoA::operator +=(const Vec3SoA& soa) {
+    assert(this->count == soa.size());
+    for (int j = Vec3::X; j <= Vec3::Z; j++) {
+        float* left = this->streams[j];
+        const float* right = soa.data(j);
+        std::size_t i = 0;
+
+#if defined(MATH_SIMD)
+        for (; i + 4 <= this->count; i += 4) {
+            Simd::store(left + i, Simd::add(Simd::load(left + i), Simd::load(right + i)));
+        }
+#endif
+
+        for (; i < this->count; i++) {
+            left[i] += right[i];
+        }
+    }
+
+    return *this;
+}
+
+MATH_INLINE Vec3SoA& Vec3SoA::operator *=(float scalar) {
+    for (int j = Vec3::X; j <= Vec3::Z; j++) {
+        float* stream = this->streams[j];
+        std::size_t i = 0;
+
+#if defined(MATH_SIMD)
+        Simd::Float4 multiplier = Simd::splat(scalar);
+        for (; i + 4 <= this->count; i += 4) {
+            Simd::store(stream + i, Simd::mul(Simd::load(stream + i), multiplier));
+        }
+#endif
+
+        for (; i < this->count; i++) {
+            stream[i] *= scalar;
+        }
+    }
+
+    return *this;
+}
+
+MATH_INLINE void Vec3SoA::dot(const Vec3SoA& soa, float* result) const {
+    this->dot(soa, result, 0, this->count);
+}
+
+MATH_INLINE void Vec3SoA::dot(const Vec3SoA& soa, float* result, std::size_t first, std::size_t count) const {
+    MATH_PROBE(VEC_SOA_DOT, count);
+
+    assert(this->count == soa.size());
+    assert(first % 4 == 0 && first + count <= this->count);
+    const float* left[3] = { this->streams[Vec3::X], this->streams[Vec3::Y], this->streams[Vec3::Z] };
+    const float* right[3] = { soa.data(Vec3::X), soa.data(Vec3::Y), soa.data(Vec3::Z) };
+    Dispatch::getKernels().dot3(left, right, result, first, first + count);
+}
+
+MATH_INLINE void Vec3SoA::cross(const Vec3SoA& soa, Vec3SoA& result) const {
+    assert(this->count == soa.size());
+    result.resize(this->count);
+
+    const float* x = this->streams[Vec3::X];
+    const float* y = this->streams[Vec3::Y];
+    const float* z = this->streams[Vec3::Z];
+    const float* otherX = soa.data(Vec3::X);
+    const float* otherY = soa.data(Vec3::Y);
+    const float* otherZ = soa.data(Vec3::Z);
+    float* resultX = result.data(Vec3::X);
+    float* resultY = result.data(Vec3::Y);
+    float* resultZ = result.data(Vec3::Z);
+    std::size_t i = 0;
+
+#if defined(MATH_SIMD)
+    for (; i + 4 <= this->count; i += 4) {
+        Simd::Float4 leftX = Simd::load(x + i);
+        Simd::Float4 leftY = Simd::load(y + i);
+        Simd::Float4 leftZ = Simd::load(z + i);
+        Simd::Float4 rightX = Simd::load(otherX + i);
+        Simd::Float4 rightY = Simd::load(otherY + i);
+        Simd::Float4 rightZ = Simd::load(otherZ + i);
+        Simd::store(resultX + i, Simd::sub(Simd::mul(leftY, rightZ), Simd::mul(leftZ, rightY)));
+        Simd::store(resultY + i, Simd::sub(Simd::mul(leftZ, rightX), Simd::mul(leftX, rightZ)));
+        Simd::store(resultZ + i, Simd::sub(Simd::mul(leftX, rightY), Simd::mul(leftY, rightX)));
+    }
+#endif
+
+    for (; i < this->count; i++) {
+        float leftX = x[i], leftY = y[i], leftZ = z[i];
+        float rightX = otherX[i], rightY = otherY[i], rightZ = otherZ[i];
+        resultX[i] = leftY * rightZ - leftZ * rightY;
+        resultY[i] = leftZ * rightX - leftX * rightZ;
+        resultZ[i] = leftX * rightY - leftY * rightX;
+    }
+}
+
+MATH_INLINE Vec3SoA& Vec3SoA::normalize() {
+    return this->normalize(0, this->count);
+}
+
+MATH_INLINE Vec3SoA& Vec3SoA::normalize(std::size_t first, std::size_t count) {
+    MATH_PROBE(VEC_SOA_NORMALIZE, count);
+
+    assert(first % 4 == 0 && first + count <= this->count);
+    Dispatch::getKernels().normalize3(this->streams, first, first + count);
+    return *this;
+}
+
+MATH_INLINE Vec3SoA& Vec3SoA::normalizeFast() {
+    return this->normalizeFast(0, this->count);
+}
+
+MATH_INLINE Vec3SoA& Vec3SoA::normalizeFast(std::size_t first, std::size_t count) {
+    assert(first % 4 == 0 && first + count <= this->count);
+    float* x = this->streams[Vec3::X];
+    float* y = this->streams[Vec3::Y];
+    float* z = this->streams[Vec3::Z];
+    std::size_t end = first + count;
+    std::size_t i = first;
+
+#if defined(MATH_SIMD)
+    for (; i + 4 <= end; i += 4) {
+        Simd::Float4 vectorX = Simd::load(x + i);
+        Simd::Float4 vectorY = Simd::load(y + i);
+        Simd::Float4 vectorZ = Simd::load(z + i);
+        Simd::Float4 scale = Simd::mul(vectorX, vectorX);
+        scale = Simd::madd(vectorY, vectorY, scale);
+        scale = Simd::madd(vectorZ, vectorZ, scale);
+        scale = Simd::rsqrt(scale);
+        Simd::store(x + i, Simd::mul(vectorX, scale));
+        Simd::store(y + i, Simd::mul(vectorY, scale));
+        Simd::store(z + i, Simd::mul(vectorZ, scale));
+    }
+
+    for (; i < end; i++) {
+        float scale = Simd::rsqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+        x[i] *= scale;
+        y[i] *= scale;
+        z[i] *= scale;
+    }
+#endif
+
+    for (; i < end; i++) {
+        float scale = 1.0f / sqrtf(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+        x[i] *= scale;
+        y[i] *= scale;
+        z[i] *= scale;
+    }
+
+    return *this;
+}
+
+MATH_INLINE void Vec3SoA::length(float* result) const {
+    this->squareLength(result);
+    std::size_t i = 0;
+
+#if defined(MATH_SIMD)
+    for (; i + 4 <= this->count; i += 4) {
+        Simd::storeu(result + i, Simd::sqrt(Simd::loadu(result + i)));
+    }
+#endif
+
+    for (; i < this->count; i++) {
+        result[i] = sqrtf(result[i]);
+    }
+}
+
+MATH_INLINE void Vec3SoA::squareLength(float* result) const {
+    this->dot(*this, result);
+}
+
+MATH_INLINE void Vec3SoA::resize(std::size_t size) {
+    if (size > this->capacity) {
+        // Keep every stream cache line aligned and padded to the widest SIMD register
+        std::size_t capacity = (size + 15) & ~static_cast<std::size_t>(15);
+        float* storage = static_cast<float*>(operator new(capacity * 3 * sizeof(float), std::align_val_t(64)));
+        float* previous = this->streams[Vec3::X];
+
+        for (int i = Vec3::X; i <= Vec3::Z; i++) {
+            float* stream = storage + capacity * i;
+            if (this->count > 0) {
+                std::memcpy(stream, this->streams[i], this->count * sizeof(float));
+            }
+
+            this->streams[i] = stream;
+        }
+
+        if (previous != nullptr) {
+            operator delete(previous, std::align_val_t(64));
+        }
+
+        this->capacity = capacity;
+    }
+
+    if (size > this->count) {
+        for (int i = Vec3::X; i <= Vec3::Z; i++) {
+            std::memset(this->streams[i] + this->count, 0, (size - this->count) * sizeof(float));
+        }
+    }
+
+    this->count = size;
+}
+
+MATH_INLINE std::size_t Vec3SoA::size() const {
+    return this->count;
+}
+
+MATH_INLINE void Vec3SoA::load(const Vec3* vectors, std::size_t count) {
+    this->resize(count);
+
+    for (std::size_t i = 0; i < count; i++) {
+        const float* vector = vectors[i].data();
+        this->streams[Vec3::X][i] = vector[Vec3::X];
+        this->streams[Vec3::Y][i] = vector[Vec3::Y];
+        this->streams[Vec3::Z][i] = vector[Vec3::Z];
+    }
+}
+
+MATH_INLINE void Vec3SoA::store(Vec3* vectors) const {
+    for (std::size_t i = 0; i < this->count; i++) {
+        vectors[i] = Vec3(this->streams[Vec3::X][i],
+                          this->streams[Vec3::Y][i],
+                          this->streams[Vec3::Z][i]);
+    }
+}
+
+MATH_INLINE Vec3 Vec3SoA::get(std::size_t index) const {
+    assert(index < this->count);
+    return Vec3(this->streams[Vec3::X][index],
+                this->streams[Vec3::Y][index],
+                this->streams[Vec3::Z][index]);
+}
+
+MATH_INLINE void Vec3SoA::set(std::size_t index, const Vec3& vector) {
+    assert(index < this->count);
+    this->streams[Vec3::X][index] = vector.get(Vec3::X);
+    this->streams[Vec3::Y][index] = vector.get(Vec3::Y);
+    this->streams[Vec3::Z][index] = vector.get(Vec3::Z);
+}
+
+MATH_INLINE float* Vec3SoA::data(int component) {
+    assert(component >= Vec3::X && component <= Vec3::Z);
+    return this->streams[component];
+}
+
+MATH_INLINE const float* Vec3SoA::data(int component) const {
+    assert(component >= Vec3::X && component <= Vec3::Z);
+    return this->streams[component];
+}
+
+}  // namespace Math
+
+#endif  // VEC3SOA_INL
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef VEC4_INL
+#define VEC4_INL
+
+#include <Vec4.h>
+#include <MathSimd.h>
+#include <cmath>
+
+namespace Math {
+
+MATH_INLINE Vec4& Vec4::normalize() noexcept {
+    Vec<4, float>::normalize(this->vector, this->vector);
+    return *this;
+}
+
+MATH_INLINE Vec4& Vec4::normalizeFast() noexcept {
+#if defined(MATH_SIMD)
+    float scale = Simd::rsqrt(this->squareLength());
+#else
+    float scale = 1.0f / this->length();
+#endif
+    Vec<4, float>::scale(this->vector, scale, this->vector);
+    return *this;
+}
+
+MATH_INLINE float Vec4::length() const noexcept {
+    return sqrtf(this->squareLength());
+}
+
+}  // namespace Math
+
+#endif  // VEC4_INL
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef VEC4SOA_H
+#define VEC4SOA_H
+
+#include <MathApi.h>
+#include <cstddef>
+
+namespace Math {
+
+class Vec4;
+
+/*!
+ * \brief Structure of arrays container of four component vectors.
+ * \details Vec4SoA keeps X, Y, Z and W components in separate cache line aligned
+ *          streams and implements bulk counterparts of Vec4 operations that are:
+ *          * vector-vector addition, difference;
+ *          * vector-scalar multiplication;
+ *          * dot product calculation.
+ */
+class Vec4SoA {
+public:
+    /*!
+     * \brief Default constructor.
+     * \details Constructs an empty container.
+     */
+    MATH_API Vec4SoA() noexcept;
+
+    /*!
+     * \brief Sized constructor.
+     * \details Constructs a container of zero vectors.
+     * \param size Number of vectors.
+     */
+    MATH_API explicit Vec4SoA(std::size_t size);
+
+    /*!
+     * \brief Vec4 array based constructor.
+     * \param vectors Source vectors.
+     * \param count Number of vectors.
+     */
+    MATH_API Vec4SoA(const Vec4* vectors, std::size_t count);
+
+    /*!
+     * \brief Copy constructor.
+     * \param soa Source container.
+     */
+    MATH_API Vec4SoA(const Vec4SoA& soa);
+
+    /*!
+     * \brief Move constructor.
+     * \param soa Source container, left empty.
+     */
+    MATH_API Vec4SoA(Vec4SoA&& soa) noexcept;
+
+    /*!
+     * \brief Destructor.
+     */
+    MATH_API ~Vec4SoA();
+
+    /*!
+     * \brief Copy assignment.
+     * \param soa Source container.
+     * \return Assigned container.
+     */
+    MATH_API Vec4SoA& operator =(const Vec4SoA& soa);
+
+    /*!
+     * \brief Move assignment.
+     * \param soa Source container, left empty.
+     * \return Assigned container.
+     */
+    MATH_API Vec4SoA& operator =(Vec4SoA&& soa) noexcept;
+
+    /*!
+     * \brief Vectors substraction.
+     * \param soa Substructed vectors, must be of the same size.
+     * \return Difference vectors.
+     * \note Method has a side-effect.
+     */
+    MATH_API Vec4SoA& operator -=(const Vec4SoA& soa);
+
+    /*!
+     * \brief Vectors addition.
+     * \param soa Summand vectors, must be of the same size.
+     * \return Sum vectors.
+     * \note Method has a side-effect.
+     */
+    MATH_API Vec4SoA& operator +=(const Vec4SoA& soa);
+
+    /*!
+     * \brief Scalar multiplication.
+     * \param scalar Scalar multiplier.
+     * \return Product vectors.
+     * \note Method has a side-effect.
+     */
+    MATH_API Vec4SoA& operator *=(float scalar);
+
+    /*!
+     * \brief Dot products calculation.
+     * \param soa Vector multipliers, must be of the same size.
+     * \param result Scalar (dot) products, size() elements.
+     */
+    MATH_API void dot(const Vec4SoA& soa, float* result) const;
+
+    /*!
+     * \brief Ranged dot products calculation.
+     * \details Same as dot(const Vec4SoA&, float*) const for count vectors starting
+     *          at first, result is indexed as in the full calculation.
+     * \param soa Vector multipliers, must be of the same size.
+     * \param result Scalar (dot) products, size() elements.
+     * \param first First vector index, must be a multiple of 4.
+     * \param count Number of vectors.
+     */
+    MATH_API void dot(const Vec4SoA& soa, float* result, std::size_t first, std::size_t count) const;
+
+    /*!
+     * \brief Container resizing.
+     * \details Keeps existing vectors, new vectors are zero.
+     * \param size New number of vectors.
+     */
+    MATH_API void resize(std::size_t size);
+
+    /*!
+     * \brief Container's size accessor.
+     * \return Number of vectors.
+     */
+    MATH_API std::size_t size() const;
+
+    /*!
+     * \brief Vec4 array conversion.
+     * \details Resizes the container to count and copies vectors in.
+     * \param vectors Source vectors.
+     * \param count Number of vectors.
+     */
+    MATH_API void load(const Vec4* vectors, std::size_t count);
+
+    /*!
+     * \brief Vec4 array conversion.
+     * \param vectors Destination vectors, size() elements.
+     */
+    MATH_API void store(Vec4* vectors) const;
+
+    /*!
+     * \brief Vector selector.
+     * \param index Vector's index.
+     * \return Vector value.
+     */
+    MATH_API Vec4 get(std::size_t index) const;
+
+    /*!
+     * \brief Vector mutator.
+     * \param index Vector's index.
+     * \param vector Vector's new value.
+     */
+    MATH_API void set(std::size_t index, const Vec4& vector);
+
+    /*!
+     * \brief Component stream accessor.
+     * \param component Component's index.
+     * \return Stream data pointer, aligned to a cache line.
+     * \note You are advised to use Vec4::X, Vec4::Y, Vec4::Z, Vec4::W constants as indices.
+     */
+    MATH_API float* data(int component);
+
+    /*!
+     * \brief Component stream accessor.
+     * \param component Component's index.
+     * \return Stream data pointer, aligned to a cache line.
+     * \note You are advised to use Vec4::X, Vec4::Y, Vec4::Z, Vec4::W constants as indices.
+     */
+    MATH_API const float* data(int component) const;
+
+private:
+    float* streams[4];
+    std::size_t count;
+    std::size_t capacity;
+};
+
+}  // namespace Math
+
+#ifdef MATH_HEADER_ONLY
+#include <Vec4SoA.inl>
+#endif
+
+#endif  // VEC4SOA_H
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef VEC4SOA_INL
+#define VEC4SOA_INL
+
+#include <Vec4SoA.h>
+#include <Vec4.h>
+#include <MathSimd.h>
+#include <Dispatch.h>
+#include <Instrumentation.h>
+#include <cassert>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace Math {
+
+MATH_INLINE Vec4SoA::Vec4SoA() noexcept {
+    this->streams[Vec4::X] = nullptr;
+    this->streams[Vec4::Y] = nullptr;
+    this->streams[Vec4::Z] = nullptr;
+    this->streams[Vec4::W] = nullptr;
+    this->count = 0;
+    this->capacity = 0;
+}
+
+MATH_INLINE Vec4SoA::Vec4SoA(std::size_t size):
+        Vec4SoA() {
+    this->resize(size);
+}
+
+MATH_INLINE Vec4SoA::Vec4SoA(const Vec4* vectors, std::size_t count):
+        Vec4SoA() {
+    this->load(vectors, count);
+}
+
+MATH_INLINE Vec4SoA::Vec4SoA(const Vec4SoA& soa):
+        Vec4SoA(soa.size()) {
+    if (this->count > 0) {
+        for (int i = Vec4::X; i <= Vec4::W; i++) {
+            std::memcpy(this->streams[i], soa.data(i), this->count * sizeof(float));
+        }
+    }
+}
+
+MATH_INLINE Vec4SoA::Vec4SoA(Vec4SoA&& soa) noexcept:
+        Vec4SoA() {
+    *this = std::move(soa);
+}
+
+MATH_INLINE Vec4SoA::~Vec4SoA() {
+    if (this->streams[Vec4::X] != nullptr) {
+        operator delete(this->streams[Vec4::X], std::align_val_t(64));
+    }
+}
+
+MATH_INLINE Vec4SoA& Vec4SoA::operator =(const Vec4SoA& soa) {
+    if (this != &soa) {
+        Vec4SoA copy(soa);
+        *this = std::move(copy);
+    }
+
+    return *this;
+}
+
+MATH_INLINE Vec4SoA& Vec4SoA::operator =(Vec4SoA&& soa) noexcept {
+    std::swap(this->streams, soa.streams);
+    std::swap(this->count, soa.count);
+    std::swap(this->capacity, soa.capacity);
+    return *this;
+}
+
+MATH_INLINE Vec4SoA& Vec4SoA::operator -=(const Vec4SoA& soa) {
+    assert(this->count == soa.size());
+    for (int j = Vec4::X; j <= Vec4::W; j++) {
+        float* left = this->streams[j];
+        const float* right = soa.data(j);
+        std::size_t i = 0;
+
+#if defined(MATH_SIMD)
+        for (; i + 4 <= this->count; i += 4) {
+            Simd::store(left + i, Simd::sub(Simd::load(left + i), Simd::load(right + i)));
+        }
+#endif
+
+        for (; i < this->count; i++) {
+            left[i] -= right[i];
+        }
+    }
+
+    return *this;
+}
+
+MATH_INLINE Vec4SoA& Vec4SoA::operator +=(const Vec4SoA& soa) {
+    assert(this->count == soa.size());
+    for (int j = Vec4::X; j <= Vec4::W; j++) {
+        float* left = this->streams[j];
+        const float* right = soa.data(j);
+        std::size_t i = 0;
+
+#if defined(MATH_SIMD)
+        for (; i + 4 <= this->count; i += 4) {
+            Simd::store(left + i, Simd::add(Simd::load(left + i), Simd::load(right + i)));
+        }
+#endif
+
+        for (; i < this->count; i++) {
+            left[i] += right[i];
+        }
+    }
+
+    return *this;
+}
+
+MATH_INLINE Vec4SoA& Vec4SoA::operator *=(float scalar) {
+    for (int j = Vec4::X; j <= Vec4::W; j++) {
+        float* stream = this->streams[j];
+        std::size_t i = 0;
+
+#if defined(MATH_SIMD)
+        Simd::Float4 multiplier = Simd::splat(scalar);
+        for (; i + 4 <= this->count; i += 4) {
+            Simd::store(stream + i, Simd::mul(Simd::load(stream + i), multiplier));
+        }
+#endif
+
+        for (; i < this->count; i++) {
+            stream[i] *= scalar;
+        }
+    }
+
+    return *this;
+}
+
+MATH_INLINE void Vec4SoA::dot(const Vec4SoA& soa, float* result) const {
+    this->dot(soa, result, 0, this->count);
+}
+
+MATH_INLINE void Vec4SoA::dot(const Vec4SoA& soa, float* result, std::size_t first, std::size_t count) const {
+    MATH_PROBE(VEC_SOA_DOT, count);
+
+    assert(this->count == soa.size());
+    assert(first % 4 == 0 && first + count <= this->count);
+    const float* left[4] = {
+        this->streams[Vec4::X], this->streams[Vec4::Y], this->streams[Vec4::Z], this->streams[Vec4::W]
+    };
+    const float* right[4] = { soa.data(Vec4::X), soa.data(Vec4::Y), soa.data(Vec4::Z), soa.data(Vec4::W) };
+    Dispatch::getKernels().dot4(left, right, result, first, first + count);
+}
+
+MATH_INLINE void Vec4SoA::resize(std::size_t size) {
+    if (size > this->capacity) {
+        // Keep every stream cache line aligned and padded to the widest SIMD register
+        std::size_t capacity = (size + 15) & ~static_cast<std::size_t>(15);
+        float* storage = static_cast<float*>(operator new(capacity * 4 * sizeof(float), std::align_val_t(64)));
+        float* previous = this->streams[Vec4::X];
+
+        for (int i = Vec4::X; i <= Vec4::W; i++) {
+            float* stream = storage + capacity * i;
+            if (this->count > 0) {
+                std::memcpy(stream, this->streams[i], this->count * sizeof(float));
+            }
+
+            this->streams[i] = stream;
+        }
+
+        if (previous != nullptr) {
+            operator delete(previous, std::align_val_t(64));
+        }
+
+        this->capacity = capacity;
+    }
+
+    if (size > this->count) {
+        for (int i = Vec4::X; i <= Vec4::W; i++) {
+            std::memset(this->streams[i] + this->count, 0, (size - this->count) * sizeof(float));
+        }
+    }
+
+    this->count = size;
+}
+
+MATH_INLINE std::size_t Vec4SoA::size() const {
+    return this->count;
+}
+
+MATH_INLINE void Vec4SoA::load(const Vec4* vectors, std::size_t count) {
+    this->resize(count);
+
+    for (std::size_t i = 0; i < count; i++) {
+        const float* vector = vectors[i].data();
+        this->streams[Vec4::X][i] = vector[Vec4::X];
+        this->streams[Vec4::Y][i] = vector[Vec4::Y];
+        this->streams[Vec4::Z][i] = vector[Vec4::Z];
+        this->streams[Vec4::W][i] = vector[Vec4::W];
+    }
+}
+
+MATH_INLINE void Vec4SoA::store(Vec4* vectors) const {
+    for (std::size_t i = 0; i < this->count; i++) {
+        vectors[i] = Vec4(this->streams[Vec4::X][i],
+                          this->streams[Vec4::Y][i],
+                          this->streams[Vec4::Z][i],
+                          this->streams[Vec4::W][i]);
+    }
+}
+
+MATH_INLINE Vec4 Vec4SoA::get(std::size_t index) const {
+    assert(index < this->count);
+    return Vec4(this->streams[Vec4::X][index],
+                this->streams[Vec4::Y][index],
+                this->streams[Vec4::Z][index],
+                this->streams[Vec4::W][index]);
+}
+
+MATH_INLINE void Vec4SoA::set(std::size_t index, const Vec4& vector) {
+    assert(index < this->count);
+    this->streams[Vec4::X][index] = vector.get(Vec4::X);
+    this->streams[Vec4::Y][index] = vector.get(Vec4::Y);
+    this->streams[Vec4::Z][index] = vector.get(Vec4::Z);
+    this->streams[Vec4::W][index] = vector.get(Vec4::W);
+}
+
+MATH_INLINE float* Vec4SoA::data(int component) {
+    assert(component >= Vec4::X && component <= Vec4::W);
+    return this->streams[component];
+}
+
+MATH_INLINE const float* Vec4SoA::data(int component) const {
+    assert(component >= Vec4::X && component <= Vec4::W);
+    return this->streams[component];
+}
+
+}  // namespace Math
+
+#endif  // VEC4SOA_INL
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef VIEW_H
+#define VIEW_H
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+namespace Math {
+
+class Vec3;
+class Vec4;
+class Mat4;
+
+/*!
+ * \brief Non-owning strided view of an external float buffer.
+ * \details View<T, Float> presents count elements of type T stored as consecutive
+ *          floats, stride floats apart, in a buffer owned by someone else: a mapped
+ *          file, a GPU buffer, an interleaved vertex array. Nothing is copied on
+ *          construction, elements are read and written in place and batch operations
+ *          taking views run directly on the buffer. Float is const float for read-only
+ *          buffers, mutable views convert to read-only ones implicitly.
+ *
+ *          T should be Vec3, Vec4 or Mat4, the element occupies sizeof(T) / sizeof(float)
+ *          components.
+ */
+template<typename T, typename Float = float>
+class View {
+public:
+    static_assert(std::is_same<typename std::remove_const<Float>::type, float>::value,
+            "View is defined over float buffers");
+
+    typedef T Type;  /*!< Element type. */
+
+    enum {
+        Components = sizeof(T) / sizeof(float)  /*!< Number of floats per element. */
+    };
+
+    /*!
+     * \brief Default constructor.
+     * \details Constructs an empty view.
+     */
+    constexpr View();
+
+    /*!
+     * \brief Buffer constructor.
+     * \param data First element's first component.
+     * \param count Number of elements.
+     * \param stride Distance between consecutive elements in floats.
+     * \note There is an assert for stride not being less than #Components.
+     */
+    constexpr View(Float* data, std::size_t count, std::size_t stride = Components);
+
+    /*!
+     * \brief Read-only view conversion constructor.
+     * \param view Mutable view of the same elements.
+     */
+    template<typename Other, typename = typename std::enable_if<
+            std::is_same<Float, const float>::value && std::is_same<Other, float>::value>::type>
+    constexpr View(const View<T, Other>& view);
+
+    /*!
+     * \brief Partial view builder.
+     * \param first First element of the partial view.
+     * \param count Number of elements.
+     * \return View of count elements starting at first.
+     * \note There is an assert for range bounds.
+     */
+    constexpr View subview(std::size_t first, std::size_t count) const;
+
+    /*!
+     * \brief View's element selector.
+     * \param index Element's index.
+     * \return Copy of the element.
+     * \note There is an assert for index bounds.
+     */
+    constexpr T get(std::size_t index) const;
+
+    /*!
+     * \brief View's element mutator.
+     * \param index Element's index.
+     * \param value Element's new value.
+     * \note There is an assert for index bounds.
+     */
+    constexpr void set(std::size_t index, const T& value) const;
+
+    /*!
+     * \brief View's size selector.
+     * \return Number of elements.
+     */
+    constexpr std::size_t size() const;
+
+    /*!
+     * \brief View's stride selector.
+     * \return Distance between consecutive elements in floats.
+     */
+    constexpr std::size_t getStride() const;
+
+    /*!
+     * \brief View's data accessor.
+     * \return First element's first component.
+     */
+    constexpr Float* data() const;
+
+private:
+    Float* buffer;
+    std::size_t count;
+    std::size_t stride;
+};
+
+typedef View<Vec3> Vec3View;                    /*!< Mutable view of three component vectors. */
+typedef View<Vec3, const float> ConstVec3View;  /*!< Read-only view of three component vectors. */
+typedef View<Vec4> Vec4View;                    /*!< Mutable view of four component vectors. */
+typedef View<Vec4, const float> ConstVec4View;  /*!< Read-only view of four component vectors. */
+typedef View<Mat4> Mat4View;                    /*!< Mutable view of 4x4 matrices. */
+typedef View<Mat4, const float> ConstMat4View;  /*!< Read-only view of 4x4 matrices. */
+
+template<typename T, typename Float>
+constexpr View<T, Float>::View():
+        buffer(nullptr),
+        count(0),
+        stride(Components) {
+}
+
+template<typename T, typename Float>
+constexpr View<T, Float>::View(Float* data, std::size_t count, std::size_t stride):
+        buffer(data),
+        count(count),
+        stride(stride) {
+    assert(stride >= Components);
+}
+
+template<typename T, typename Float>
+template<typename Other, typename>
+constexpr View<T, Float>::View(const View<T, Other>& view):
+        buffer(view.data()),
+        count(view.size()),
+        stride(view.getStride()) {
+}
+
+template<typename T, typename Float>
+constexpr View<T, Float> View<T, Float>::subview(std::size_t first, std::size_t count) const {
+    assert(first <= this->count && count <= this->count - first);
+    return View(this->buffer + first * this->stride, count, this->stride);
+}
+
+template<typename T, typename Float>
+constexpr T View<T, Float>::get(std::size_t index) const {
+    assert(index < this->count);
+    return T(this->buffer + index * this->stride);
+}
+
+template<typename T, typename Float>
+constexpr void View<T, Float>::set(std::size_t index, const T& value) const {
+    static_assert(!std::is_const<Float>::value, "Read-only view cannot be modified");
+    assert(index < this->count);
+
+    Float* element = this->buffer + index * this->stride;
+    const float* source = value.data();
+
+    for (int i = 0; i < Components; i++) {
+        element[i] = source[i];
+    }
+}
+
+template<typename T, typename Float>
+constexpr std::size_t View<T, Float>::size() const {
+    return this->count;
+}
+
+template<typename T, typename Float>
+constexpr std::size_t View<T, Float>::getStride() const {
+    return this->stride;
+}
+
+template<typename T, typename Float>
+constexpr Float* View<T, Float>::data() const {
+    return this->buffer;
+}
+
+}  // namespace Math
+
+#endif  // VIEW_H